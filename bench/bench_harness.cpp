@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+
+#include "bench_harness.h"
+
+namespace codetest::matching_engine_sim_bench {
+
+namespace {
+
+constexpr std::uint64_t MAX_SAMPLES = 1'000'000;
+
+// Nearest rank percentile over sorted samples
+double percentile(const std::vector<double> &sorted_samples, const double &fraction) {
+  if (sorted_samples.empty()) return 0;
+  const auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted_samples.size())));
+  return sorted_samples[std::clamp<std::size_t>(rank, 1, sorted_samples.size()) - 1];
+}
+
+} // end of anonymous local namespace
+
+BenchmarkRun::BenchmarkRun(const std::uint64_t &min_samples,
+                           const std::chrono::nanoseconds &min_time,
+                           const PerfCounters *perf_counters)
+    : min_samples_(min_samples), min_time_(min_time), perf_counters_(perf_counters) {
+  sample_ns_per_operation_.reserve(min_samples);
+}
+
+bool BenchmarkRun::keepRunning() const {
+  if (sample_ns_per_operation_.size() >= MAX_SAMPLES) return false;
+  return sample_ns_per_operation_.size() < min_samples_ || elapsed_ < min_time_;
+}
+
+void BenchmarkRun::record(const std::uint64_t &operations,
+                          const std::chrono::nanoseconds &elapsed,
+                          const PerfCounterValues &counters_before) {
+  if (operations == 0) return;
+  if (perf_counters_) {
+    const auto counters_after = perf_counters_->read();
+    for (std::size_t index = 0; index < PERF_COUNTER_SIZE; index++) {
+      perf_counter_totals_[index] += counters_after[index] - counters_before[index];
+    }
+  }
+  sample_ns_per_operation_.push_back(static_cast<double>(elapsed.count()) / static_cast<double>(operations));
+  operations_ += operations;
+  elapsed_ += elapsed;
+}
+
+BenchmarkResult BenchmarkRun::summarize(const std::string &name) const {
+  auto sorted_samples = sample_ns_per_operation_;
+  std::sort(sorted_samples.begin(), sorted_samples.end());
+
+  BenchmarkResult result;
+  result.name_ = name;
+  result.operations_ = operations_;
+  result.samples_ = sorted_samples.size();
+  result.mean_ns_ = operations_ == 0 ? 0 : static_cast<double>(elapsed_.count()) / static_cast<double>(operations_);
+  result.p50_ns_ = percentile(sorted_samples, 0.50);
+  result.p90_ns_ = percentile(sorted_samples, 0.90);
+  result.p99_ns_ = percentile(sorted_samples, 0.99);
+  result.max_ns_ = sorted_samples.empty() ? 0 : sorted_samples.back();
+
+  for (std::size_t index = 0; index < PERF_COUNTER_SIZE; index++) {
+    const bool captured = perf_counters_ && operations_ > 0
+        && perf_counters_->isAvailable(static_cast<PerfCounter>(index));
+    result.perf_counters_per_operation_[index] = captured
+        ? static_cast<double>(perf_counter_totals_[index]) / static_cast<double>(operations_)
+        : std::numeric_limits<double>::quiet_NaN();
+  }
+  return result;
+}
+
+void BenchmarkSuite::add(const std::string &name, const BenchmarkFunction &benchmark) {
+  benchmarks_.emplace_back(name, benchmark);
+}
+
+std::vector<BenchmarkResult> BenchmarkSuite::run(const std::string &filter,
+                                                 const std::uint64_t &min_samples,
+                                                 const std::chrono::nanoseconds &min_time,
+                                                 const bool &perf_counters) const {
+  std::vector<BenchmarkResult> results;
+
+  std::unique_ptr<PerfCounters> counters;
+  if (perf_counters) {
+    counters = std::make_unique<PerfCounters>();
+    if (!counters->isAvailable()) {
+      std::fprintf(stderr, "hardware counters unavailable (%s), reporting time only\n",
+                   counters->getUnavailableReason().c_str());
+      counters.reset();
+    }
+  }
+
+  std::printf("%-56s %12s %10s %10s %10s %10s %10s",
+              "benchmark", "operations", "ns/op", "p50", "p90", "p99", "max");
+  if (counters) {
+    std::printf(" %10s %10s %10s %10s %10s", "cycles", "instr", "L1D-miss", "LLC-miss", "br-miss");
+  }
+  std::printf("\n");
+
+  for (const auto &[name, benchmark] : benchmarks_) {
+    if (name.find(filter) == std::string::npos) continue;
+
+    BenchmarkRun run{min_samples, min_time, counters.get()};
+    benchmark(run);
+    const auto &result = results.emplace_back(run.summarize(name));
+
+    std::printf("%-56s %12llu %10.1f %10.1f %10.1f %10.1f %10.1f",
+                result.name_.c_str(),
+                static_cast<unsigned long long>(result.operations_),
+                result.mean_ns_,
+                result.p50_ns_,
+                result.p90_ns_,
+                result.p99_ns_,
+                result.max_ns_);
+    if (counters) {
+      for (const auto &per_operation : result.perf_counters_per_operation_) {
+        if (std::isnan(per_operation)) {
+          std::printf(" %10s", "-");
+        } else {
+          std::printf(" %10.1f", per_operation);
+        }
+      }
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+  }
+  return results;
+}
+
+} // end of namespace
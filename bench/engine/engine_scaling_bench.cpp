@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "engine/matching_engine.h"
+#include "engine/null_engine_event_observer.h"
+#include "loadgen/load_generator.h"
+#include "loadgen/order_flow_generator.h"
+
+using namespace codetest::matching_engine_sim;
+
+/*
+ * Sweeps DefaultMatchingEngine over thread counts, instrument counts and Zipf skew, driving each configuration with
+ * LoadGenerator. For a given instrument count and skew the generated flow is identical across thread counts, as the
+ * seed is fixed, so rows differ only by the engine's parallelism.
+ *
+ * Results go to stdout as CSV, one row per configuration, progress to stderr.
+ */
+
+namespace {
+
+struct ScalingConfiguration {
+  unsigned long threads_;
+  InstrumentType instruments_;
+  double zipf_exponent_;
+};
+
+int printUsage(const char *program) {
+  std::fprintf(stderr,
+               "usage: %s [options]\n"
+               "  --threads <n,...>         engine processor threads to sweep (default 1,2,4)\n"
+               "  --instruments <n,...>     instrument counts to sweep (default 1,8,64)\n"
+               "  --zipf <s,...>            instrument skew exponents to sweep, 0 uniform (default 0,1.2)\n"
+               "  --producers <n>           producer threads (default 2)\n"
+               "  --requests <n>            requests per producer (default 200000)\n"
+               "  --rate <requests/s>       offered rate over all producers, 0 saturates the engine (default 0)\n"
+               "  --repeat <n>              runs per configuration, each a row (default 1)\n"
+               "  --seed <n>                (default 42)\n"
+               "  --output <file>           write the CSV to file instead of stdout\n",
+               program);
+  return 1;
+}
+
+template<typename T, typename Parse>
+bool parseList(const char *value, std::vector<T> &list, Parse parse) {
+  list.clear();
+  std::string text{value};
+  std::size_t begin = 0;
+  while (begin <= text.size()) {
+    const auto end = std::min(text.find(',', begin), text.size());
+    if (end == begin) return false;
+    list.push_back(static_cast<T>(parse(text.substr(begin, end - begin))));
+    begin = end + 1;
+  }
+  return !list.empty();
+}
+
+} // end of anonymous local namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<unsigned long> thread_counts{1, 2, 4};
+  std::vector<InstrumentType> instrument_counts{1, 8, 64};
+  std::vector<double> zipf_exponents{0, 1.2};
+  OrderFlowGeneratorConfig flow_config;
+  LoadRunOptions run_options;
+  run_options.producers_ = 2;
+  run_options.target_rate_ = 0;
+  run_options.requests_per_producer_ = 200000;
+  unsigned long repeat = 1;
+  std::string output_path;
+
+  const auto to_unsigned = [](const std::string &text) { return std::strtoull(text.c_str(), nullptr, 10); };
+  const auto to_double = [](const std::string &text) { return std::strtod(text.c_str(), nullptr); };
+
+  for (int index = 1; index < argc; index++) {
+    if (index + 1 >= argc) return printUsage(argv[0]);
+    const char *option = argv[index];
+    const char *value = argv[++index];
+
+    bool parsed = true;
+    if (std::strcmp(option, "--threads") == 0) {
+      parsed = parseList(value, thread_counts, to_unsigned);
+    } else if (std::strcmp(option, "--instruments") == 0) {
+      parsed = parseList(value, instrument_counts, to_unsigned);
+    } else if (std::strcmp(option, "--zipf") == 0) {
+      parsed = parseList(value, zipf_exponents, to_double);
+    } else if (std::strcmp(option, "--producers") == 0) {
+      run_options.producers_ = std::strtoul(value, nullptr, 10);
+    } else if (std::strcmp(option, "--requests") == 0) {
+      run_options.requests_per_producer_ = std::strtoull(value, nullptr, 10);
+    } else if (std::strcmp(option, "--rate") == 0) {
+      run_options.target_rate_ = std::strtod(value, nullptr);
+    } else if (std::strcmp(option, "--repeat") == 0) {
+      repeat = std::strtoul(value, nullptr, 10);
+    } else if (std::strcmp(option, "--seed") == 0) {
+      flow_config.seed_ = std::strtoull(value, nullptr, 10);
+    } else if (std::strcmp(option, "--output") == 0) {
+      output_path = value;
+    } else {
+      parsed = false;
+    }
+    if (!parsed) return printUsage(argv[0]);
+  }
+
+  std::vector<ScalingConfiguration> configurations;
+  for (const auto &instruments : instrument_counts) {
+    for (const auto &zipf_exponent : zipf_exponents) {
+      for (const auto &threads : thread_counts) {
+        if (threads == 0 || threads > 255 || instruments == 0) return printUsage(argv[0]);
+        configurations.push_back({threads, instruments, zipf_exponent});
+      }
+    }
+  }
+
+  FILE *output = stdout;
+  if (!output_path.empty()) {
+    output = std::fopen(output_path.c_str(), "w");
+    if (output == nullptr) {
+      std::fprintf(stderr, "unable to open %s\n", output_path.c_str());
+      return 1;
+    }
+  }
+
+  int result = 0;
+  try {
+    std::fprintf(output, "threads,instruments,zipf,producers,offered_rate,requests,new_orders,responded,"
+                         "elapsed_ns,msgs_per_sec,latency_p50_ns,latency_p99_ns,latency_p999_ns,latency_max_ns\n");
+
+    for (const auto &configuration : configurations) {
+      for (unsigned long run = 0; run < repeat; run++) {
+        std::fprintf(stderr, "threads %lu instruments %llu zipf %.2f run %lu\n", configuration.threads_,
+                     static_cast<unsigned long long>(configuration.instruments_), configuration.zipf_exponent_, run);
+
+        auto config = flow_config;
+        config.instruments_ = configuration.instruments_;
+        config.zipf_exponent_ = configuration.zipf_exponent_;
+
+        std::set<InstrumentType> instruments;
+        for (InstrumentType inst = 0; inst < config.instruments_; inst++) {
+          instruments.insert(config.first_instrument_ + inst);
+        }
+
+        LoadGenerator load_generator{config, run_options, std::make_shared<NullEngineEventObserver>()};
+        DefaultMatchingEngine<> matching_engine{static_cast<std::uint8_t>(configuration.threads_), instruments,
+                                                load_generator.getObserver()};
+        const auto report = load_generator.run(matching_engine);
+        matching_engine.terminate();
+
+        std::fprintf(output, "%lu,%llu,%.3f,%zu,%.0f,%llu,%llu,%llu,%lld,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+                     configuration.threads_,
+                     static_cast<unsigned long long>(configuration.instruments_),
+                     configuration.zipf_exponent_,
+                     run_options.producers_,
+                     run_options.target_rate_,
+                     static_cast<unsigned long long>(report.requests_),
+                     static_cast<unsigned long long>(report.new_orders_),
+                     static_cast<unsigned long long>(report.responded_new_orders_),
+                     static_cast<long long>(report.elapsed_.count()),
+                     report.throughput(),
+                     report.latency_p50_,
+                     report.latency_p99_,
+                     report.latency_p999_,
+                     report.latency_max_);
+        std::fflush(output);
+      }
+    }
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    result = 1;
+  }
+
+  if (output != stdout) std::fclose(output);
+  return result;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "perf_counters.h"
+
+namespace codetest::matching_engine_sim_bench {
+
+struct BenchmarkResult {
+  std::string name_{};
+  std::uint64_t operations_{};
+  std::uint64_t samples_{};
+  double mean_ns_{};
+  double p50_ns_{};
+  double p90_ns_{};
+  double p99_ns_{};
+  double max_ns_{};
+  // Hardware counters per operation, NaN where not captured
+  std::array<double, PERF_COUNTER_SIZE> perf_counters_per_operation_{};
+};
+
+// Handed to a benchmark body, which sets up and measures batches of operations while keepRunning() holds.
+// Every measured batch is one sample of its time per operation, percentiles are taken over samples.
+// Given perf_counters, hardware counters are read around every batch as well and reported per operation.
+class BenchmarkRun final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  BenchmarkRun(const std::uint64_t &min_samples,
+               const std::chrono::nanoseconds &min_time,
+               const PerfCounters *perf_counters = nullptr);
+  BenchmarkRun(const BenchmarkRun &) = delete;
+  BenchmarkRun &operator=(const BenchmarkRun &) = delete;
+  ~BenchmarkRun() = default;
+
+  [[nodiscard]] bool keepRunning() const;
+
+  // Times f performing the given number of operations as one sample
+  template<typename F>
+  void measure(const std::uint64_t &operations, F &&f) {
+    const auto counters_before = readPerfCounters();
+    const auto start = Clock::now();
+    f();
+    const auto end = Clock::now();
+    record(operations, end - start, counters_before);
+  }
+
+  [[nodiscard]] BenchmarkResult summarize(const std::string &name) const;
+
+ private:
+  [[nodiscard]] PerfCounterValues readPerfCounters() const {
+    return perf_counters_ ? perf_counters_->read() : PerfCounterValues{};
+  }
+
+  void record(const std::uint64_t &operations,
+              const std::chrono::nanoseconds &elapsed,
+              const PerfCounterValues &counters_before);
+
+  const std::uint64_t min_samples_{};
+  const std::chrono::nanoseconds min_time_{};
+  const PerfCounters *const perf_counters_{};
+  PerfCounterValues perf_counter_totals_{};
+
+  std::vector<double> sample_ns_per_operation_{};
+  std::uint64_t operations_{};
+  std::chrono::nanoseconds elapsed_{};
+};
+
+using BenchmarkFunction = std::function<void(BenchmarkRun &run)>;
+
+class BenchmarkSuite final {
+ public:
+  BenchmarkSuite() = default;
+  BenchmarkSuite(const BenchmarkSuite &) = delete;
+  BenchmarkSuite &operator=(const BenchmarkSuite &) = delete;
+  ~BenchmarkSuite() = default;
+
+  void add(const std::string &name, const BenchmarkFunction &benchmark);
+
+  // Runs every benchmark whose name contains filter, printing one row per benchmark as it completes.
+  // With perf_counters, hardware counters per operation are added to each row where the machine provides them.
+  std::vector<BenchmarkResult> run(const std::string &filter,
+                                   const std::uint64_t &min_samples,
+                                   const std::chrono::nanoseconds &min_time,
+                                   const bool &perf_counters = false) const;
+
+ private:
+  std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks_{};
+};
+
+// Keeps the compiler from discarding a computed value
+template<typename T>
+inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+void registerPassiveOrderBookBenchmarks(BenchmarkSuite &suite);
+void registerMatchingAlgoBenchmarks(BenchmarkSuite &suite);
+void registerValidatorsBenchmarks(BenchmarkSuite &suite);
+void registerCallAuctionBenchmarks(BenchmarkSuite &suite);
+
+} // end of namespace
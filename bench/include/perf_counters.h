@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace codetest::matching_engine_sim_bench {
+
+enum class PerfCounter : std::uint8_t {
+  CYCLES,
+  INSTRUCTIONS,
+  L1D_MISSES,
+  LLC_MISSES,
+  BRANCH_MISSES,
+  _COUNTER_SIZE_
+};
+
+constexpr std::size_t PERF_COUNTER_SIZE = static_cast<std::size_t>(PerfCounter::_COUNTER_SIZE_);
+
+using PerfCounterValues = std::array<std::uint64_t, PERF_COUNTER_SIZE>;
+
+[[nodiscard]] const char *toString(const PerfCounter &counter);
+
+/*
+ * Hardware counters of the calling thread, user space only, through Linux perf_event_open. The counters are opened
+ * as one group so they are scheduled onto the PMU together, values are scaled up when the kernel had to multiplex.
+ *
+ * Degrades gracefully: where perf events are not permitted (perf_event_paranoid), not virtualised or not Linux at all,
+ * isAvailable() is false, and where only some events exist the others are reported unavailable on their own.
+ */
+class PerfCounters final {
+ public:
+  PerfCounters();
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+  ~PerfCounters();
+
+  [[nodiscard]] bool isAvailable() const { return group_fd_ >= 0; }
+  [[nodiscard]] bool isAvailable(const PerfCounter &counter) const {
+    return fds_[static_cast<std::size_t>(counter)] >= 0;
+  }
+
+  // Why counters are unavailable, empty when available
+  [[nodiscard]] const std::string &getUnavailableReason() const { return unavailable_reason_; }
+
+  // Counts since the group was opened, 0 for unavailable counters
+  [[nodiscard]] PerfCounterValues read() const;
+
+ private:
+  std::array<int, PERF_COUNTER_SIZE> fds_{};
+  // Position of each counter within a group read, in order of opening
+  std::array<std::size_t, PERF_COUNTER_SIZE> read_index_{};
+  std::size_t opened_{0};
+  int group_fd_{-1};
+  std::string unavailable_reason_{};
+};
+
+} // end of namespace
@@ -0,0 +1,70 @@
+#include <string>
+
+#include "bench_harness.h"
+#include "engine/null_engine_event_observer.h"
+#include "matching/call_auction_matching.hpp"
+
+using namespace codetest::matching_engine_sim;
+
+namespace codetest::matching_engine_sim_bench {
+
+namespace {
+
+constexpr PriceType BENCH_BASE_PRICE = 10000;
+constexpr SizeType BENCH_ORDER_SIZE = 100;
+constexpr ClientType BENCH_NUMBER_OF_CLIENTS = 8;
+
+constexpr std::size_t AUCTION_ORDER_COUNTS[] = {1000, 10000, 100000};
+constexpr std::size_t AUCTION_ORDERS_PER_LEVEL = 100;
+
+// Bids and asks of as many levels each, the upper half of bid levels crossing the lower half of ask levels
+void placeAuctionOrders(PassiveOrderBook<> &passive_order_book, const std::size_t &orders) {
+  const std::size_t levels = orders / AUCTION_ORDERS_PER_LEVEL / 2;
+  OrderIDType order_id{0};
+  for (std::size_t level = 0; level < levels; level++) {
+    for (std::size_t cnt = 0; cnt < AUCTION_ORDERS_PER_LEVEL; cnt++, order_id += 2) {
+      passive_order_book.placePassiveOrder(order_id % BENCH_NUMBER_OF_CLIENTS, order_id, OrderType::LIMIT,
+                                           OrderSide::BUY, BENCH_BASE_PRICE + level, BENCH_ORDER_SIZE, nullptr);
+      passive_order_book.placePassiveOrder(order_id % BENCH_NUMBER_OF_CLIENTS, order_id + 1, OrderType::LIMIT,
+                                           OrderSide::SELL, BENCH_BASE_PRICE + levels / 2 + level,
+                                           BENCH_ORDER_SIZE, nullptr);
+    }
+  }
+}
+
+} // end of anonymous local namespace
+
+void registerCallAuctionBenchmarks(BenchmarkSuite &suite) {
+
+  // Equilibrium price of a book accumulated in an auction, sized up from its crossing levels
+  for (const auto orders : AUCTION_ORDER_COUNTS) {
+    suite.add("Auction/findEquilibrium/orders:" + std::to_string(orders), [orders](BenchmarkRun &run) {
+      CallAuctionMatching<> matching_algo;
+      PassiveOrderBook<> passive_order_book;
+      placeAuctionOrders(passive_order_book, orders);
+
+      while (run.keepRunning()) {
+        run.measure(1, [&] { doNotOptimize(matching_algo.findEquilibrium(passive_order_book)); });
+      }
+    });
+  }
+
+  // Equilibrium price found and every crossing order traded at it
+  for (const auto orders : AUCTION_ORDER_COUNTS) {
+    suite.add("Auction/uncross/orders:" + std::to_string(orders), [orders](BenchmarkRun &run) {
+      CallAuctionMatching<> matching_algo;
+      NullEngineEventObserver observer;
+
+      while (run.keepRunning()) {
+        PassiveOrderBook<> passive_order_book;
+        placeAuctionOrders(passive_order_book, orders);
+
+        run.measure(1, [&] {
+          doNotOptimize(matching_algo.uncross(passive_order_book, 0, observer));
+        });
+      }
+    });
+  }
+}
+
+} // end of namespace
@@ -0,0 +1,101 @@
+#include <limits>
+#include <string>
+
+#include "bench_harness.h"
+#include "engine/null_engine_event_observer.h"
+#include "matching/matching_algo.hpp"
+#include "matching/pro_rata_matching.hpp"
+
+using namespace codetest::matching_engine_sim;
+
+namespace codetest::matching_engine_sim_bench {
+
+namespace {
+
+constexpr PriceType BENCH_BASE_PRICE = 10000;
+constexpr SizeType BENCH_ORDER_SIZE = 100;
+constexpr ClientType BENCH_NUMBER_OF_CLIENTS = 8;
+// Never resting in the book, so never self matching
+constexpr ClientType BENCH_AGGRESSOR_CLIENT = BENCH_NUMBER_OF_CLIENTS;
+
+constexpr std::size_t LEVEL_ORDER_COUNTS[] = {1, 10, 100, 1000};
+constexpr std::size_t SWEEP_DEPTHS[] = {1, 10, 100};
+constexpr std::size_t SWEEP_ORDERS_PER_LEVEL = 10;
+
+void placeLevels(PassiveOrderBook<> &passive_order_book, const std::size_t &depth,
+                 const std::size_t &orders_per_level) {
+  OrderIDType order_id{0};
+  for (std::size_t level = 0; level < depth; level++) {
+    for (std::size_t cnt = 0; cnt < orders_per_level; cnt++, order_id++) {
+      passive_order_book.placePassiveOrder(order_id % BENCH_NUMBER_OF_CLIENTS, order_id, OrderType::LIMIT,
+                                           OrderSide::SELL, BENCH_BASE_PRICE + level, BENCH_ORDER_SIZE, nullptr);
+    }
+  }
+}
+
+} // end of anonymous local namespace
+
+void registerMatchingAlgoBenchmarks(BenchmarkSuite &suite) {
+
+  // Each aggressor fully takes the order at the front of a single level
+  for (const auto orders : LEVEL_ORDER_COUNTS) {
+    suite.add("Matching/singleLevelMatch/orders:" + std::to_string(orders), [orders](BenchmarkRun &run) {
+      PriceTimePriorityMatching<> matching_algo;
+      NullEngineEventObserver observer;
+
+      while (run.keepRunning()) {
+        PassiveOrderBook<> passive_order_book;
+        placeLevels(passive_order_book, 1, orders);
+
+        run.measure(orders, [&] {
+          for (OrderIDType order_id = 0; order_id < orders; order_id++) {
+            ClientOrderRequest<> order_request{OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, order_id,
+                                               BENCH_ORDER_SIZE, BENCH_BASE_PRICE, BENCH_AGGRESSOR_CLIENT, 0};
+            matching_algo.doProcessOrderRequest(order_request, passive_order_book, observer);
+          }
+        });
+      }
+    });
+  }
+
+  // Each aggressor is allocated across every order left in a single level, pro-rata
+  for (const auto orders : LEVEL_ORDER_COUNTS) {
+    suite.add("Matching/proRataLevelMatch/orders:" + std::to_string(orders), [orders](BenchmarkRun &run) {
+      ProRataMatching<> matching_algo;
+      NullEngineEventObserver observer;
+
+      while (run.keepRunning()) {
+        PassiveOrderBook<> passive_order_book;
+        placeLevels(passive_order_book, 1, orders);
+
+        run.measure(orders, [&] {
+          for (OrderIDType order_id = 0; order_id < orders; order_id++) {
+            ClientOrderRequest<> order_request{OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, order_id,
+                                               BENCH_ORDER_SIZE, BENCH_BASE_PRICE, BENCH_AGGRESSOR_CLIENT, 0};
+            matching_algo.doProcessOrderRequest(order_request, passive_order_book, observer);
+          }
+        });
+      }
+    });
+  }
+
+  // A single aggressor takes out every level of the book
+  for (const auto depth : SWEEP_DEPTHS) {
+    suite.add("Matching/multiLevelSweep/depth:" + std::to_string(depth), [depth](BenchmarkRun &run) {
+      PriceTimePriorityMatching<> matching_algo;
+      NullEngineEventObserver observer;
+
+      while (run.keepRunning()) {
+        PassiveOrderBook<> passive_order_book;
+        placeLevels(passive_order_book, depth, SWEEP_ORDERS_PER_LEVEL);
+
+        ClientOrderRequest<> order_request{OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, 0,
+                                           BENCH_ORDER_SIZE * SWEEP_ORDERS_PER_LEVEL * depth,
+                                           std::numeric_limits<PriceType>::max(), BENCH_AGGRESSOR_CLIENT, 0};
+        run.measure(1, [&] { matching_algo.doProcessOrderRequest(order_request, passive_order_book, observer); });
+      }
+    });
+  }
+}
+
+} // end of namespace
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "matching/passive_order_book.hpp"
+
+using namespace codetest::matching_engine_sim;
+
+namespace codetest::matching_engine_sim_bench {
+
+namespace {
+
+constexpr PriceType BENCH_BASE_PRICE = 10000;
+constexpr SizeType BENCH_ORDER_SIZE = 100;
+constexpr ClientType BENCH_NUMBER_OF_CLIENTS = 8;
+
+constexpr std::size_t BOOK_DEPTHS[] = {1, 10, 100};
+constexpr std::size_t ORDER_COUNTS[] = {1000, 100000};
+
+std::string benchmarkName(const char *operation, const std::size_t &depth, const std::size_t &orders) {
+  return std::string("PassiveOrderBook/") + operation + "/depth:" + std::to_string(depth)
+      + "/orders:" + std::to_string(orders);
+}
+
+// Resting sells spread round robin over depth price levels
+void placeOrders(PassiveOrderBook<> &passive_order_book, const std::size_t &depth, const std::size_t &orders) {
+  for (std::size_t cnt = 0; cnt < orders; cnt++) {
+    passive_order_book.placePassiveOrder(cnt % BENCH_NUMBER_OF_CLIENTS, cnt, OrderType::LIMIT, OrderSide::SELL,
+                                         BENCH_BASE_PRICE + cnt % depth, BENCH_ORDER_SIZE, nullptr);
+  }
+}
+
+} // end of anonymous local namespace
+
+void registerPassiveOrderBookBenchmarks(BenchmarkSuite &suite) {
+  for (const auto depth : BOOK_DEPTHS) {
+    for (const auto orders : ORDER_COUNTS) {
+
+      suite.add(benchmarkName("placePassiveOrder", depth, orders), [depth, orders](BenchmarkRun &run) {
+        while (run.keepRunning()) {
+          PassiveOrderBook<> passive_order_book;
+          run.measure(orders, [&] { placeOrders(passive_order_book, depth, orders); });
+        }
+      });
+
+      suite.add(benchmarkName("cancelClientOrder", depth, orders), [depth, orders](BenchmarkRun &run) {
+        // Cancels arrive in no particular order
+        std::vector<OrderIDType> cancel_order(orders);
+        std::iota(cancel_order.begin(), cancel_order.end(), 0);
+        std::shuffle(cancel_order.begin(), cancel_order.end(), std::mt19937_64{42});
+
+        while (run.keepRunning()) {
+          PassiveOrderBook<> passive_order_book;
+          placeOrders(passive_order_book, depth, orders);
+          run.measure(orders, [&] {
+            for (const auto &order_id : cancel_order) {
+              passive_order_book.cancelClientOrder(order_id % BENCH_NUMBER_OF_CLIENTS, order_id);
+            }
+          });
+        }
+      });
+
+      suite.add(benchmarkName("isOrderExist", depth, orders), [depth, orders](BenchmarkRun &run) {
+        PassiveOrderBook<> passive_order_book;
+        placeOrders(passive_order_book, depth, orders);
+
+        // Every other lookup misses
+        while (run.keepRunning()) {
+          run.measure(orders, [&] {
+            std::size_t found{0};
+            for (OrderIDType order_id = 0; order_id < orders * 2; order_id += 2) {
+              found += passive_order_book.isOrderExist(order_id % BENCH_NUMBER_OF_CLIENTS, order_id);
+            }
+            doNotOptimize(found);
+          });
+        }
+      });
+    }
+  }
+}
+
+} // end of namespace
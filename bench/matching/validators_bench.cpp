@@ -0,0 +1,66 @@
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "matching/passive_order_book.hpp"
+#include "matching/validators/validators.hpp"
+#include "matching/validators/matching_validators.hpp"
+#include "matching/validators/new_order_request_validators.hpp"
+#include "matching/validators/cancel_request_validators.hpp"
+
+using namespace codetest::matching_engine_sim;
+
+namespace codetest::matching_engine_sim_bench {
+
+namespace {
+
+constexpr PriceType BENCH_BASE_PRICE = 10000;
+constexpr SizeType BENCH_ORDER_SIZE = 100;
+constexpr ClientType BENCH_NUMBER_OF_CLIENTS = 8;
+constexpr std::size_t BENCH_BOOK_ORDERS = 10000;
+constexpr std::size_t BENCH_REQUESTS = 1000;
+
+template<typename ValidatorChain>
+void addValidatorsBenchmark(BenchmarkSuite &suite, const std::string &name) {
+  suite.add("Validators/" + name, [](BenchmarkRun &run) {
+    PassiveOrderBook<> passive_order_book;
+    for (std::size_t cnt = 0; cnt < BENCH_BOOK_ORDERS; cnt++) {
+      passive_order_book.placePassiveOrder(cnt % BENCH_NUMBER_OF_CLIENTS, cnt, OrderType::LIMIT, OrderSide::SELL,
+                                           BENCH_BASE_PRICE + cnt % 10, BENCH_ORDER_SIZE, nullptr);
+    }
+    const PassiveOrder<> passive_order{0, 0, BENCH_ORDER_SIZE};
+
+    // Half of the requests refer to resting orders
+    std::vector<ClientOrderRequest<>> order_requests;
+    for (std::size_t cnt = 0; cnt < BENCH_REQUESTS; cnt++) {
+      const OrderIDType order_id = cnt * (BENCH_BOOK_ORDERS * 2 / BENCH_REQUESTS);
+      order_requests.emplace_back(OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, order_id, BENCH_ORDER_SIZE,
+                                  BENCH_BASE_PRICE, order_id % BENCH_NUMBER_OF_CLIENTS, 0);
+    }
+
+    while (run.keepRunning()) {
+      run.measure(order_requests.size(), [&] {
+        std::size_t errors{0};
+        for (const auto &order_request : order_requests) {
+          errors += ValidatorChain::validate(order_request, passive_order_book, passive_order)
+              != ValidationResponse::NO_ERROR;
+        }
+        doNotOptimize(errors);
+      });
+    }
+  });
+}
+
+} // end of anonymous local namespace
+
+void registerValidatorsBenchmarks(BenchmarkSuite &suite) {
+  addValidatorsBenchmark<Validators<void>>(suite, "none");
+  addValidatorsBenchmark<Validators<void, NoSelfMatchValidator<>>>(suite, "match/NoSelfMatch");
+  addValidatorsBenchmark<Validators<void, NoSuchOrderCancelValidator<>>>(suite, "cancel/NoSuchOrder");
+  addValidatorsBenchmark<Validators<void, NoSuchOrderInsertValidator<>>>(suite, "new/NoSuchOrder");
+  addValidatorsBenchmark<Validators<void,
+                                    NewOrderRequestSizeValidator<BENCH_ORDER_SIZE * 10>,
+                                    NoSuchOrderInsertValidator<>>>(suite, "new/OrderSize+NoSuchOrder");
+}
+
+} // end of namespace
@@ -0,0 +1,54 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include "bench_harness.h"
+
+using namespace codetest::matching_engine_sim_bench;
+
+namespace {
+
+int printUsage(const char *program) {
+  std::fprintf(stderr, "usage: %s [--min-time-ms <ms>] [--min-samples <samples>] [--perf-counters] [name filter]\n",
+               program);
+  return 1;
+}
+
+} // end of anonymous local namespace
+
+int main(int argc, char *argv[]) {
+  std::string filter;
+  std::uint64_t min_samples = 200;
+  std::uint64_t min_time_ms = 200;
+  bool perf_counters = false;
+
+  for (int index = 1; index < argc; index++) {
+    if (std::strcmp(argv[index], "--min-time-ms") == 0 && index + 1 < argc) {
+      min_time_ms = std::strtoull(argv[++index], nullptr, 10);
+    } else if (std::strcmp(argv[index], "--min-samples") == 0 && index + 1 < argc) {
+      min_samples = std::strtoull(argv[++index], nullptr, 10);
+    } else if (std::strcmp(argv[index], "--perf-counters") == 0) {
+      perf_counters = true;
+    } else if (argv[index][0] == '-') {
+      return printUsage(argv[0]);
+    } else {
+      filter = argv[index];
+    }
+  }
+
+  try {
+    BenchmarkSuite suite;
+    registerPassiveOrderBookBenchmarks(suite);
+    registerMatchingAlgoBenchmarks(suite);
+    registerValidatorsBenchmarks(suite);
+    registerCallAuctionBenchmarks(suite);
+
+    suite.run(filter, min_samples, std::chrono::milliseconds{min_time_ms}, perf_counters);
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,129 @@
+#include "perf_counters.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace codetest::matching_engine_sim_bench {
+
+const char *toString(const PerfCounter &counter) {
+  switch (counter) {
+    case PerfCounter::CYCLES: return "cycles";
+    case PerfCounter::INSTRUCTIONS: return "instructions";
+    case PerfCounter::L1D_MISSES: return "L1D misses";
+    case PerfCounter::LLC_MISSES: return "LLC misses";
+    case PerfCounter::BRANCH_MISSES: return "branch misses";
+    default: return "unknown";
+  }
+}
+
+#ifdef __linux__
+
+namespace {
+
+struct PerfEventType {
+  std::uint32_t type_;
+  std::uint64_t config_;
+};
+
+constexpr std::uint64_t cacheEvent(const std::uint64_t &cache, const std::uint64_t &operation,
+                                   const std::uint64_t &result) {
+  return cache | (operation << 8) | (result << 16);
+}
+
+constexpr PerfEventType PERF_EVENT_TYPES[PERF_COUNTER_SIZE] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                    PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int openPerfEvent(const PerfEventType &event_type, const int &group_fd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = event_type.type_;
+  attr.config = event_type.config_;
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+} // end of anonymous local namespace
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+
+  for (std::size_t index = 0; index < PERF_COUNTER_SIZE; index++) {
+    const int fd = openPerfEvent(PERF_EVENT_TYPES[index], group_fd_);
+    if (fd < 0) {
+      // Without cycles as the group leader there is nothing to measure against
+      if (index == 0) {
+        unavailable_reason_ = std::string{"perf_event_open: "} + std::strerror(errno);
+        return;
+      }
+      continue;
+    }
+    if (index == 0) group_fd_ = fd;
+    fds_[index] = fd;
+    read_index_[index] = opened_++;
+  }
+
+  ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::~PerfCounters() {
+  for (const auto &fd : fds_) {
+    if (fd >= 0) close(fd);
+  }
+}
+
+PerfCounterValues PerfCounters::read() const {
+  PerfCounterValues values{};
+  if (!isAvailable()) return values;
+
+  // nr, time enabled, time running, then one value per opened counter
+  std::uint64_t buffer[3 + PERF_COUNTER_SIZE]{};
+  const auto expected_size = static_cast<ssize_t>((3 + opened_) * sizeof(std::uint64_t));
+  if (::read(group_fd_, buffer, sizeof(buffer)) < expected_size) return values;
+
+  const auto time_enabled = buffer[1];
+  const auto time_running = buffer[2];
+  for (std::size_t index = 0; index < PERF_COUNTER_SIZE; index++) {
+    if (fds_[index] < 0) continue;
+    auto value = buffer[3 + read_index_[index]];
+    if (time_running > 0 && time_running < time_enabled) {
+      value = static_cast<std::uint64_t>(static_cast<double>(value) * static_cast<double>(time_enabled)
+                                             / static_cast<double>(time_running));
+    }
+    values[index] = value;
+  }
+  return values;
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+  unavailable_reason_ = "perf_event_open requires Linux";
+}
+
+PerfCounters::~PerfCounters() = default;
+
+PerfCounterValues PerfCounters::read() const {
+  return PerfCounterValues{};
+}
+
+#endif
+
+} // end of namespace
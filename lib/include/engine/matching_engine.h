@@ -1,17 +1,30 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <unordered_set>
 #include <set>
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 
 #include "matching/matching_algo.hpp"
 #include "matching/passive_order_book.hpp"
 #include "matching/validators/matching_validators.hpp"
 #include "matching/validators/new_order_request_validators.hpp"
 #include "matching/validators/cancel_request_validators.hpp"
+#include "matching/validators/amend_request_validators.hpp"
+#include "persistence/request_journal.hpp"
+#include "persistence/book_snapshot.hpp"
+#include "engine/matching_engine_options.h"
+#include "engine/null_engine_event_observer.h"
+#include "engine/snapshot_barrier.h"
+#include "monitoring/engine_counters.h"
+#include "monitoring/latency_tracker.h"
 #include "interface/i_matching_algo.h"
 #include "interface/i_matching_engine.h"
 #include "events/client_order_request.h"
@@ -23,15 +36,28 @@ namespace {
 
 constexpr static unsigned DEFAULT_ORDER_QUEUE_SIZE = 1024;
 
+[[nodiscard]] constexpr bool isControlAction(const OrderAction &order_action) {
+  return order_action == OrderAction::SNAPSHOT_BARRIER;
+}
+
 template<typename OrderExt = void>
 struct MatchingInstrument {
-  MatchingInstrument() {
+  explicit MatchingInstrument(const InstrumentType &instrument) : instrument_(instrument) {
     request_queue_.reserve(DEFAULT_ORDER_QUEUE_SIZE);
   }
 
+  const InstrumentType instrument_{};
+  // Journal position the book was restored up to, journaled requests before it are already reflected
+  JournalPosition restored_position_{};
   PassiveOrderBook<OrderExt> passive_order_book_{};
   std::vector<ClientOrderRequest<OrderExt>> request_queue_{};
+  // Submission time stamp of each request in request_queue_, kept only while latency tracking is enabled
+  std::vector<std::uint64_t> request_timestamps_{};
+  // One entry per SNAPSHOT_BARRIER request sitting in request_queue_, in the same order
+  std::deque<std::shared_ptr<SnapshotBarrier>> pending_barriers_{};
   std::mutex mutex_{};
+  // Written by the processor thread of the instrument only
+  EngineCounterBlock counters_{};
 };
 
 template<typename OrderExt = void>
@@ -40,18 +66,38 @@ class OrderQueueProcessor {
   OrderQueueProcessor(
       const std::shared_ptr<IMatchingAlgo<OrderExt>> &matching_algo,
       const std::shared_ptr<IEngineEventObserver> &observer)
-      : matching_algo_(matching_algo), observer_(observer), in_operation_(true) {}
+      : matching_algo_(matching_algo),
+        observer_(observer),
+        counters_(std::make_unique<EngineCounterBlock>()),
+        counting_observer_(std::make_shared<CountingEngineEventObserver>(*counters_, observer)),
+        in_operation_(true) {}
 
   template<typename F>
   void addMatchingInstrument(F &&matching_instrument_ptr);
+  void setJournalWriter(std::unique_ptr<RequestJournalWriter<OrderExt>> &&journal_writer);
+  void enableLatencyTracking();
+  [[nodiscard]] const LatencyTracker *getLatencyTracker() const { return latency_tracker_.get(); }
+  [[nodiscard]] EngineCounters readCounters() const { return counters_->read(); }
+
+  // Snapshots must not run concurrently with processOrderQueue
+  void saveSnapshots(const std::string &directory) const;
+  void restoreSnapshots(const std::string &directory);
 
   void processOrderQueue();
   void terminate();
 
  private:
+  void doSnapshotBarrier(MatchingInstrument<OrderExt> &matching_instrument, const JournalPosition &journal_position);
+
   std::vector<std::shared_ptr<MatchingInstrument<OrderExt>>> matching_instruments_;
   const std::shared_ptr<IMatchingAlgo<OrderExt>> matching_algo_{};
   std::shared_ptr<IEngineEventObserver> observer_{};
+  // Written by the processor thread only
+  std::unique_ptr<EngineCounterBlock> counters_{};
+  std::shared_ptr<CountingEngineEventObserver> counting_observer_{};
+  std::unique_ptr<RequestJournalWriter<OrderExt>> journal_writer_{};
+  std::unique_ptr<LatencyTracker> latency_tracker_{};
+  std::unique_ptr<LatencyStampingObserver> latency_stamping_observer_{};
   std::atomic<bool> in_operation_{};
 };
 
@@ -61,33 +107,157 @@ void OrderQueueProcessor<OrderExt>::addMatchingInstrument(F &&matching_instrumen
   matching_instruments_.push_back(std::forward<F>(matching_instrument_ptr));
 }
 
+template<typename OrderExt>
+void OrderQueueProcessor<OrderExt>::setJournalWriter(std::unique_ptr<RequestJournalWriter<OrderExt>> &&journal_writer) {
+  journal_writer_ = std::move(journal_writer);
+}
+
+template<typename OrderExt>
+void OrderQueueProcessor<OrderExt>::enableLatencyTracking() {
+  latency_tracker_ = std::make_unique<LatencyTracker>();
+  latency_stamping_observer_ = std::make_unique<LatencyStampingObserver>(counting_observer_);
+}
+
+template<typename OrderExt>
+void OrderQueueProcessor<OrderExt>::saveSnapshots(const std::string &directory) const {
+  const auto journal_position = journal_writer_ ? journal_writer_->getPosition() : JournalPosition{};
+  for (const auto &matching_instrument : matching_instruments_) {
+    const auto path = std::filesystem::path(directory) / bookSnapshotFileName(matching_instrument->instrument_);
+    saveBookSnapshot(path.string(),
+                     matching_instrument->passive_order_book_,
+                     matching_instrument->instrument_,
+                     journal_position);
+  }
+}
+
+template<typename OrderExt>
+void OrderQueueProcessor<OrderExt>::restoreSnapshots(const std::string &directory) {
+  for (auto &matching_instrument : matching_instruments_) {
+    const auto path = std::filesystem::path(directory) / bookSnapshotFileName(matching_instrument->instrument_);
+    // No snapshot simply means an instrument without any order
+    if (!std::filesystem::exists(path)) continue;
+
+    const auto header = loadBookSnapshot(path.string(), matching_instrument->passive_order_book_);
+    if (header.instrument_ != matching_instrument->instrument_) {
+      throw std::runtime_error("book snapshot belongs to another instrument " + path.string());
+    }
+    matching_instrument->restored_position_ = header.journal_position_;
+  }
+}
+
+template<typename OrderExt>
+void OrderQueueProcessor<OrderExt>::doSnapshotBarrier(MatchingInstrument<OrderExt> &matching_instrument,
+                                                      const JournalPosition &journal_position) {
+  std::shared_ptr<SnapshotBarrier> barrier;
+  {
+    std::lock_guard<std::mutex> _{matching_instrument.mutex_};
+    barrier = std::move(matching_instrument.pending_barriers_.front());
+    matching_instrument.pending_barriers_.pop_front();
+  }
+
+  try {
+    const auto path = std::filesystem::path(barrier->getDirectory())
+        / bookSnapshotFileName(matching_instrument.instrument_);
+    saveBookSnapshot(path.string(),
+                     matching_instrument.passive_order_book_,
+                     matching_instrument.instrument_,
+                     journal_position);
+    barrier->onInstrumentSaved();
+  } catch (...) {
+    barrier->onInstrumentFailed(std::current_exception());
+  }
+}
+
 template<typename OrderExt>
 void OrderQueueProcessor<OrderExt>::processOrderQueue() {
 
   std::vector<ClientOrderRequest<OrderExt>> client_order_request_queue;
   client_order_request_queue.reserve(DEFAULT_ORDER_QUEUE_SIZE);
+  std::vector<std::uint64_t> request_timestamps;
+  if (latency_tracker_) request_timestamps.reserve(DEFAULT_ORDER_QUEUE_SIZE);
 
   while (in_operation_) {
+    const auto pass_start = readTimestampCounter();
+    bool busy{false};
+    const auto now = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
 
     for (auto &matching_instrument : matching_instruments_) {
+      // Orders expiring by now are out of the book before any request is matched against it
+      counting_observer_->setInstrumentCounters(&matching_instrument->counters_);
+      matching_algo_->doExpireOrders(matching_instrument->passive_order_book_,
+                                     matching_instrument->instrument_,
+                                     now,
+                                     *counting_observer_);
+
       {
         std::lock_guard<std::mutex> _{matching_instrument->mutex_};
         if (!matching_instrument->request_queue_.empty()) {
           matching_instrument->request_queue_.swap(client_order_request_queue);
+          if (latency_tracker_) matching_instrument->request_timestamps_.swap(request_timestamps);
         }
       }
 
       if (client_order_request_queue.empty()) continue;
+      const auto dequeued = latency_tracker_ ? readTimestampCounter() : 0;
+
+      busy = true;
+      auto &instrument_counters = matching_instrument->counters_;
+      counters_->recordQueueDepth(client_order_request_queue.size());
+      instrument_counters.recordQueueDepth(client_order_request_queue.size());
+      counting_observer_->setInstrumentCounters(&instrument_counters);
+
+      // Write ahead, the batch is journaled before any request in it takes effect on the book
+      JournalPosition journal_position{};
+      if (journal_writer_) {
+        journal_position = journal_writer_->getPosition();
+        for (const auto &order_request : client_order_request_queue) {
+          if (!isControlAction(order_request.order_action_)) journal_writer_->append(order_request, now);
+        }
+        journal_writer_->commitBatch();
+      }
 
       for (auto itr = client_order_request_queue.begin(); itr != client_order_request_queue.end(); itr++) {
         ClientOrderRequest<OrderExt> &order_request = *itr;
-        matching_algo_->doProcessOrderRequest(order_request, matching_instrument->passive_order_book_, *observer_);
+
+        if (order_request.order_action_ == OrderAction::SNAPSHOT_BARRIER) {
+          doSnapshotBarrier(*matching_instrument, journal_position);
+          continue;
+        }
+
+        // Keep track of the journal position of the next request, that is where a snapshot taken next resumes
+        if (journal_writer_) journal_position.sequence_++;
+        counters_->countRequest(order_request.order_action_);
+        instrument_counters.countRequest(order_request.order_action_);
+
+        if (latency_tracker_) {
+          latency_stamping_observer_->beginRequest();
+          matching_algo_->doProcessOrderRequest(order_request,
+                                                matching_instrument->passive_order_book_,
+                                                *latency_stamping_observer_);
+          latency_tracker_->recordRequest(request_timestamps[itr - client_order_request_queue.begin()],
+                                          dequeued,
+                                          latency_stamping_observer_->getFirstEventTimestamp(),
+                                          readTimestampCounter());
+        } else {
+          matching_algo_->doProcessOrderRequest(order_request,
+                                                matching_instrument->passive_order_book_,
+                                                *counting_observer_);
+        }
       }
 
       client_order_request_queue.clear();
+      request_timestamps.clear();
     }
 
+    // A lull must not leave the last batch unflushed until the next one commits
+    if (!busy && journal_writer_) journal_writer_->flushIfDue();
+
+    counters_->addPassTime(busy, readTimestampCounter() - pass_start);
+
   }
+
+  if (journal_writer_) journal_writer_->close();
 }
 
 template<typename OrderExt>
@@ -102,31 +272,65 @@ struct DefaultMatchingEngine : public IMatchingEngine<OrderExt> {
 
   DefaultMatchingEngine(const std::uint8_t &number_of_thread,
                         const std::set<InstrumentType> &instruments,
-                        const std::shared_ptr<IEngineEventObserver> &observer);
+                        const std::shared_ptr<IEngineEventObserver> &observer,
+                        const MatchingEngineOptions &options = MatchingEngineOptions{});
 
   void doOrderRequest(const ClientOrderRequest<OrderExt> &client_order_request) override;
   void terminate() override;
 
+  // Writes one snapshot file per instrument into directory, in parallel across processors.
+  // Only valid once the engine is terminated, as processors would otherwise be mutating the books.
+  void saveSnapshot(const std::string &directory) const;
+
+  // Consistent point-in-time snapshot of a running engine. A barrier request is enqueued to every instrument
+  // atomically with respect to doOrderRequest, each processor writes the book as it reaches the barrier and carries
+  // on processing. Returned barrier tells when all books are written, or fails should the engine terminate first.
+  // Throws once the engine is terminated.
+  std::shared_ptr<SnapshotBarrier> takeSnapshot(const std::string &directory);
+
+  // Merges the histogram of stage from every processor into histogram, may be called while running.
+  // Values are time stamp counter ticks, see timestampCounterTicksPerNanosecond().
+  void collectLatencyHistogram(const LatencyStage &latency_stage, LatencyHistogram &histogram) const;
+  void writeLatencyReport(std::ostream &os) const;
+
+  // Counters as of now, may be called while running. One entry per processor thread, sum them for the engine total.
+  [[nodiscard]] std::vector<EngineCounters> collectThreadCounters() const;
+  [[nodiscard]] std::unordered_map<InstrumentType, EngineCounters> collectInstrumentCounters() const;
+
   using MatchValidators = Validators<OrderExt, NoSelfMatchValidator<OrderExt>>;
   using NewValidators = Validators<OrderExt, NoSuchOrderInsertValidator<OrderExt>>;
   using CancelValidators = Validators<OrderExt, NoSuchOrderCancelValidator<OrderExt>>;
-  using DefaultMatchingAlgo = PriceTimePriorityMatching<OrderExt, MatchValidators, NewValidators, CancelValidators>;
+  using AmendValidators = Validators<OrderExt>;
+  using DefaultMatchingAlgo =
+      PriceTimePriorityMatching<OrderExt, MatchValidators, NewValidators, CancelValidators, AmendValidators>;
 
  private:
 
+  // Rebuilds order books by feeding journaled requests straight into the matching algo, bypassing request queues
+  void restoreFromJournal(const std::string &directory);
+
+  // Runs f(OrderQueueProcessor &) on a dedicated thread per processor, rethrowing the first failure
+  template<typename F>
+  void forEachProcessorInParallel(F &&f) const;
+
   std::shared_ptr<DefaultMatchingAlgo> matching_algo_{};
 
   std::unordered_map<InstrumentType, std::shared_ptr<MatchingInstrument<OrderExt>>> matching_instruments_{};
 
   std::vector<std::unique_ptr<OrderQueueProcessor<OrderExt>>> order_queue_processors_{};
   std::vector<std::unique_ptr<std::thread>> processor_threads_{};
+
+  bool latency_tracking_{false};
+  std::string latency_report_path_{};
+  std::atomic<bool> terminated_{false};
 };
 
 template<typename OrderExt>
 DefaultMatchingEngine<OrderExt>::DefaultMatchingEngine(
     const std::uint8_t &number_of_thread,
     const std::set<InstrumentType> &instruments,
-    const std::shared_ptr<IEngineEventObserver> &observer) {
+    const std::shared_ptr<IEngineEventObserver> &observer,
+    const MatchingEngineOptions &options) {
 
   if (number_of_thread == 0) {
     throw std::invalid_argument("number of thread cannot be 0");
@@ -141,13 +345,44 @@ DefaultMatchingEngine<OrderExt>::DefaultMatchingEngine(
   std::uint8_t thread_index = static_cast<std::uint8_t>(number_of_thread - 1);
 
   for (const InstrumentType &inst : instruments) {
-    auto [itr, ok] = matching_instruments_.emplace(inst, std::move(std::make_shared<MatchingInstrument<OrderExt>>()));
+    auto [itr, ok] = matching_instruments_.emplace(
+        inst, std::move(std::make_shared<MatchingInstrument<OrderExt>>(inst)));
     if (++thread_index == number_of_thread) {
       thread_index = 0;
     }
     order_queue_processors_[thread_index]->addMatchingInstrument(itr->second);
   }
 
+  if (!HasOrderExtCodec<OrderExt>::value && (options.journal_.isEnabled() || !options.snapshot_directory_.empty())) {
+    throw std::invalid_argument("journaling and snapshots need an OrderExtCodec for the custom order fields");
+  }
+
+  if (!options.snapshot_directory_.empty()) {
+    forEachProcessorInParallel([&](OrderQueueProcessor<OrderExt> &processor) {
+      processor.restoreSnapshots(options.snapshot_directory_);
+    });
+  }
+
+  if (options.latency_tracking_.enabled_) {
+    latency_tracking_ = true;
+    latency_report_path_ = options.latency_tracking_.report_path_;
+    for (auto &processor : order_queue_processors_) {
+      processor->enableLatencyTracking();
+    }
+  }
+
+  if (options.journal_.isEnabled()) {
+    if (options.journal_.replay_on_start_) {
+      restoreFromJournal(options.journal_.directory_);
+    }
+
+    const auto epoch = nextJournalEpoch(options.journal_.directory_);
+    for (thread_index = 0; thread_index < number_of_thread; thread_index++) {
+      order_queue_processors_[thread_index]->setJournalWriter(
+          std::make_unique<RequestJournalWriter<OrderExt>>(options.journal_, epoch, thread_index));
+    }
+  }
+
   for (thread_index = 0; thread_index < number_of_thread; thread_index++) {
     processor_threads_.emplace_back(
         std::move(
@@ -160,26 +395,174 @@ DefaultMatchingEngine<OrderExt>::DefaultMatchingEngine(
 template<typename OrderExt>
 void DefaultMatchingEngine<OrderExt>::doOrderRequest(const ClientOrderRequest<OrderExt> &client_order_request) {
 
+  // Control requests are engine internal only
+  if (isControlAction(client_order_request.order_action_)) return;
+
   const auto &instrument = client_order_request.instrument_;
   if (auto itr = matching_instruments_.find(instrument); itr != matching_instruments_.end()) {
     auto &matching_instrument = itr->second;
     auto &request_queue = matching_instrument->request_queue_;
     auto client_order_request_clone = client_order_request;
+    const auto submitted = latency_tracking_ ? readTimestampCounter() : 0;
 
     std::lock_guard<std::mutex> _{matching_instrument->mutex_};
     request_queue.emplace_back(std::move(client_order_request_clone));
+    if (latency_tracking_) matching_instrument->request_timestamps_.push_back(submitted);
   }
 
 }
 
+template<typename OrderExt>
+void DefaultMatchingEngine<OrderExt>::restoreFromJournal(const std::string &directory) {
+  NullEngineEventObserver null_observer;
+
+  replayJournal<OrderExt>(directory, [&, this](const JournalPosition &position,
+                                               ClientOrderRequest<OrderExt> &order_request,
+                                               const std::uint64_t &request_time) {
+    if (auto itr = matching_instruments_.find(order_request.instrument_); itr != matching_instruments_.end()) {
+      auto &matching_instrument = itr->second;
+      // Skip what is already reflected in the book snapshot
+      if (position < matching_instrument->restored_position_) return;
+      // Orders the live run had expired by the time of the request are out of the book first, as they were then
+      matching_algo_->doExpireOrders(matching_instrument->passive_order_book_,
+                                     matching_instrument->instrument_,
+                                     request_time,
+                                     null_observer);
+      matching_algo_->doProcessOrderRequest(order_request, matching_instrument->passive_order_book_, null_observer);
+    }
+  });
+}
+
+template<typename OrderExt>
+template<typename F>
+void DefaultMatchingEngine<OrderExt>::forEachProcessorInParallel(F &&f) const {
+  std::vector<std::exception_ptr> failures(order_queue_processors_.size());
+  std::vector<std::thread> workers;
+
+  for (std::size_t index = 0; index < order_queue_processors_.size(); index++) {
+    workers.emplace_back([&, index] {
+      try {
+        f(*order_queue_processors_[index]);
+      } catch (...) {
+        failures[index] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (const auto &failure : failures) {
+    if (failure) std::rethrow_exception(failure);
+  }
+}
+
+template<typename OrderExt>
+void DefaultMatchingEngine<OrderExt>::saveSnapshot(const std::string &directory) const {
+  if constexpr (!HasOrderExtCodec<OrderExt>::value) {
+    throw std::logic_error("snapshots need an OrderExtCodec for the custom order fields");
+  }
+  std::filesystem::create_directories(directory);
+  forEachProcessorInParallel([&](const OrderQueueProcessor<OrderExt> &processor) {
+    processor.saveSnapshots(directory);
+  });
+}
+
+template<typename OrderExt>
+std::shared_ptr<SnapshotBarrier> DefaultMatchingEngine<OrderExt>::takeSnapshot(const std::string &directory) {
+  if constexpr (!HasOrderExtCodec<OrderExt>::value) {
+    throw std::logic_error("snapshots need an OrderExtCodec for the custom order fields");
+  }
+  std::filesystem::create_directories(directory);
+  auto barrier = std::make_shared<SnapshotBarrier>(directory, matching_instruments_.size());
+
+  // Holding every instrument queue at once makes the barrier a single cut through the input stream,
+  // any request is either ahead of the barrier on all instruments or behind it. doOrderRequest only holds
+  // one instrument lock at a time, so intake is paused just for the duration of enqueuing the barriers.
+  std::vector<std::unique_lock<std::mutex>> instrument_locks;
+  instrument_locks.reserve(matching_instruments_.size());
+  for (auto &[instrument, matching_instrument] : matching_instruments_) {
+    instrument_locks.emplace_back(matching_instrument->mutex_);
+  }
+
+  // Checked under the instrument locks, so a barrier enqueued here is failed by terminate if not reached
+  if (terminated_) throw std::logic_error("snapshot barrier requested on a terminated matching engine");
+
+  for (auto &[instrument, matching_instrument] : matching_instruments_) {
+    ClientOrderRequest<OrderExt> barrier_request;
+    barrier_request.order_action_ = OrderAction::SNAPSHOT_BARRIER;
+    barrier_request.instrument_ = instrument;
+    matching_instrument->request_queue_.emplace_back(std::move(barrier_request));
+    matching_instrument->pending_barriers_.push_back(barrier);
+    if (latency_tracking_) matching_instrument->request_timestamps_.push_back(0);
+  }
+
+  return barrier;
+}
+
 template<typename OrderExt>
 void DefaultMatchingEngine<OrderExt>::terminate() {
+  if (terminated_.exchange(true)) return;
+
   for (auto &processor : order_queue_processors_) {
     processor->terminate();
   }
   for (auto &t : processor_threads_) {
     t.get()->join();
   }
+
+  // Barriers processors never reached would otherwise leave their waiters blocked for good
+  for (auto &[instrument, matching_instrument] : matching_instruments_) {
+    std::lock_guard<std::mutex> _{matching_instrument->mutex_};
+    for (auto &barrier : matching_instrument->pending_barriers_) {
+      barrier->onInstrumentFailed(std::make_exception_ptr(
+          std::runtime_error("matching engine terminated before the snapshot barrier was reached")));
+    }
+    matching_instrument->pending_barriers_.clear();
+  }
+
+  if (!latency_report_path_.empty()) {
+    std::ofstream report{latency_report_path_};
+    writeLatencyReport(report);
+  }
+}
+
+template<typename OrderExt>
+void DefaultMatchingEngine<OrderExt>::collectLatencyHistogram(const LatencyStage &latency_stage,
+                                                              LatencyHistogram &histogram) const {
+  for (const auto &processor : order_queue_processors_) {
+    if (const auto *latency_tracker = processor->getLatencyTracker()) {
+      histogram.merge(latency_tracker->getHistogram(latency_stage));
+    }
+  }
+}
+
+template<typename OrderExt>
+std::vector<EngineCounters> DefaultMatchingEngine<OrderExt>::collectThreadCounters() const {
+  std::vector<EngineCounters> thread_counters;
+  for (const auto &processor : order_queue_processors_) {
+    thread_counters.push_back(processor->readCounters());
+  }
+  return thread_counters;
+}
+
+template<typename OrderExt>
+std::unordered_map<InstrumentType, EngineCounters> DefaultMatchingEngine<OrderExt>::collectInstrumentCounters() const {
+  std::unordered_map<InstrumentType, EngineCounters> instrument_counters;
+  for (const auto &[instrument, matching_instrument] : matching_instruments_) {
+    instrument_counters.emplace(instrument, matching_instrument->counters_.read());
+  }
+  return instrument_counters;
+}
+
+template<typename OrderExt>
+void DefaultMatchingEngine<OrderExt>::writeLatencyReport(std::ostream &os) const {
+  std::vector<const LatencyTracker *> latency_trackers;
+  for (const auto &processor : order_queue_processors_) {
+    if (const auto *latency_tracker = processor->getLatencyTracker()) latency_trackers.push_back(latency_tracker);
+  }
+  codetest::matching_engine_sim::writeLatencyReport(os, latency_trackers);
 }
 
 } // end of namespace
\ No newline at end of file
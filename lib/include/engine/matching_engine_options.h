@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+#include "persistence/journal_options.h"
+#include "monitoring/latency_tracking_options.h"
+
+namespace codetest::matching_engine_sim {
+
+// Optional features of DefaultMatchingEngine, all disabled by default
+struct MatchingEngineOptions {
+  JournalOptions journal_{};
+  // Order books are restored from the snapshot files found here, before any journal replay
+  std::string snapshot_directory_{};
+  LatencyTrackingOptions latency_tracking_{};
+};
+
+} // end of namespace
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "interface/i_engine_event_observer.h"
+
+namespace codetest::matching_engine_sim {
+
+// Discards every engine event, used when rebuilding order books where clients have been notified already
+struct NullEngineEventObserver final : public IEngineEventObserver {
+
+  void doTradeEvent(
+      const ClientType &,
+      const OrderIDType &,
+      const ClientType &,
+      const OrderIDType &,
+      const InstrumentType &,
+      const PriceType &,
+      const SizeType &) override {}
+
+  void doOrderRequestResponse(
+      const ClientType &,
+      const OrderIDType &,
+      const InstrumentType &,
+      const PriceType &,
+      const SizeType &,
+      const OrderRequestResult &,
+      const ValidationResponse &) override {}
+
+  void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &) override {}
+};
+
+} // end of namespace
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+
+namespace codetest::matching_engine_sim {
+
+// Tracks a point-in-time snapshot being written by processors as they reach the barrier in each instrument queue
+class SnapshotBarrier final {
+ public:
+  SnapshotBarrier(const std::string &directory, const std::size_t &number_of_instruments);
+  SnapshotBarrier(const SnapshotBarrier &) = delete;
+  SnapshotBarrier &operator=(const SnapshotBarrier &) = delete;
+  ~SnapshotBarrier() = default;
+
+  [[nodiscard]] const std::string &getDirectory() const { return directory_; }
+  [[nodiscard]] bool isComplete() const;
+
+  // Blocks until every instrument book is written, rethrows the first failure in writing any of them
+  void wait() const;
+
+  void onInstrumentSaved();
+  void onInstrumentFailed(const std::exception_ptr &failure);
+
+ private:
+  const std::string directory_{};
+  std::size_t outstanding_instruments_{};
+  std::exception_ptr failure_{};
+  mutable std::mutex mutex_{};
+  mutable std::condition_variable completed_{};
+};
+
+} // end of namespace
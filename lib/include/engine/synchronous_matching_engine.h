@@ -0,0 +1,156 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "matching/passive_order_book.hpp"
+#include "matching/call_auction_matching.hpp"
+#include "persistence/book_snapshot.hpp"
+#include "engine/matching_engine.h"
+#include "interface/i_engine_event_observer.h"
+#include "interface/i_matching_engine.h"
+#include "events/client_order_request.h"
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Matching engine processing every request inline on the caller's thread, without queues, locks or threads.
+ * Each request has taken full effect, with all its events delivered to observer, by the time doOrderRequest
+ * returns, so single-threaded back-tests get deterministic output regardless of timing.
+ * Same matching algo and validators as DefaultMatchingEngine, not safe to be called from multiple threads.
+ * An instrument may be put into a call auction, its orders then accumulating without matching until uncrossed.
+ */
+template<typename OrderExt = void>
+class SynchronousMatchingEngine final : public IMatchingEngine<OrderExt> {
+ public:
+  using DefaultMatchingAlgo = typename DefaultMatchingEngine<OrderExt>::DefaultMatchingAlgo;
+  using DefaultAuctionAlgo = CallAuctionMatching<OrderExt,
+                                                 typename DefaultMatchingEngine<OrderExt>::NewValidators,
+                                                 typename DefaultMatchingEngine<OrderExt>::CancelValidators>;
+
+  SynchronousMatchingEngine(const std::set<InstrumentType> &instruments,
+                            const std::shared_ptr<IEngineEventObserver> &observer);
+  SynchronousMatchingEngine(const SynchronousMatchingEngine &) = delete;
+  SynchronousMatchingEngine &operator=(const SynchronousMatchingEngine &) = delete;
+  ~SynchronousMatchingEngine() override = default;
+
+  void doOrderRequest(const ClientOrderRequest<OrderExt> &client_order_request) override;
+
+  // Requests arriving afterwards are dropped, as DefaultMatchingEngine no longer processes them either
+  void terminate() override;
+
+  // Expires good till time orders of every instrument up to time. There is no processor thread advancing expiry
+  // by the system clock, back-tests drive it by their own clock.
+  void expireOrders(const std::uint64_t &time);
+
+  // Requests of instrument go to the auction algo from now on, resting without matching. Orders already in the book
+  // take part in the auction. No effect on an instrument not traded by the engine or already in an auction.
+  void startAuction(const InstrumentType &instrument);
+
+  // Trades the crossing orders of instrument at the equilibrium price and resumes continuous trading of it.
+  // Returns the equilibrium traded at, none if the book does not cross or instrument is not in an auction.
+  // Stop orders triggered by the auction trades enter with the next request of instrument.
+  std::optional<AuctionEquilibrium> uncross(const InstrumentType &instrument);
+
+  [[nodiscard]] bool isInAuction(const InstrumentType &instrument) const {
+    return auction_instruments_.count(instrument) > 0;
+  }
+
+  // Book of instrument for inspection between requests, nullptr for an instrument not traded by the engine
+  [[nodiscard]] const PassiveOrderBook<OrderExt> *getPassiveOrderBook(const InstrumentType &instrument) const;
+
+  // Writes one snapshot file per instrument into directory, in the same format as DefaultMatchingEngine
+  void saveSnapshot(const std::string &directory) const;
+
+ private:
+  DefaultMatchingAlgo matching_algo_{};
+  DefaultAuctionAlgo auction_algo_{};
+  std::shared_ptr<IEngineEventObserver> observer_{};
+  std::unordered_map<InstrumentType, PassiveOrderBook<OrderExt>> passive_order_books_{};
+  std::unordered_set<InstrumentType> auction_instruments_{};
+  bool in_operation_{true};
+};
+
+template<typename OrderExt>
+SynchronousMatchingEngine<OrderExt>::SynchronousMatchingEngine(
+    const std::set<InstrumentType> &instruments,
+    const std::shared_ptr<IEngineEventObserver> &observer)
+    : observer_(observer) {
+
+  if (!observer_) {
+    throw std::invalid_argument("observer cannot be null");
+  }
+
+  passive_order_books_.reserve(instruments.size());
+  for (const InstrumentType &inst : instruments) {
+    passive_order_books_.try_emplace(inst);
+  }
+}
+
+template<typename OrderExt>
+void SynchronousMatchingEngine<OrderExt>::doOrderRequest(const ClientOrderRequest<OrderExt> &client_order_request) {
+
+  // Control requests are engine internal only
+  if (!in_operation_ || isControlAction(client_order_request.order_action_)) return;
+
+  if (auto itr = passive_order_books_.find(client_order_request.instrument_); itr != passive_order_books_.end()) {
+    // Matching algo works on the request in place, e.g. market order price
+    auto client_order_request_clone = client_order_request;
+    if (isInAuction(client_order_request.instrument_)) {
+      auction_algo_.doProcessOrderRequest(client_order_request_clone, itr->second, *observer_);
+    } else {
+      matching_algo_.doProcessOrderRequest(client_order_request_clone, itr->second, *observer_);
+    }
+  }
+
+}
+
+template<typename OrderExt>
+void SynchronousMatchingEngine<OrderExt>::expireOrders(const std::uint64_t &time) {
+  if (!in_operation_) return;
+
+  for (auto &[instrument, passive_order_book] : passive_order_books_) {
+    matching_algo_.doExpireOrders(passive_order_book, instrument, time, *observer_);
+  }
+}
+
+template<typename OrderExt>
+void SynchronousMatchingEngine<OrderExt>::startAuction(const InstrumentType &instrument) {
+  if (!in_operation_ || passive_order_books_.count(instrument) == 0) return;
+
+  auction_instruments_.insert(instrument);
+}
+
+template<typename OrderExt>
+std::optional<AuctionEquilibrium> SynchronousMatchingEngine<OrderExt>::uncross(const InstrumentType &instrument) {
+  if (!in_operation_ || auction_instruments_.erase(instrument) == 0) return std::nullopt;
+
+  return auction_algo_.uncross(passive_order_books_.at(instrument), instrument, *observer_);
+}
+
+template<typename OrderExt>
+void SynchronousMatchingEngine<OrderExt>::terminate() {
+  in_operation_ = false;
+}
+
+template<typename OrderExt>
+const PassiveOrderBook<OrderExt> *SynchronousMatchingEngine<OrderExt>::getPassiveOrderBook(
+    const InstrumentType &instrument) const {
+  const auto itr = passive_order_books_.find(instrument);
+  return itr == passive_order_books_.end() ? nullptr : &itr->second;
+}
+
+template<typename OrderExt>
+void SynchronousMatchingEngine<OrderExt>::saveSnapshot(const std::string &directory) const {
+  std::filesystem::create_directories(directory);
+  for (const auto &[instrument, passive_order_book] : passive_order_books_) {
+    const auto path = std::filesystem::path(directory) / bookSnapshotFileName(instrument);
+    saveBookSnapshot(path.string(), passive_order_book, instrument);
+  }
+}
+
+} // end of namespace
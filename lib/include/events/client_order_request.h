@@ -44,12 +44,20 @@ struct alignas(64) ClientOrderRequest final {
   OrderSide side_{};
   OrderAction order_action_{};
   OrderType order_type_{};
+  TimeInForce time_in_force_{TimeInForce::GTC};
 
   OrderIDType cln_order_id_{};
   SizeType size_{};
   PriceType price_{};
   ClientType client_{};
   InstrumentType instrument_{};
+  // Good till time orders only, in nanoseconds of the clock expiry is advanced by: system clock since epoch in
+  // matching engine, order flow time stamps in replay
+  std::uint64_t expire_time_{};
+  // Stop and stop limit orders only, trades at or beyond it trigger the order
+  PriceType trigger_price_{};
+  // Iceberg orders only, size shown in the book at a time while resting, the rest being held in reserve
+  SizeType display_size_{};
   std::shared_ptr<OrderExt> custom_fields_{nullptr};
 };
 
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+
+#include "types.h"
+
 namespace codetest::matching_engine_sim {
 
 template<typename OrderExt>
@@ -21,6 +25,13 @@ struct IMatchingAlgo {
       ClientOrderRequest<OrderExt> &order_request,
       PassiveOrderBook<OrderExt> &passive_order_book,
       IEngineEventObserver &observer) = 0;
+
+  // Takes good till time orders expiring at or before time out of the book, time never going backwards
+  virtual void doExpireOrders(
+      PassiveOrderBook<OrderExt> &passive_order_book,
+      const InstrumentType &instrument,
+      const std::uint64_t &time,
+      IEngineEventObserver &observer) = 0;
 };
 
 } // end of namespace
\ No newline at end of file
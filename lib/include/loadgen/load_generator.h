@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types.h"
+#include "interface/i_engine_event_observer.h"
+#include "interface/i_matching_engine.h"
+#include "loadgen/order_flow_generator.h"
+
+namespace codetest::matching_engine_sim {
+
+struct LoadRunOptions {
+  // Producer threads, each generating its own flow over its own clients
+  std::size_t producers_{1};
+  // Requests per second over all producers, paced by the arrival process; 0 sends as fast as possible
+  double target_rate_{100000};
+  std::uint64_t requests_per_producer_{100000};
+  // How long to wait for the engine to respond to every new order once all requests are sent
+  std::chrono::milliseconds drain_timeout_{std::chrono::seconds(30)};
+};
+
+struct LoadRunReport {
+  std::uint64_t requests_{};
+  std::uint64_t new_orders_{};
+  std::uint64_t responded_new_orders_{};
+  // From first submission to last submission, and to the last new order responded
+  std::chrono::nanoseconds send_time_{};
+  std::chrono::nanoseconds elapsed_{};
+
+  // Submission to first response of new orders, nanoseconds
+  double latency_mean_{};
+  double latency_p50_{};
+  double latency_p90_{};
+  double latency_p99_{};
+  double latency_p999_{};
+  double latency_max_{};
+
+  [[nodiscard]] double sendRate() const;
+  [[nodiscard]] double throughput() const;
+};
+
+/*
+ * Drives a matching engine with synthetic flow from several producer threads. Every producer runs its own
+ * OrderFlowGenerator, seeded apart and over disjoint clients and order ids, pacing submissions to the arrival times
+ * of its flow (open loop, a late producer catches up rather than slowing down the schedule).
+ *
+ * The engine has to be created with getObserver(), which time stamps the first response of every new order.
+ * Each order owns a slot, written once by the processor thread of its instrument, so no locks are involved.
+ */
+class LoadGenerator final {
+ public:
+  LoadGenerator(const OrderFlowGeneratorConfig &flow_config,
+                const LoadRunOptions &run_options,
+                const std::shared_ptr<IEngineEventObserver> &downstream_observer = nullptr);
+  LoadGenerator(const LoadGenerator &) = delete;
+  LoadGenerator &operator=(const LoadGenerator &) = delete;
+  ~LoadGenerator() = default;
+
+  [[nodiscard]] std::shared_ptr<IEngineEventObserver> getObserver() const { return observer_; }
+
+  // Blocks until every request is sent and every new order responded to, or drain timeout, once per generator
+  LoadRunReport run(IMatchingEngine<void> &matching_engine);
+
+  // Config of the flow of producer at index
+  [[nodiscard]] OrderFlowGeneratorConfig getProducerFlowConfig(const std::size_t &producer) const;
+
+ private:
+  struct ProducerSlots {
+    explicit ProducerSlots(const std::uint64_t &requests)
+        : submitted_(requests), responded_(std::make_unique<std::atomic<std::uint64_t>[]>(requests)) {}
+
+    // Written by the producer thread before submission
+    std::vector<std::uint64_t> submitted_;
+    // Written by the processor thread of the order's instrument on first response
+    std::unique_ptr<std::atomic<std::uint64_t>[]> responded_;
+    std::uint64_t requests_{};
+    std::uint64_t new_orders_{};
+    std::uint64_t first_submission_{};
+    std::uint64_t last_submission_{};
+  };
+
+  class ResponseTimingObserver;
+
+  void produce(const std::size_t &producer, IMatchingEngine<void> &matching_engine, const std::uint64_t &start);
+
+  const OrderFlowGeneratorConfig flow_config_{};
+  const LoadRunOptions run_options_{};
+  std::vector<ProducerSlots> producer_slots_{};
+  std::atomic<std::uint64_t> responded_new_orders_{};
+  std::shared_ptr<IEngineEventObserver> observer_{};
+  bool has_run_{false};
+};
+
+} // end of namespace
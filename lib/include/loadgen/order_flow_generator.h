@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "events/client_order_request.h"
+
+namespace codetest::matching_engine_sim {
+
+enum class ArrivalProcess : std::uint8_t {
+  POISSON = 0,
+  // Self exciting, every arrival raises the intensity for a while, giving bursts like real order flow
+  HAWKES = 1
+};
+
+struct OrderFlowGeneratorConfig {
+  ArrivalProcess arrival_process_{ArrivalProcess::POISSON};
+  // Mean arrivals per second, whatever the arrival process
+  double rate_{100000};
+  // HAWKES only, intensity jump per arrival and its decay rate per second, alpha / beta must be below 1
+  double hawkes_alpha_{0};
+  double hawkes_beta_{1};
+
+  InstrumentType first_instrument_{0};
+  InstrumentType instruments_{1};
+  // Popularity of the k-th instrument is proportional to 1 / k^s, 0 is uniform
+  double zipf_exponent_{0};
+
+  ClientType first_client_{0};
+  ClientType clients_{10};
+  OrderIDType first_order_id_{0};
+
+  PriceType initial_mid_{10000};
+  // Chance of the mid moving a tick up or down on every arrival for its instrument
+  double mid_move_probability_{0.1};
+  // Mean distance in ticks of a limit price from mid, away from it for passive orders, through it for aggressive ones
+  double price_offset_mean_{5};
+  double aggressive_ratio_{0.1};
+  double market_order_ratio_{0.02};
+  // Chance of an arrival cancelling an order generated earlier rather than entering a new one
+  double cancel_ratio_{0.3};
+  // Orders remembered per instrument as cancel candidates, beyond it a random one is forgotten for a new one
+  std::size_t max_live_orders_{4096};
+
+  SizeType min_size_{1};
+  SizeType max_size_{100};
+  std::uint64_t seed_{42};
+};
+
+struct GeneratedOrderRequest {
+  // Nanoseconds since start of the flow
+  std::uint64_t timestamp_{};
+  ClientOrderRequest<> order_request_{};
+};
+
+/*
+ * Synthetic order, cancel and market order flow. Arrivals follow a Poisson or Hawkes process, each picks an
+ * instrument by Zipf popularity and prices around that instrument's mid, which moves as a random walk.
+ * Cancels target orders generated earlier which may have traded in the meantime, as happens in real flow.
+ * Same config, same flow.
+ */
+class OrderFlowGenerator final {
+ public:
+  explicit OrderFlowGenerator(const OrderFlowGeneratorConfig &config);
+  OrderFlowGenerator(const OrderFlowGenerator &) = delete;
+  OrderFlowGenerator &operator=(const OrderFlowGenerator &) = delete;
+  ~OrderFlowGenerator() = default;
+
+  GeneratedOrderRequest next();
+
+ private:
+  struct LiveOrder {
+    ClientType client_{};
+    OrderIDType cln_order_id_{};
+    OrderSide side_{};
+    PriceType price_{};
+  };
+
+  [[nodiscard]] double nextArrivalTime();
+  [[nodiscard]] PriceType nextMid(const std::size_t &instrument_index);
+
+  const OrderFlowGeneratorConfig config_{};
+  std::mt19937_64 random_engine_{};
+  std::uniform_real_distribution<double> unit_distribution_{0.0, 1.0};
+  std::discrete_distribution<std::size_t> instrument_distribution_{};
+  std::uniform_int_distribution<ClientType> client_distribution_{};
+  std::uniform_int_distribution<SizeType> size_distribution_{};
+  std::geometric_distribution<PriceType> price_offset_distribution_{};
+
+  // Seconds
+  double time_{};
+  double baseline_intensity_{};
+  double excitation_{};
+
+  OrderIDType next_order_id_{};
+  std::vector<PriceType> mids_{};
+  std::vector<std::vector<LiveOrder>> live_orders_{};
+};
+
+// Writes count generated requests into an order flow file, for replay and back-testing
+void writeGeneratedOrderFlow(const OrderFlowGeneratorConfig &config, const std::uint64_t &count,
+                             const std::string &path);
+
+} // end of namespace
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <optional>
+
+#include "types.h"
+#include "matching/passive_order.h"
+#include "matching/passive_order_book.hpp"
+#include "matching/matching_algo.hpp"
+#include "matching/validators/validators.hpp"
+#include "interface/i_engine_event_observer.h"
+#include "interface/i_matching_algo.h"
+
+namespace codetest::matching_engine_sim {
+
+// Price an auction uncrosses at, the volume it trades and the size left unmatched on the side in surplus
+struct AuctionEquilibrium {
+  PriceType price_{};
+  SizeType volume_{};
+  SizeType imbalance_{};
+};
+
+// Opening or closing call auction. Orders accumulate into the book without ever matching, until uncross trades
+// every order crossing at the one equilibrium price, in price then time priority of either side.
+// Only limit orders resting till cancelled or till time are accepted, icebergs included. Pegged orders already in
+// the book sit out, their peg queues being left to continuous trading.
+template<
+    typename OrderExt = NoOrderExt,
+    typename NewValidators = NoValidator,
+    typename CancelValidators = NoValidator>
+class CallAuctionMatching : public IMatchingAlgo<OrderExt> {
+ public:
+  CallAuctionMatching();
+  CallAuctionMatching(const CallAuctionMatching &) = default;
+  CallAuctionMatching(CallAuctionMatching &&) noexcept = default;
+  virtual CallAuctionMatching &operator=(const CallAuctionMatching &) = default;
+  virtual CallAuctionMatching &operator=(CallAuctionMatching &&) noexcept = default;
+  virtual ~CallAuctionMatching() = default;
+
+  void doProcessOrderRequest(
+      ClientOrderRequest<OrderExt> &order_request,
+      PassiveOrderBook<OrderExt> &passive_order_book,
+      IEngineEventObserver &observer) override;
+
+  void doExpireOrders(
+      PassiveOrderBook<OrderExt> &passive_order_book,
+      const InstrumentType &instrument,
+      const std::uint64_t &time,
+      IEngineEventObserver &observer) override;
+
+  // Price maximising the volume traded, then minimising the imbalance, then closest to the last trade price, then
+  // the lowest. None if the book does not cross. Sized up from aggregate sizes of the crossing levels only.
+  [[nodiscard]] std::optional<AuctionEquilibrium> findEquilibrium(const PassiveOrderBook<OrderExt> &passive_order_book);
+
+  // Trades the crossing orders at the equilibrium price, leaving the book uncrossed. Sell orders are reported as
+  // client 1 of trade events, there being no aggressor in an auction. Returns the equilibrium traded at, if any.
+  std::optional<AuctionEquilibrium> uncross(PassiveOrderBook<OrderExt> &passive_order_book,
+                                            const InstrumentType &instrument,
+                                            IEngineEventObserver &observer);
+
+ private:
+  using RequestHandler = void (CallAuctionMatching::*)(ClientOrderRequest<OrderExt> &order_request,
+                                                       PassiveOrderBook<OrderExt> &passive_order_book,
+                                                       IEngineEventObserver &observer);
+
+  void doProcessNewOrderRequest(ClientOrderRequest<OrderExt> &order_request,
+                                PassiveOrderBook<OrderExt> &passive_order_book,
+                                IEngineEventObserver &observer);
+
+  void doProcessCancelOrderRequest(ClientOrderRequest<OrderExt> &order_request,
+                                   PassiveOrderBook<OrderExt> &passive_order_book,
+                                   IEngineEventObserver &observer);
+
+  void doProcessAmendOrderRequest(ClientOrderRequest<OrderExt> &order_request,
+                                  PassiveOrderBook<OrderExt> &passive_order_book,
+                                  IEngineEventObserver &observer);
+
+  void doProcessMassCancelOrderRequest(ClientOrderRequest<OrderExt> &order_request,
+                                       PassiveOrderBook<OrderExt> &passive_order_book,
+                                       IEngineEventObserver &observer);
+
+  void placeOrder(const ClientOrderRequest<OrderExt> &order_request, PassiveOrderBook<OrderExt> &passive_order_book);
+
+  // Matches sell_request against bid levels at or above price, trading at price
+  void matchBidLevels(ClientOrderRequest<OrderExt> &sell_request,
+                      const PriceType &price,
+                      PassiveOrderBook<OrderExt> &passive_order_book,
+                      const InstrumentType &instrument,
+                      IEngineEventObserver &observer);
+
+  std::array<RequestHandler, static_cast<std::size_t>(OrderAction::_ACTION_SIZE_)> request_handlers_;
+
+  const NewValidators new_validators_{};
+  const CancelValidators cancel_validators_{};
+  const Validators<OrderExt> amend_validators_{};
+  // Orders crossing at the equilibrium price all trade, none is skipped
+  const Validators<OrderExt> match_validators_{};
+
+  // Crossing levels of both sides merged by ascending price, with the size each side has at the price.
+  // Kept across auctions so sizing up stays off the heap.
+  std::vector<PriceType> auction_prices_{};
+  std::vector<SizeType> bid_sizes_{};
+  std::vector<SizeType> ask_sizes_{};
+};
+
+template<typename OrderExt, typename N, typename C>
+CallAuctionMatching<OrderExt, N, C>::CallAuctionMatching() {
+  request_handlers_[static_cast<std::size_t>(OrderAction::NEW)] =
+      &CallAuctionMatching::doProcessNewOrderRequest;
+  request_handlers_[static_cast<std::size_t>(OrderAction::CANCEL)] =
+      &CallAuctionMatching::doProcessCancelOrderRequest;
+  request_handlers_[static_cast<std::size_t>(OrderAction::AMEND)] =
+      &CallAuctionMatching::doProcessAmendOrderRequest;
+  request_handlers_[static_cast<std::size_t>(OrderAction::MASS_CANCEL)] =
+      &CallAuctionMatching::doProcessMassCancelOrderRequest;
+  request_handlers_[static_cast<std::size_t>(OrderAction::MASS_CANCEL_SIDE)] =
+      &CallAuctionMatching::doProcessMassCancelOrderRequest;
+}
+
+template<typename OrderExt, typename N, typename C>
+void CallAuctionMatching<OrderExt, N, C>::doProcessOrderRequest(
+    ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
+
+  const auto &request_handler = request_handlers_[static_cast<std::size_t>(order_request.order_action_)];
+  (this->*request_handler)(order_request, passive_order_book, observer);
+
+}
+
+template<typename OrderExt, typename N, typename C>
+void CallAuctionMatching<OrderExt, N, C>::doExpireOrders(
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    const InstrumentType &instrument,
+    const std::uint64_t &time,
+    IEngineEventObserver &observer) {
+
+  expirePassiveOrders(passive_order_book, instrument, time, observer);
+
+}
+
+template<typename OrderExt, typename N, typename C>
+std::optional<AuctionEquilibrium> CallAuctionMatching<OrderExt, N, C>::findEquilibrium(
+    const PassiveOrderBook<OrderExt> &passive_order_book) {
+
+  const auto best_bid = passive_order_book.getBestPrice(OrderSide::BUY);
+  const auto best_ask = passive_order_book.getBestPrice(OrderSide::SELL);
+  if (!best_bid || !best_ask || *best_bid < *best_ask) return std::nullopt;
+
+  // Only prices between the best ask and the best bid can trade, levels beyond either do not cross
+  auction_prices_.clear();
+  bid_sizes_.clear();
+  ask_sizes_.clear();
+
+  const auto &bid_order_queues = passive_order_book.getBidOrderQueue();
+  const auto &ask_order_queues = passive_order_book.getAskOrderQueue();
+  auto bid_itr = std::make_reverse_iterator(bid_order_queues.upper_bound(*best_ask));
+  const auto bid_end = bid_order_queues.rend();
+  auto ask_itr = ask_order_queues.begin();
+  const auto ask_end = ask_order_queues.upper_bound(*best_bid);
+
+  while (bid_itr != bid_end || ask_itr != ask_end) {
+    const bool take_bid = bid_itr != bid_end && (ask_itr == ask_end || bid_itr->first <= ask_itr->first);
+    const bool take_ask = ask_itr != ask_end && (bid_itr == bid_end || ask_itr->first <= bid_itr->first);
+    const auto price = take_bid ? bid_itr->first : ask_itr->first;
+    const SizeType bid_size = take_bid ? (bid_itr++)->second.total_size_ : 0;
+    const SizeType ask_size = take_ask ? (ask_itr++)->second.total_size_ : 0;
+    if (bid_size == 0 && ask_size == 0) continue;
+
+    auction_prices_.push_back(price);
+    bid_sizes_.push_back(bid_size);
+    ask_sizes_.push_back(ask_size);
+  }
+
+  const auto levels = auction_prices_.size();
+
+  // Cumulative sizes in place: bids wanting to buy at or above each price, asks wanting to sell at or below it
+  for (std::size_t index = levels; index-- > 1;) bid_sizes_[index - 1] += bid_sizes_[index];
+  for (std::size_t index = 1; index < levels; index++) ask_sizes_[index] += ask_sizes_[index - 1];
+
+  std::optional<AuctionEquilibrium> equilibrium{};
+  const auto reference_price = passive_order_book.getLastTradePrice();
+  PriceType equilibrium_distance{};
+
+  for (std::size_t index = 0; index < levels; index++) {
+    const auto demand = bid_sizes_[index];
+    const auto supply = ask_sizes_[index];
+    const AuctionEquilibrium candidate{auction_prices_[index],
+                                       std::min(demand, supply),
+                                       demand > supply ? demand - supply : supply - demand};
+    const PriceType distance = reference_price == 0 ? 0
+                               : candidate.price_ > reference_price ? candidate.price_ - reference_price
+                                                                    : reference_price - candidate.price_;
+
+    // Scanning by ascending price, a tie in every respect keeps the lower price
+    const bool better = !equilibrium
+        || candidate.volume_ > equilibrium->volume_
+        || (candidate.volume_ == equilibrium->volume_
+            && (candidate.imbalance_ < equilibrium->imbalance_
+                || (candidate.imbalance_ == equilibrium->imbalance_ && distance < equilibrium_distance)));
+    if (better) {
+      equilibrium = candidate;
+      equilibrium_distance = distance;
+    }
+  }
+
+  if (!equilibrium || equilibrium->volume_ == 0) return std::nullopt;
+  return equilibrium;
+
+}
+
+template<typename OrderExt, typename N, typename C>
+std::optional<AuctionEquilibrium> CallAuctionMatching<OrderExt, N, C>::uncross(
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    const InstrumentType &instrument,
+    IEngineEventObserver &observer) {
+
+  const auto equilibrium = findEquilibrium(passive_order_book);
+  if (!equilibrium) return std::nullopt;
+
+  const auto &price = equilibrium->price_;
+  SizeType volume = equilibrium->volume_;
+  auto &ask_order_queues = passive_order_book.getAskOrderQueue();
+
+  // Sell orders in priority order each trade with bids in priority order, until the equilibrium volume is traded
+  for (auto ask_itr = ask_order_queues.begin();
+       volume > 0 && ask_itr != ask_order_queues.end() && ask_itr->first <= price;) {
+    auto &ask_queue = ask_itr->second;
+
+    for (std::size_t index = 0; index < ask_queue.size() && volume > 0;) {
+      PassiveOrder<OrderExt> &sell_order = *ask_queue[index];
+      if (sell_order.remaining_size_ == 0) {
+        // Ignore and remove cancelled order in the queue
+        ask_queue.erase(ask_queue.begin() + index);
+        continue;
+      }
+
+      ClientOrderRequest<OrderExt> sell_request{OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT,
+                                                sell_order.cln_order_id_,
+                                                std::min(sell_order.remaining_size_, volume),
+                                                price, sell_order.client_, instrument};
+      const SizeType sell_size = sell_request.size_;
+      matchBidLevels(sell_request, price, passive_order_book, instrument, observer);
+      const SizeType traded_size = sell_size - sell_request.size_;
+      // Equilibrium volume is always there to trade, this only guards against looping on a book gone wrong
+      if (traded_size == 0) return equilibrium;
+      volume -= traded_size;
+
+      passive_order_book.fillPassiveOrder(ask_queue, sell_order, traded_size);
+      if (sell_order.getOpenSize() == 0) {
+        ask_queue.erase(ask_queue.begin() + index);
+      } else if (sell_order.remaining_size_ == 0) {
+        // Iceberg shows its next slice at the back of its level, as when matched in continuous trading
+        passive_order_book.replenishPassiveOrder(sell_order);
+        auto passive_order_ptr = std::move(ask_queue[index]);
+        ask_queue.erase(ask_queue.begin() + index);
+        ask_queue.push_back(std::move(passive_order_ptr));
+      } else {
+        index++;
+      }
+    }
+
+    if (ask_queue.empty()) {
+      ask_itr = passive_order_book.erasePriceLevel(ask_order_queues, ask_itr);
+    } else {
+      ask_itr++;
+    }
+  }
+
+  return equilibrium;
+
+}
+
+template<typename OrderExt, typename N, typename C>
+void CallAuctionMatching<OrderExt, N, C>::matchBidLevels(
+    ClientOrderRequest<OrderExt> &sell_request,
+    const PriceType &price,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    const InstrumentType &instrument,
+    IEngineEventObserver &observer) {
+
+  auto &bid_order_queues = passive_order_book.getBidOrderQueue();
+  ValidationResponse current_validation{ValidationResponse::NO_ERROR};
+
+  for (auto bid_itr = bid_order_queues.begin();
+       sell_request.size_ > 0 && bid_itr != bid_order_queues.end() && bid_itr->first >= price;) {
+    auto &bid_queue = bid_itr->second;
+    matchOrderQueue(sell_request, bid_queue, price, passive_order_book, instrument, observer, match_validators_,
+                    current_validation);
+
+    if (bid_queue.empty()) {
+      bid_itr = passive_order_book.erasePriceLevel(bid_order_queues, bid_itr);
+    } else {
+      bid_itr++;
+    }
+  }
+
+}
+
+template<typename OrderExt, typename N, typename C>
+void CallAuctionMatching<OrderExt, N, C>::doProcessNewOrderRequest(
+    ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
+
+  auto validation_response = new_validators_.validate(order_request, passive_order_book);
+
+  // An order only takes part in an auction by resting in the book at a price of its own
+  const bool resting = order_request.time_in_force_ == TimeInForce::GTC
+      || order_request.time_in_force_ == TimeInForce::GTT;
+  if (validation_response == ValidationResponse::NO_ERROR
+      && (order_request.order_type_ != OrderType::LIMIT || !resting)) {
+    validation_response = ValidationResponse::INVALID_ORDER_REQUEST;
+  }
+
+  auto request_result = (validation_response == ValidationResponse::NO_ERROR)
+                        ? OrderRequestResult::ACK
+                        : OrderRequestResult::NACK;
+
+  observer.doOrderRequestResponse(
+      order_request.client_,
+      order_request.cln_order_id_,
+      order_request.instrument_,
+      order_request.price_,
+      order_request.size_,
+      request_result,
+      validation_response);
+
+  if (validation_response == ValidationResponse::NO_ERROR) {
+    placeOrder(order_request, passive_order_book);
+  }
+
+}
+
+template<typename OrderExt, typename N, typename C>
+void CallAuctionMatching<OrderExt, N, C>::placeOrder(
+    const ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book) {
+
+  passive_order_book.placePassiveOrder(order_request.client_,
+                                       order_request.cln_order_id_,
+                                       order_request.order_type_,
+                                       order_request.side_,
+                                       order_request.price_,
+                                       order_request.size_,
+                                       order_request.custom_fields_,
+                                       order_request.time_in_force_ == TimeInForce::GTT
+                                       ? order_request.expire_time_ : 0,
+                                       order_request.display_size_);
+
+}
+
+template<typename OrderExt, typename N, typename C>
+void CallAuctionMatching<OrderExt, N, C>::doProcessCancelOrderRequest(
+    ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
+
+  cancelOrder(order_request, passive_order_book, observer, cancel_validators_);
+
+}
+
+template<typename OrderExt, typename N, typename C>
+void CallAuctionMatching<OrderExt, N, C>::doProcessMassCancelOrderRequest(
+    ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
+
+  massCancelOrders(order_request, passive_order_book, observer);
+
+}
+
+template<typename OrderExt, typename N, typename C>
+void CallAuctionMatching<OrderExt, N, C>::doProcessAmendOrderRequest(
+    ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
+
+  // An order losing its priority is entered anew still without matching
+  if (amendOrder(order_request, passive_order_book, observer, amend_validators_, new_validators_)) {
+    placeOrder(order_request, passive_order_book);
+  }
+
+}
+
+} // end of namespace
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Recycles blocks of a single size, the size of the first block requested. Freed blocks are kept on an intrusive free
+ * list and handed out again, memory is only taken from the heap chunk-wise when the free list runs dry, so once a book
+ * has seen its peak order count placing orders no longer reaches the heap.
+ *
+ * Blocks may be released from any thread since orders can outlive their book in a shared_ptr, hence the lock; it is
+ * uncontended in the engine where the processor thread of the book is the only one placing and releasing orders.
+ */
+class FixedBlockPool final {
+ public:
+  explicit FixedBlockPool(const std::size_t &blocks_per_chunk = DEFAULT_BLOCKS_PER_CHUNK);
+  FixedBlockPool(const FixedBlockPool &) = delete;
+  FixedBlockPool &operator=(const FixedBlockPool &) = delete;
+  ~FixedBlockPool() = default;
+
+  // nullptr when size or alignment does not fit the blocks of this pool, the caller allocates elsewhere then
+  [[nodiscard]] void *allocate(const std::size_t &size, const std::size_t &alignment);
+  void deallocate(void *block) noexcept;
+
+  // Whether a block of size and alignment comes from this pool
+  [[nodiscard]] bool fits(const std::size_t &size, const std::size_t &alignment) const noexcept {
+    return size <= block_size_ && alignment <= alignof(std::max_align_t);
+  }
+
+  [[nodiscard]] std::size_t getCapacity() const;
+
+  static constexpr std::size_t DEFAULT_BLOCKS_PER_CHUNK = 256;
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next_;
+  };
+
+  void addChunk();
+
+  const std::size_t blocks_per_chunk_;
+  // Fixed by the first allocation
+  std::size_t block_size_{0};
+  FreeBlock *free_list_{nullptr};
+  std::vector<std::unique_ptr<std::byte[]>> chunks_{};
+  mutable std::mutex mutex_{};
+};
+
+/*
+ * Allocator drawing single objects from a FixedBlockPool, for std::allocate_shared which rebinds it to its control
+ * block. Every copy keeps the pool alive, so does every object allocated from it.
+ */
+template<typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  explicit PoolAllocator(std::shared_ptr<FixedBlockPool> pool) noexcept : pool_(std::move(pool)) {}
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U> &other) noexcept : pool_(other.pool_) {}
+
+  [[nodiscard]] T *allocate(const std::size_t &count) {
+    if (count == 1) {
+      if (void *block = pool_->allocate(sizeof(T), alignof(T))) return static_cast<T *>(block);
+    }
+    return std::allocator<T>{}.allocate(count);
+  }
+
+  void deallocate(T *ptr, const std::size_t &count) noexcept {
+    if (count == 1 && pool_->fits(sizeof(T), alignof(T))) {
+      pool_->deallocate(ptr);
+    } else {
+      std::allocator<T>{}.deallocate(ptr, count);
+    }
+  }
+
+  template<typename U>
+  bool operator==(const PoolAllocator<U> &other) const noexcept { return pool_ == other.pool_; }
+  template<typename U>
+  bool operator!=(const PoolAllocator<U> &other) const noexcept { return pool_ != other.pool_; }
+
+ private:
+  template<typename U> friend
+  class PoolAllocator;
+
+  std::shared_ptr<FixedBlockPool> pool_;
+};
+
+} // end of namespace
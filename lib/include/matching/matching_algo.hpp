@@ -1,10 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <limits>
 #include <type_traits>
 #include <functional>
+#include <optional>
 
 #include "types.h"
 #include "matching/passive_order.h"
@@ -21,11 +23,16 @@ class IEngineEventObserver;
 using NoOrderExt = void;
 using NoValidator = Validators<NoOrderExt>;
 
+// Matches orders of a price level one after another in time priority, the default allocation of a level
+struct TimePriorityAllocation;
+
 template<
     typename OrderExt = NoOrderExt,
     typename MatchValidators = NoValidator,
     typename NewValidators = NoValidator,
-    typename CancelValidators = NoValidator>
+    typename CancelValidators = NoValidator,
+    typename AmendValidators = Validators<OrderExt>,
+    typename LevelAllocation = TimePriorityAllocation>
 class PriceTimePriorityMatching : public IMatchingAlgo<OrderExt> {
  public:
   PriceTimePriorityMatching();
@@ -40,6 +47,12 @@ class PriceTimePriorityMatching : public IMatchingAlgo<OrderExt> {
       PassiveOrderBook<OrderExt> &passive_order_book,
       IEngineEventObserver &observer) override;
 
+  void doExpireOrders(
+      PassiveOrderBook<OrderExt> &passive_order_book,
+      const InstrumentType &instrument,
+      const std::uint64_t &time,
+      IEngineEventObserver &observer) override;
+
  private:
   using RequestHandler = void (PriceTimePriorityMatching::*)(ClientOrderRequest<OrderExt> &order_request,
                                                              PassiveOrderBook<OrderExt> &passive_order_book,
@@ -53,21 +66,134 @@ class PriceTimePriorityMatching : public IMatchingAlgo<OrderExt> {
                                    PassiveOrderBook<OrderExt> &passive_order_book,
                                    IEngineEventObserver &observer);
 
+  void doProcessAmendOrderRequest(ClientOrderRequest<OrderExt> &order_request,
+                                  PassiveOrderBook<OrderExt> &passive_order_book,
+                                  IEngineEventObserver &observer);
+
+  void doProcessMassCancelOrderRequest(ClientOrderRequest<OrderExt> &order_request,
+                                       PassiveOrderBook<OrderExt> &passive_order_book,
+                                       IEngineEventObserver &observer);
+
+  // Enters stop orders triggered by trades of the request just processed, and in turn by their own trades
+  void enterTriggeredOrders(PassiveOrderBook<OrderExt> &passive_order_book, IEngineEventObserver &observer);
+
+  // Matches an accepted order against the opposite side, placing what is left of it into the book
+  void matchAndPlaceOrder(ClientOrderRequest<OrderExt> &order_request,
+                          PassiveOrderBook<OrderExt> &passive_order_book,
+                          IEngineEventObserver &observer);
+
   std::array<RequestHandler, static_cast<std::size_t>(OrderAction::_ACTION_SIZE_)> request_handlers_;
 
   const MatchValidators match_validators_{};
   const NewValidators new_validators_{};
   const CancelValidators cancel_validators_{};
+  const AmendValidators amend_validators_{};
+  const LevelAllocation level_allocation_{};
 };
 
 namespace {
-template<typename OrderExt, typename MatchValidators, typename MatchOrderPriceQueues>
+
+[[nodiscard]] inline bool isMatchingStopped(const ValidationResponse &validation_response) {
+  return validation_response != ValidationResponse::NO_ERROR
+      && validation_response != ValidationResponse::CONTINUE_WITHOUT_MATCHING;
+}
+
+// Matches order_request against order_queue in time priority at price, until either is done or matching is stopped
+template<typename OrderExt, typename MatchValidators, typename OrderContainer>
+void matchOrderQueue(ClientOrderRequest<OrderExt> &order_request,
+                     OrderContainer &order_queue,
+                     const PriceType &price,
+                     PassiveOrderBook<OrderExt> &passive_order_book,
+                     const InstrumentType &instrument,
+                     IEngineEventObserver &observer,
+                     const MatchValidators &match_validators,
+                     ValidationResponse &current_validation) {
+
+  // Iterating order queue per each price
+  for (auto itr = order_queue.begin(); itr != order_queue.end() && order_request.size_ > 0;) {
+
+    auto &current_passive_order_ptr = *itr;
+    PassiveOrder<OrderExt> &current_passive_order = *current_passive_order_ptr;
+
+    if (current_passive_order.remaining_size_ == 0) {
+      // Ignore and remove cancelled order in the queue
+      itr = order_queue.erase(itr);
+      continue;
+    }
+
+    current_validation = match_validators.validate(order_request, passive_order_book, current_passive_order);
+
+    if (current_validation == ValidationResponse::CONTINUE_WITHOUT_MATCHING) {
+      itr++;
+      continue;
+    } else if (current_validation != ValidationResponse::NO_ERROR) {
+      return;
+    }
+
+    const SizeType trade_size = std::min(order_request.size_, current_passive_order.remaining_size_);
+    passive_order_book.fillPassiveOrder(order_queue, current_passive_order, trade_size);
+    const bool passive_order_filled = current_passive_order.getOpenSize() == 0;
+
+    observer.doTradeEvent(
+        order_request.client_,
+        order_request.cln_order_id_,
+        current_passive_order.client_,
+        current_passive_order.cln_order_id_,
+        instrument,
+        price,
+        trade_size
+    );
+
+    order_request.size_ -= trade_size;
+    passive_order_book.recordTrade(price);
+
+    // The queue may hold the last reference to the passive order, so it goes only once done with the order
+    if (passive_order_filled) {
+      itr = order_queue.erase(itr);
+    } else if (current_passive_order.remaining_size_ == 0) {
+      // Iceberg shows its next slice from reserve at the back of the queue, within reach of this same order
+      passive_order_book.replenishPassiveOrder(current_passive_order);
+      const auto index = itr - order_queue.begin();
+      auto passive_order_ptr = std::move(current_passive_order_ptr);
+      order_queue.erase(itr);
+      order_queue.push_back(std::move(passive_order_ptr));
+      itr = order_queue.begin() + index;
+    } else {
+      itr++;
+    }
+  }
+
+}
+
+} // end of anonymous local namespace
+
+struct TimePriorityAllocation final {
+  template<typename OrderExt, typename MatchValidators, typename OrderContainer>
+  void operator()(ClientOrderRequest<OrderExt> &order_request,
+                  OrderContainer &order_queue,
+                  const PriceType &price,
+                  PassiveOrderBook<OrderExt> &passive_order_book,
+                  const InstrumentType &instrument,
+                  IEngineEventObserver &observer,
+                  const MatchValidators &match_validators,
+                  ValidationResponse &current_validation) const {
+    matchOrderQueue(order_request, order_queue, price, passive_order_book, instrument, observer, match_validators,
+                    current_validation);
+  }
+};
+
+namespace {
+
+// Matches order_request against the levels of match_order_queues in price priority, level_allocation allocating it
+// across the orders of each level
+template<typename OrderExt, typename MatchValidators, typename MatchOrderPriceQueues, typename LevelAllocation>
 [[nodiscard]] ValidationResponse executeOrder(ClientOrderRequest<OrderExt> &order_request,
                                               MatchOrderPriceQueues &&match_order_queues,
                                               PassiveOrderBook<OrderExt> &passive_order_book,
                                               const InstrumentType &instrument,
                                               IEngineEventObserver &observer,
-                                              const MatchValidators &match_validators) {
+                                              const MatchValidators &match_validators,
+                                              const LevelAllocation &level_allocation) {
 
   // We are leveraging on order queue key comparator to perform order price comparison
   static_assert(std::is_same_v<decltype(match_order_queues.key_comp()), std::greater<PriceType>> ||
@@ -84,6 +210,13 @@ template<typename OrderExt, typename MatchValidators, typename MatchOrderPriceQu
 
   ValidationResponse current_validation{ValidationResponse::NO_ERROR};
 
+  // Pegged orders are priced off the best prices as they stand whenever a level is reached: primary pegs queue
+  // behind the orders of the best level, mid pegs ahead of the level they are priced better than, or behind the
+  // primary pegs of the level they are priced at
+  const auto passive_side = (order_request.side_ == OrderSide::BUY) ? OrderSide::SELL : OrderSide::BUY;
+  const bool peg_orders = passive_order_book.hasPegOrders(passive_side);
+  bool best_level_reached{false};
+
   auto match_order_queues_itr{match_order_queues.begin()};
 
   // Iterating price levels
@@ -93,57 +226,45 @@ template<typename OrderExt, typename MatchValidators, typename MatchOrderPriceQu
           || current_validation == ValidationResponse::CONTINUE_WITHOUT_MATCHING)) {
 
     auto &[current_order_queue_price, order_queue] {*match_order_queues_itr};
-    if (match_order_queues.key_comp()(order_request.price_, current_order_queue_price)) break;
-
-    // Iterating order queue per each price
-    for (auto itr = order_queue.begin(); itr != order_queue.end() && order_request.size_ > 0;) {
 
-      auto &current_passive_order_ptr = *itr;
-      PassiveOrder<OrderExt> &current_passive_order = *current_passive_order_ptr;
-
-      if (current_passive_order.remaining_size_ == 0) {
-        // Ignore and remove cancelled order in the queue
-        itr = order_queue.erase(itr);
-        continue;
+    std::optional<PriceType> mid_peg_price{};
+    if (peg_orders) mid_peg_price = passive_order_book.getPegPrice(passive_side, OrderType::MID_PEG);
+    if (mid_peg_price && match_order_queues.key_comp()(*mid_peg_price, current_order_queue_price)) {
+      if (!match_order_queues.key_comp()(order_request.price_, *mid_peg_price)) {
+        level_allocation(order_request, passive_order_book.getPegQueue(passive_side, OrderType::MID_PEG),
+                         *mid_peg_price, passive_order_book, instrument, observer, match_validators,
+                         current_validation);
+        if (isMatchingStopped(current_validation)) return current_validation;
       }
+      mid_peg_price.reset();
+    }
 
-      current_validation = match_validators.validate(order_request, passive_order_book, current_passive_order);
-
-      if (current_validation == ValidationResponse::CONTINUE_WITHOUT_MATCHING) {
-        itr++;
-        continue;
-      } else if (current_validation != ValidationResponse::NO_ERROR) {
-        return current_validation;
-      }
+    if (match_order_queues.key_comp()(order_request.price_, current_order_queue_price)) break;
 
-      SizeType trade_size = current_passive_order.remaining_size_;
-
-      if (order_request.size_ >= current_passive_order.remaining_size_) {
-        itr = order_queue.erase(itr);
-        passive_order_book.cancelClientOrder(
-            current_passive_order.client_,
-            current_passive_order.cln_order_id_);
-      } else {
-        current_passive_order.remaining_size_ -= order_request.size_;
-        trade_size = order_request.size_;
-        itr++;
+    const bool best_level = !best_level_reached && order_queue.total_size_ > 0;
+    level_allocation(order_request, order_queue, current_order_queue_price, passive_order_book, instrument, observer,
+                     match_validators, current_validation);
+    if (isMatchingStopped(current_validation)) return current_validation;
+
+    if (best_level) {
+      best_level_reached = true;
+      if (peg_orders) {
+        level_allocation(order_request, passive_order_book.getPegQueue(passive_side, OrderType::PRIMARY_PEG),
+                         current_order_queue_price, passive_order_book, instrument, observer, match_validators,
+                         current_validation);
+        if (isMatchingStopped(current_validation)) return current_validation;
       }
+    }
 
-      observer.doTradeEvent(
-          order_request.client_,
-          order_request.cln_order_id_,
-          current_passive_order.client_,
-          current_passive_order.cln_order_id_,
-          instrument,
-          current_order_queue_price,
-          trade_size
-      );
-
-      order_request.size_ -= trade_size;
+    if (mid_peg_price && *mid_peg_price == current_order_queue_price) {
+      level_allocation(order_request, passive_order_book.getPegQueue(passive_side, OrderType::MID_PEG),
+                       current_order_queue_price, passive_order_book, instrument, observer, match_validators,
+                       current_validation);
+      if (isMatchingStopped(current_validation)) return current_validation;
     }
 
     if (order_queue.empty()) {
-      match_order_queues_itr = match_order_queues.erase(match_order_queues_itr);
+      match_order_queues_itr = passive_order_book.erasePriceLevel(match_order_queues, match_order_queues_itr);
     } else {
       match_order_queues_itr++;
     }
@@ -153,18 +274,233 @@ template<typename OrderExt, typename MatchValidators, typename MatchOrderPriceQu
   return current_validation;
 
 }
+
+// Adds the size order_request can match in order_queue to fillable_size, false if matching would stop in it
+template<typename OrderExt, typename MatchValidators, typename OrderContainer>
+[[nodiscard]] bool sizeUpOrderQueue(const ClientOrderRequest<OrderExt> &order_request,
+                                    const OrderContainer &order_queue,
+                                    const PassiveOrderBook<OrderExt> &passive_order_book,
+                                    const MatchValidators &match_validators,
+                                    SizeType &fillable_size) {
+  if constexpr (IsNoValidators<MatchValidators>::value) {
+    fillable_size += order_queue.total_size_;
+  } else {
+    for (const auto &passive_order_ptr : order_queue) {
+      if (passive_order_ptr->remaining_size_ == 0) continue;
+
+      const auto validation_response = match_validators.validate(order_request, passive_order_book,
+                                                                 *passive_order_ptr);
+      if (validation_response == ValidationResponse::CONTINUE_WITHOUT_MATCHING) continue;
+      if (validation_response != ValidationResponse::NO_ERROR) return false;
+
+      fillable_size += passive_order_ptr->getOpenSize();
+      if (fillable_size >= order_request.size_) return true;
+    }
+  }
+  return true;
+}
+
+// Whether order_request would fill in full against match_order_queues, sized up before touching any order.
+// Without match validators every order of a crossing level is matchable, so aggregate sizes of the levels suffice.
+// Match validators may skip or stop at orders, in which case the orders of crossing levels are validated in turn.
+template<typename OrderExt, typename MatchValidators, typename MatchOrderPriceQueues>
+[[nodiscard]] bool isFillable(const ClientOrderRequest<OrderExt> &order_request,
+                              const MatchOrderPriceQueues &match_order_queues,
+                              const PassiveOrderBook<OrderExt> &passive_order_book,
+                              const MatchValidators &match_validators) {
+  const auto crosses = [&](const PriceType &price) {
+    return order_request.order_type_ == OrderType::MARKET
+        || !match_order_queues.key_comp()(order_request.price_, price);
+  };
+
+  SizeType fillable_size{0};
+
+  // Pegged orders crossing at the current best prices, which only move away as the order matches
+  const auto passive_side = (order_request.side_ == OrderSide::BUY) ? OrderSide::SELL : OrderSide::BUY;
+  if (passive_order_book.hasPegOrders(passive_side)) {
+    for (const auto &peg_type : {OrderType::PRIMARY_PEG, OrderType::MID_PEG}) {
+      const auto peg_price = passive_order_book.getPegPrice(passive_side, peg_type);
+      if (!peg_price || !crosses(*peg_price)) continue;
+      if (!sizeUpOrderQueue(order_request, passive_order_book.getPegQueue(passive_side, peg_type),
+                            passive_order_book, match_validators, fillable_size)) {
+        return false;
+      }
+    }
+  }
+
+  for (const auto &[order_queue_price, order_queue] : match_order_queues) {
+    if (fillable_size >= order_request.size_) return true;
+    if (!crosses(order_queue_price)) break;
+    if (!sizeUpOrderQueue(order_request, order_queue, passive_order_book, match_validators, fillable_size)) {
+      return false;
+    }
+  }
+
+  return fillable_size >= order_request.size_;
+}
+
+// Cancels orders of passive_order_book resting till a time before or at time, each reported as an unsolicited cancel
+template<typename OrderExt>
+void expirePassiveOrders(PassiveOrderBook<OrderExt> &passive_order_book,
+                         const InstrumentType &instrument,
+                         const std::uint64_t &time,
+                         IEngineEventObserver &observer) {
+
+  passive_order_book.expireOrders(time, [&](const PassiveOrder<OrderExt> &passive_order) {
+    observer.doOrderRequestResponse(
+        passive_order.client_,
+        passive_order.cln_order_id_,
+        instrument,
+        passive_order.price_,
+        passive_order.getOpenSize(),
+        OrderRequestResult::CANCELLED,
+        ValidationResponse::ORDER_EXPIRED);
+  }, [&](const ClientOrderRequest<OrderExt> &trigger_order) {
+    observer.doOrderRequestResponse(
+        trigger_order.client_,
+        trigger_order.cln_order_id_,
+        instrument,
+        trigger_order.price_,
+        trigger_order.size_,
+        OrderRequestResult::CANCELLED,
+        ValidationResponse::ORDER_EXPIRED);
+  });
+
+}
+
+template<typename OrderExt, typename CancelValidators>
+void cancelOrder(const ClientOrderRequest<OrderExt> &order_request,
+                 PassiveOrderBook<OrderExt> &passive_order_book,
+                 IEngineEventObserver &observer,
+                 const CancelValidators &cancel_validators) {
+
+  auto validation_response = cancel_validators.validate(order_request, passive_order_book);
+
+  auto request_result = (validation_response == ValidationResponse::NO_ERROR)
+                        ? OrderRequestResult::ACK
+                        : OrderRequestResult::NACK;
+
+  observer.doOrderRequestResponse(
+      order_request.client_,
+      order_request.cln_order_id_,
+      order_request.instrument_,
+      order_request.price_,
+      order_request.size_,
+      request_result,
+      validation_response);
+
+  if (validation_response == ValidationResponse::NO_ERROR) {
+    passive_order_book.cancelClientOrder(order_request.client_, order_request.cln_order_id_);
+  }
+
+}
+
+template<typename OrderExt>
+void massCancelOrders(const ClientOrderRequest<OrderExt> &order_request,
+                      PassiveOrderBook<OrderExt> &passive_order_book,
+                      IEngineEventObserver &observer) {
+
+  const auto side = (order_request.order_action_ == OrderAction::MASS_CANCEL_SIDE)
+                    ? std::optional<OrderSide>{order_request.side_}
+                    : std::nullopt;
+  const auto cancelled = passive_order_book.cancelClientOrders(order_request.client_, side);
+
+  // One summary response whatever the number of orders cancelled, size being that number
+  observer.doOrderRequestResponse(
+      order_request.client_,
+      order_request.cln_order_id_,
+      order_request.instrument_,
+      order_request.price_,
+      static_cast<SizeType>(cancelled),
+      OrderRequestResult::ACK,
+      ValidationResponse::NO_ERROR);
+
+}
+
+// Amends the resting order order_request refers to. Size down at the same price is done in place, the order keeping
+// its time priority. Otherwise the order entered in its place, with the fields of the resting order carried over, has
+// to pass new_validators too, seeing the resting order as the passive order. The resting order is then cancelled and
+// true returned, order_request being the order to enter anew, having lost its priority.
+// Stop orders waiting for their trigger are not amendable.
+template<typename OrderExt, typename AmendValidators, typename NewValidators>
+[[nodiscard]] bool amendOrder(ClientOrderRequest<OrderExt> &order_request,
+                              PassiveOrderBook<OrderExt> &passive_order_book,
+                              IEngineEventObserver &observer,
+                              const AmendValidators &amend_validators,
+                              const NewValidators &new_validators) {
+
+  // Amend validators see the resting order being amended as the passive order
+  const auto passive_order = passive_order_book.getEngineOrderFromCache(order_request.client_,
+                                                                        order_request.cln_order_id_);
+  auto validation_response = ValidationResponse::NO_SUCH_ORDER;
+  bool in_place{false};
+  if (passive_order) {
+    validation_response = (order_request.size_ == 0
+        || order_request.order_type_ != passive_order->order_type_
+        || order_request.side_ != passive_order->side_)
+                          ? ValidationResponse::INVALID_ORDER_REQUEST
+                          : amend_validators.validate(order_request, passive_order_book, *passive_order);
+
+    // Pegged orders have no price of their own to amend
+    in_place = (isPegOrderType(passive_order->order_type_) || order_request.price_ == passive_order->price_)
+        && order_request.size_ <= passive_order->getOpenSize();
+
+    if (validation_response == ValidationResponse::NO_ERROR && !in_place) {
+      if (!order_request.custom_fields_) order_request.custom_fields_ = passive_order->custom_fields_;
+      // The amended order rests as long as the order it replaces would have
+      order_request.time_in_force_ = passive_order->expire_time_ > 0 ? TimeInForce::GTT : TimeInForce::GTC;
+      order_request.expire_time_ = passive_order->expire_time_;
+      if (order_request.display_size_ == 0) order_request.display_size_ = passive_order->display_size_;
+      validation_response = new_validators.validate(order_request, passive_order_book, *passive_order);
+    }
+  } else if (passive_order_book.getTriggerOrderBook().isOrderExist(order_request.client_,
+                                                                   order_request.cln_order_id_)) {
+    validation_response = ValidationResponse::INVALID_ORDER_REQUEST;
+  }
+
+  auto request_result = (validation_response == ValidationResponse::NO_ERROR)
+                        ? OrderRequestResult::ACK
+                        : OrderRequestResult::NACK;
+
+  observer.doOrderRequestResponse(
+      order_request.client_,
+      order_request.cln_order_id_,
+      order_request.instrument_,
+      order_request.price_,
+      order_request.size_,
+      request_result,
+      validation_response);
+
+  if (validation_response != ValidationResponse::NO_ERROR) return false;
+
+  if (in_place) {
+    passive_order_book.resizePassiveOrder(*passive_order, order_request.size_);
+    return false;
+  }
+
+  passive_order_book.cancelClientOrder(order_request.client_, order_request.cln_order_id_);
+  return true;
+
+}
+
 } // end of anonymous local namespace
 
-template<typename OrderExt, typename M, typename N, typename C>
-PriceTimePriorityMatching<OrderExt, M, N, C>::PriceTimePriorityMatching() {
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::PriceTimePriorityMatching() {
   request_handlers_[static_cast<std::size_t>(OrderAction::NEW)] =
       &PriceTimePriorityMatching::doProcessNewOrderRequest;
   request_handlers_[static_cast<std::size_t>(OrderAction::CANCEL)] =
       &PriceTimePriorityMatching::doProcessCancelOrderRequest;
+  request_handlers_[static_cast<std::size_t>(OrderAction::AMEND)] =
+      &PriceTimePriorityMatching::doProcessAmendOrderRequest;
+  request_handlers_[static_cast<std::size_t>(OrderAction::MASS_CANCEL)] =
+      &PriceTimePriorityMatching::doProcessMassCancelOrderRequest;
+  request_handlers_[static_cast<std::size_t>(OrderAction::MASS_CANCEL_SIDE)] =
+      &PriceTimePriorityMatching::doProcessMassCancelOrderRequest;
 }
 
-template<typename OrderExt, typename M, typename N, typename C>
-void PriceTimePriorityMatching<OrderExt, M, N, C>::doProcessOrderRequest(
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+void PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::doProcessOrderRequest(
     ClientOrderRequest<OrderExt> &order_request,
     PassiveOrderBook<OrderExt> &passive_order_book,
     IEngineEventObserver &observer) {
@@ -172,16 +508,88 @@ void PriceTimePriorityMatching<OrderExt, M, N, C>::doProcessOrderRequest(
   const auto &request_handler = request_handlers_[static_cast<std::size_t>(order_request.order_action_)];
   (this->*request_handler)(order_request, passive_order_book, observer);
 
+  if (passive_order_book.getTriggerOrderBook().hasTriggeredOrders()) {
+    enterTriggeredOrders(passive_order_book, observer);
+  }
+
+}
+
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+void PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::enterTriggeredOrders(
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
+
+  // Triggered orders were ACKed on entry, they trade under their own order id without any further response
+  passive_order_book.getTriggerOrderBook().takeTriggeredOrders([&](ClientOrderRequest<OrderExt> &order_request) {
+    order_request.order_type_ = (order_request.order_type_ == OrderType::STOP) ? OrderType::MARKET
+                                                                               : OrderType::LIMIT;
+
+    if (order_request.time_in_force_ == TimeInForce::FOK) {
+      const bool fillable = (order_request.side_ == OrderSide::BUY)
+                            ? isFillable(order_request, passive_order_book.getAskOrderQueue(), passive_order_book,
+                                         match_validators_)
+                            : isFillable(order_request, passive_order_book.getBidOrderQueue(), passive_order_book,
+                                         match_validators_);
+      if (!fillable) {
+        observer.doOrderRequestResponse(
+            order_request.client_,
+            order_request.cln_order_id_,
+            order_request.instrument_,
+            order_request.price_,
+            order_request.size_,
+            OrderRequestResult::NACK,
+            ValidationResponse::NOT_FILLABLE);
+        return;
+      }
+    }
+
+    matchAndPlaceOrder(order_request, passive_order_book, observer);
+  });
+
 }
 
-template<typename OrderExt, typename M, typename N, typename C>
-void PriceTimePriorityMatching<OrderExt, M, N, C>::doProcessNewOrderRequest(
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+void PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::doExpireOrders(
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    const InstrumentType &instrument,
+    const std::uint64_t &time,
+    IEngineEventObserver &observer) {
+
+  expirePassiveOrders(passive_order_book, instrument, time, observer);
+
+}
+
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+void PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::doProcessNewOrderRequest(
     ClientOrderRequest<OrderExt> &order_request,
     PassiveOrderBook<OrderExt> &passive_order_book,
     IEngineEventObserver &observer) {
 
   auto validation_response = new_validators_.validate(order_request, passive_order_book);
 
+  const bool stop_order = order_request.order_type_ == OrderType::STOP
+      || order_request.order_type_ == OrderType::STOP_LIMIT;
+  if (validation_response == ValidationResponse::NO_ERROR && stop_order && order_request.trigger_price_ == 0) {
+    validation_response = ValidationResponse::INVALID_ORDER_REQUEST;
+  }
+  // Pegged orders only ever rest
+  if (validation_response == ValidationResponse::NO_ERROR && isPegOrderType(order_request.order_type_)
+      && (order_request.time_in_force_ == TimeInForce::IOC || order_request.time_in_force_ == TimeInForce::FOK)) {
+    validation_response = ValidationResponse::INVALID_ORDER_REQUEST;
+  }
+
+  // Fill or kill is rejected up front when it cannot fill in full, so there is never a fill to roll back.
+  // Stop orders are sized up once triggered instead.
+  if (validation_response == ValidationResponse::NO_ERROR && !stop_order
+      && order_request.time_in_force_ == TimeInForce::FOK) {
+    const bool fillable = (order_request.side_ == OrderSide::BUY)
+                          ? isFillable(order_request, passive_order_book.getAskOrderQueue(), passive_order_book,
+                                       match_validators_)
+                          : isFillable(order_request, passive_order_book.getBidOrderQueue(), passive_order_book,
+                                       match_validators_);
+    if (!fillable) validation_response = ValidationResponse::NOT_FILLABLE;
+  }
+
   auto request_result = (validation_response == ValidationResponse::NO_ERROR)
                         ? OrderRequestResult::ACK
                         : OrderRequestResult::NACK;
@@ -197,32 +605,63 @@ void PriceTimePriorityMatching<OrderExt, M, N, C>::doProcessNewOrderRequest(
 
   if (validation_response != ValidationResponse::NO_ERROR) return;
 
-  if (order_request.side_ == OrderSide::BUY) {
+  if (stop_order) {
+    // Waits for its trigger, unless the last trade is already at or beyond it
+    passive_order_book.placeTriggerOrder(order_request);
+    if (passive_order_book.getLastTradePrice() > 0) {
+      passive_order_book.getTriggerOrderBook().triggerOrders(passive_order_book.getLastTradePrice());
+    }
+    return;
+  }
+
+  matchAndPlaceOrder(order_request, passive_order_book, observer);
+
+}
+
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+void PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::matchAndPlaceOrder(
+    ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
+
+  auto validation_response = ValidationResponse::NO_ERROR;
+
+  // Pegged orders are placed straight into their peg queue, trading only against orders coming in
+  const bool pegged = isPegOrderType(order_request.order_type_);
+  if (!pegged && order_request.side_ == OrderSide::BUY) {
     validation_response = executeOrder<OrderExt>(
         order_request,
         passive_order_book.getAskOrderQueue(),
         passive_order_book,
         order_request.instrument_,
         observer,
-        match_validators_);
-  } else if (order_request.side_ == OrderSide::SELL) {
+        match_validators_,
+        level_allocation_);
+  } else if (!pegged && order_request.side_ == OrderSide::SELL) {
     validation_response = executeOrder<OrderExt>(
         order_request,
         passive_order_book.getBidOrderQueue(),
         passive_order_book,
         order_request.instrument_,
         observer,
-        match_validators_);
+        match_validators_,
+        level_allocation_);
   }
 
-  if (validation_response == ValidationResponse::NO_ERROR) {
+  // Immediate or cancel and fill or kill never rest, as for market orders what is left unfilled is dropped
+  const bool resting = order_request.time_in_force_ == TimeInForce::GTC
+      || order_request.time_in_force_ == TimeInForce::GTT;
+  if (validation_response == ValidationResponse::NO_ERROR && resting) {
     passive_order_book.placePassiveOrder(order_request.client_,
                                          order_request.cln_order_id_,
                                          order_request.order_type_,
                                          order_request.side_,
                                          order_request.price_,
                                          order_request.size_,
-                                         order_request.custom_fields_);
+                                         order_request.custom_fields_,
+                                         order_request.time_in_force_ == TimeInForce::GTT
+                                         ? order_request.expire_time_ : 0,
+                                         order_request.display_size_);
   } else if (validation_response != ValidationResponse::NO_ERROR) {
     observer.doOrderRequestResponse(
         order_request.client_,
@@ -236,29 +675,35 @@ void PriceTimePriorityMatching<OrderExt, M, N, C>::doProcessNewOrderRequest(
 
 }
 
-template<typename OrderExt, typename M, typename N, typename C>
-void PriceTimePriorityMatching<OrderExt, M, N, C>::doProcessCancelOrderRequest(
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+void PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::doProcessCancelOrderRequest(
     ClientOrderRequest<OrderExt> &order_request,
     PassiveOrderBook<OrderExt> &passive_order_book,
     IEngineEventObserver &observer) {
 
-  auto validation_response = cancel_validators_.validate(order_request, passive_order_book);
+  cancelOrder(order_request, passive_order_book, observer, cancel_validators_);
 
-  auto request_result = (validation_response == ValidationResponse::NO_ERROR)
-                        ? OrderRequestResult::ACK
-                        : OrderRequestResult::NACK;
+}
 
-  observer.doOrderRequestResponse(
-      order_request.client_,
-      order_request.cln_order_id_,
-      order_request.instrument_,
-      order_request.price_,
-      order_request.size_,
-      request_result,
-      validation_response);
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+void PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::doProcessMassCancelOrderRequest(
+    ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
 
-  if (validation_response == ValidationResponse::NO_ERROR) {
-    passive_order_book.cancelClientOrder(order_request.client_, order_request.cln_order_id_);
+  massCancelOrders(order_request, passive_order_book, observer);
+
+}
+
+template<typename OrderExt, typename M, typename N, typename C, typename A, typename L>
+void PriceTimePriorityMatching<OrderExt, M, N, C, A, L>::doProcessAmendOrderRequest(
+    ClientOrderRequest<OrderExt> &order_request,
+    PassiveOrderBook<OrderExt> &passive_order_book,
+    IEngineEventObserver &observer) {
+
+  // An order losing its priority may cross at its new price
+  if (amendOrder(order_request, passive_order_book, observer, amend_validators_, new_validators_)) {
+    matchAndPlaceOrder(order_request, passive_order_book, observer);
   }
 
 }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
+#include "types.h"
+
 namespace codetest::matching_engine_sim {
 
 template<typename OrderExt = void>
@@ -11,16 +14,45 @@ struct PassiveOrder {
   constexpr PassiveOrder(const ClientType &client,
                          const OrderIDType &cln_order_id,
                          const SizeType &remaining_size,
-                         const std::shared_ptr<OrderExt> &custom_fields = nullptr)
+                         const std::shared_ptr<OrderExt> &custom_fields = nullptr,
+                         const OrderSide &side = OrderSide::BUY,
+                         const PriceType &price = 0,
+                         const std::uint64_t &sequence = 0,
+                         const std::uint64_t &expire_time = 0,
+                         const OrderType &order_type = OrderType::LIMIT,
+                         const SizeType &display_size = 0)
       : client_(client),
         cln_order_id_(cln_order_id),
+        side_(side),
+        order_type_(order_type),
+        price_(price),
+        sequence_(sequence),
+        expire_time_(expire_time),
+        display_size_(display_size),
         remaining_size_(remaining_size),
         custom_fields_(custom_fields) {}
 
   const ClientType client_{};
   const OrderIDType cln_order_id_{};
+  const OrderSide side_{};
+  // LIMIT, or either peg type for pegged orders, which are at the price of their peg rather than price_
+  const OrderType order_type_{OrderType::LIMIT};
+  const PriceType price_{};
+  // Order of arrival into the book, an order at the same price level with a lower sequence is ahead in queue,
+  // but for icebergs, which go to the back of the queue on each slice shown from reserve
+  const std::uint64_t sequence_{};
+  // Good till time orders only, 0 for orders resting until cancelled
+  const std::uint64_t expire_time_{};
+  // Iceberg orders only, size of each slice shown from reserve, 0 for orders showing their full size
+  const SizeType display_size_{};
+  // Size shown in the book, which is all that is left of an order unless it is an iceberg
   SizeType remaining_size_{};
+  // Iceberg orders only, size hidden behind the shown slice
+  SizeType reserve_size_{};
   std::shared_ptr<OrderExt> custom_fields_{};
+
+  // Shown and hidden size left to fill
+  [[nodiscard]] SizeType getOpenSize() const { return remaining_size_ + reserve_size_; }
 };
 
 } // end of namespace
\ No newline at end of file
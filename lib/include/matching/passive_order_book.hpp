@@ -1,13 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <queue>
 #include <map>
 #include <unordered_map>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <optional>
+#include <type_traits>
+#include <vector>
 
 #include "types.h"
+#include "matching/fixed_block_pool.h"
 #include "matching/passive_order.h"
+#include "matching/trigger_order_book.hpp"
+#include "simulation/timing_wheel.hpp"
 
 namespace codetest::matching_engine_sim {
 
@@ -23,12 +32,19 @@ class PassiveOrderBook final {
   // 1. queue by default uses deque which no guarantee objects are in contiguous memory (cache locality)
   // 2. instead of employing vector as underlying data structure for queue, using vector directly offers
   // opportunities to provide more features such as skipping particular order in matching process
-  using OrderContainer = std::vector<PassiveOrderPtr>;
+  // A price level also keeps the remaining size of its orders, to size up liquidity without walking them
+  struct OrderContainer final : std::vector<PassiveOrderPtr> {
+    using std::vector<PassiveOrderPtr>::vector;
+    SizeType total_size_{};
+  };
+  using AskOrderQueues = std::map<PriceType, OrderContainer>;
+  using BidOrderQueues = std::map<PriceType, OrderContainer, std::greater<PriceType>>;
 
   PassiveOrderBook() = default;
-  PassiveOrderBook(const PassiveOrderBook &) = default;
+  // A copy shares the orders, but draws the orders it places from a pool of its own
+  PassiveOrderBook(const PassiveOrderBook &other);
   PassiveOrderBook(PassiveOrderBook &&) noexcept = default;
-  PassiveOrderBook &operator=(const PassiveOrderBook &) = default;
+  PassiveOrderBook &operator=(const PassiveOrderBook &other);
   PassiveOrderBook &operator=(PassiveOrderBook &&) noexcept = default;
   ~PassiveOrderBook() = default;
 
@@ -37,15 +53,84 @@ class PassiveOrderBook final {
   [[nodiscard]] const auto &getAskOrderQueue() const { return ask_orders_; }
   [[nodiscard]] const auto &getBidOrderQueue() const { return bid_orders_; }
 
+  // Pegged orders of side pegged as order_type, in time priority. A queue holds no price, its orders are priced by
+  // getPegPrice off the best prices as they stand, so a move of the best prices never touches them.
+  [[nodiscard]] OrderContainer &getPegQueue(const OrderSide &side, const OrderType &order_type) {
+    return peg_queues_[pegQueueIndex(side, order_type)];
+  }
+  [[nodiscard]] const OrderContainer &getPegQueue(const OrderSide &side, const OrderType &order_type) const {
+    return peg_queues_[pegQueueIndex(side, order_type)];
+  }
+
+  [[nodiscard]] bool hasPegOrders(const OrderSide &side) const {
+    return getPegQueue(side, OrderType::PRIMARY_PEG).total_size_ > 0
+        || getPegQueue(side, OrderType::MID_PEG).total_size_ > 0;
+  }
+
+  // Best price of side among its limit orders, none if there is no order left on side
+  [[nodiscard]] std::optional<PriceType> getBestPrice(const OrderSide &side) const;
+
+  // Price pegged orders of side pegged as order_type are at, none while there is no price to peg to
+  [[nodiscard]] std::optional<PriceType> getPegPrice(const OrderSide &side, const OrderType &order_type) const;
+
+  // Stop and stop limit orders of the instrument waiting for their trigger
+  [[nodiscard]] auto &getTriggerOrderBook() { return trigger_order_book_; }
+  [[nodiscard]] const auto &getTriggerOrderBook() const { return trigger_order_book_; }
+
+  // Price of the last trade, 0 before any trade
+  [[nodiscard]] const PriceType &getLastTradePrice() const { return last_trade_price_; }
+
+  // Records a trade at price, queuing up stop orders it triggers
+  void recordTrade(const PriceType &price) {
+    last_trade_price_ = price;
+    if (!trigger_order_book_.empty()) trigger_order_book_.triggerOrders(price);
+  }
+
+  // Places a stop order to wait for its trigger, one with an expire time is taken out by expireOrders once due
+  void placeTriggerOrder(const ClientOrderRequest<OrderExt> &order_request);
+
+  // Cancels a resting order, or else a stop order waiting for its trigger
   void cancelClientOrder(const ClientType &client, const OrderIDType &order_id);
 
+  // Fills size of passive_order resting in level, an order filled in full can no longer be looked up or cancelled
+  void fillPassiveOrder(OrderContainer &level, PassiveOrder<OrderExt> &passive_order, const SizeType &size);
+
+  // Sets open size of a resting order in place, keeping its time priority. An iceberg sizes down its reserve first.
+  void resizePassiveOrder(PassiveOrder<OrderExt> &passive_order, const SizeType &size);
+
+  // Shows the next slice of an iceberg order from its reserve once its shown slice is filled.
+  // Size of the level is unchanged, it counts reserves along with shown sizes.
+  void replenishPassiveOrder(PassiveOrder<OrderExt> &passive_order) {
+    passive_order.remaining_size_ = std::min(passive_order.display_size_, passive_order.reserve_size_);
+    passive_order.reserve_size_ -= passive_order.remaining_size_;
+  }
+
+  // Cancels every order of client, of side only when given, in one pass over the orders of the client.
+  // Stop orders waiting for their trigger are cancelled alike. Returns number of orders cancelled.
+  std::size_t cancelClientOrders(const ClientType &client, const std::optional<OrderSide> &side = std::nullopt);
+
+  // Calls f(passive_order) for every resting order of client, in no particular order
+  template<typename F>
+  void forEachClientOrder(const ClientType &client, F &&f) const;
+
+  // An order with an expire time is taken out of the book by expireOrders once due.
+  // Pegged orders go to the tail of their peg queue, price being ignored.
+  // An order with a display size rests as an iceberg, showing display size at a time.
   void placePassiveOrder(const ClientType &client,
                          const OrderIDType &cln_order_id,
                          const OrderType &order_type,
                          const OrderSide &order_side,
                          const PriceType &price,
                          const SizeType &size,
-                         const std::shared_ptr<OrderExt> &custom_fields);
+                         const std::shared_ptr<OrderExt> &custom_fields,
+                         const std::uint64_t &expire_time = 0,
+                         const SizeType &display_size = 0);
+
+  // Cancels orders expiring at or before time, calling on_expired(passive_order) for each before it is cancelled.
+  // Stop orders still waiting for their trigger are cancelled alike, calling on_trigger_expired(order_request).
+  // Orders filled, cancelled, triggered or replaced meanwhile are skipped, without ever scanning the book.
+  template<typename F, typename T>
+  void expireOrders(const std::uint64_t &time, F &&on_expired, T &&on_trigger_expired);
 
   [[nodiscard]]
   bool isOrderExist(const ClientType &client, const OrderIDType &order_id) const;
@@ -53,16 +138,135 @@ class PassiveOrderBook final {
   [[nodiscard, maybe_unused]]
   PassiveOrderPtr getEngineOrderFromCache(const ClientType &client, const OrderIDType &order_id);
 
+  // Sequence the next order placed gets
+  [[nodiscard]] std::uint64_t getNextSequence() const { return next_sequence_; }
+
+  // Removes the price level at itr of either side, returns the iterator following it
+  template<typename OrderQueues>
+  typename OrderQueues::iterator erasePriceLevel(OrderQueues &order_queues, typename OrderQueues::iterator itr);
+
  private:
+  using OrderIDMap = std::unordered_map<OrderIDType, PassiveOrderPtr>;
+
+  // Price level at price, created if absent
+  template<typename OrderQueues>
+  OrderContainer &getPriceLevel(OrderQueues &order_queues, const PriceType &price);
+
+  template<typename OrderQueues>
+  auto &getSparePriceLevels();
+
+  // Price level a resting order is in, nullptr if there is none
+  OrderContainer *findPriceLevel(const PassiveOrder<OrderExt> &passive_order);
+
+  void eraseOrderID(OrderIDMap &order_id_map, typename OrderIDMap::iterator order_itr);
+
+  [[nodiscard]] static std::size_t pegQueueIndex(const OrderSide &side, const OrderType &order_type) {
+    return static_cast<std::size_t>(side) * 2 + (order_type == OrderType::MID_PEG ? 1 : 0);
+  }
+
+  // Good till time order due to expire, which sequence tells apart from a later order of the same order id.
+  // A stop order waiting for its trigger has no sequence, one of the same order id is due alike by its expire time.
+  struct ExpiringOrder {
+    ClientType client_{};
+    OrderIDType cln_order_id_{};
+    std::uint64_t sequence_{};
+    bool trigger_order_{};
+  };
+
   // using map for key based (Price) ordering
-  std::map<PriceType, OrderContainer> ask_orders_{};
-  std::map<PriceType, OrderContainer, std::greater<PriceType>> bid_orders_{};
+  AskOrderQueues ask_orders_{};
+  BidOrderQueues bid_orders_{};
 
   // Provides hash-based ClientID-OrderID to EngineOrderRef lookup
   // Crucial to avoid linear search for order amend and cancel request
-  std::unordered_map<ClientType, std::unordered_map<OrderIDType, PassiveOrderPtr>> client_orders_map_{};
+  std::unordered_map<ClientType, OrderIDMap> client_orders_map_{};
+
+  // Primary and mid peg queues of bid side, followed by those of ask side
+  std::array<OrderContainer, 4> peg_queues_{};
+
+  std::uint64_t next_sequence_{};
+
+  // Steady state placing, matching and cancelling stays off the heap: orders come from a pool, and the map nodes of
+  // price levels (along with the capacity of their order vectors) and of order ids are recycled once removed
+  std::shared_ptr<FixedBlockPool> order_pool_{std::make_shared<FixedBlockPool>()};
+  std::vector<typename AskOrderQueues::node_type> spare_ask_levels_{};
+  std::vector<typename BidOrderQueues::node_type> spare_bid_levels_{};
+  std::vector<typename OrderIDMap::node_type> spare_order_ids_{};
+
+  // Created on the first good till time order, a book without any does not carry the wheel
+  std::unique_ptr<TimingWheel<ExpiringOrder>> expiry_wheel_{};
+
+  TriggerOrderBook<OrderExt> trigger_order_book_{};
+  PriceType last_trade_price_{};
 };
 
+template<typename OrderExt>
+PassiveOrderBook<OrderExt>::PassiveOrderBook(const PassiveOrderBook &other)
+    : ask_orders_(other.ask_orders_),
+      bid_orders_(other.bid_orders_),
+      client_orders_map_(other.client_orders_map_),
+      peg_queues_(other.peg_queues_),
+      next_sequence_(other.next_sequence_),
+      expiry_wheel_(other.expiry_wheel_ ? std::make_unique<TimingWheel<ExpiringOrder>>(*other.expiry_wheel_)
+                                        : nullptr),
+      trigger_order_book_(other.trigger_order_book_),
+      last_trade_price_(other.last_trade_price_) {}
+
+template<typename OrderExt>
+PassiveOrderBook<OrderExt> &PassiveOrderBook<OrderExt>::operator=(const PassiveOrderBook &other) {
+  if (this != &other) {
+    ask_orders_ = other.ask_orders_;
+    bid_orders_ = other.bid_orders_;
+    client_orders_map_ = other.client_orders_map_;
+    peg_queues_ = other.peg_queues_;
+    next_sequence_ = other.next_sequence_;
+    expiry_wheel_ = other.expiry_wheel_ ? std::make_unique<TimingWheel<ExpiringOrder>>(*other.expiry_wheel_)
+                                        : nullptr;
+    trigger_order_book_ = other.trigger_order_book_;
+    last_trade_price_ = other.last_trade_price_;
+  }
+  return *this;
+}
+
+template<typename OrderExt>
+template<typename OrderQueues>
+auto &PassiveOrderBook<OrderExt>::getSparePriceLevels() {
+  if constexpr (std::is_same_v<OrderQueues, AskOrderQueues>) {
+    return spare_ask_levels_;
+  } else {
+    static_assert(std::is_same_v<OrderQueues, BidOrderQueues>, "Not an order queue of this book");
+    return spare_bid_levels_;
+  }
+}
+
+template<typename OrderExt>
+template<typename OrderQueues>
+auto PassiveOrderBook<OrderExt>::getPriceLevel(OrderQueues &order_queues,
+                                               const PriceType &price) -> OrderContainer & {
+  auto itr = order_queues.lower_bound(price);
+  if (itr != order_queues.end() && itr->first == price) return itr->second;
+
+  auto &spare_levels = getSparePriceLevels<OrderQueues>();
+  if (spare_levels.empty()) return order_queues.emplace_hint(itr, price, OrderContainer{})->second;
+
+  auto level = std::move(spare_levels.back());
+  spare_levels.pop_back();
+  level.key() = price;
+  return order_queues.insert(itr, std::move(level))->second;
+}
+
+template<typename OrderExt>
+template<typename OrderQueues>
+auto PassiveOrderBook<OrderExt>::erasePriceLevel(OrderQueues &order_queues,
+                                                 typename OrderQueues::iterator itr) -> typename OrderQueues::iterator {
+  auto next_itr = std::next(itr);
+  auto level = order_queues.extract(itr);
+  level.mapped().clear();
+  level.mapped().total_size_ = 0;
+  getSparePriceLevels<OrderQueues>().push_back(std::move(level));
+  return next_itr;
+}
+
 template<typename OrderExt>
 void PassiveOrderBook<OrderExt>::cancelClientOrder(const ClientType &client,
                                                    const OrderIDType &order_id) {
@@ -72,9 +276,95 @@ void PassiveOrderBook<OrderExt>::cancelClientOrder(const ClientType &client,
     auto order_itr = order_id_map.find(order_id);
     if (order_itr != order_id_map.end()) {
       auto &passive_order = order_itr->second;
+      if (auto *level = findPriceLevel(*passive_order)) level->total_size_ -= passive_order->getOpenSize();
       passive_order->remaining_size_ = 0;
-      order_id_map.erase(order_itr);
+      passive_order->reserve_size_ = 0;
+      eraseOrderID(order_id_map, order_itr);
+      return;
+    }
+  }
+  trigger_order_book_.cancelTriggerOrder(client, order_id);
+}
+
+template<typename OrderExt>
+void PassiveOrderBook<OrderExt>::fillPassiveOrder(OrderContainer &level,
+                                                  PassiveOrder<OrderExt> &passive_order,
+                                                  const SizeType &size) {
+  level.total_size_ -= size;
+  passive_order.remaining_size_ -= size;
+  if (passive_order.remaining_size_ > 0 || passive_order.reserve_size_ > 0) return;
+
+  auto client_itr = client_orders_map_.find(passive_order.client_);
+  if (client_itr == client_orders_map_.end()) return;
+  auto &[_, order_id_map] = *client_itr;
+  auto order_itr = order_id_map.find(passive_order.cln_order_id_);
+  // Lookup may hold a later order placed with the same order id
+  if (order_itr != order_id_map.end() && order_itr->second.get() == &passive_order) {
+    eraseOrderID(order_id_map, order_itr);
+  }
+}
+
+template<typename OrderExt>
+void PassiveOrderBook<OrderExt>::resizePassiveOrder(PassiveOrder<OrderExt> &passive_order, const SizeType &size) {
+  if (auto *level = findPriceLevel(passive_order)) {
+    level->total_size_ = level->total_size_ - passive_order.getOpenSize() + size;
+  }
+  passive_order.remaining_size_ = std::min(size, passive_order.remaining_size_);
+  passive_order.reserve_size_ = size - passive_order.remaining_size_;
+}
+
+template<typename OrderExt>
+auto PassiveOrderBook<OrderExt>::findPriceLevel(const PassiveOrder<OrderExt> &passive_order) -> OrderContainer * {
+  if (isPegOrderType(passive_order.order_type_)) return &getPegQueue(passive_order.side_, passive_order.order_type_);
+  if (passive_order.side_ == OrderSide::BUY) {
+    auto itr = bid_orders_.find(passive_order.price_);
+    return itr != bid_orders_.end() ? &itr->second : nullptr;
+  }
+  auto itr = ask_orders_.find(passive_order.price_);
+  return itr != ask_orders_.end() ? &itr->second : nullptr;
+}
+
+template<typename OrderExt>
+void PassiveOrderBook<OrderExt>::eraseOrderID(OrderIDMap &order_id_map, typename OrderIDMap::iterator order_itr) {
+  auto order_id_node = order_id_map.extract(order_itr);
+  order_id_node.mapped().reset();
+  spare_order_ids_.push_back(std::move(order_id_node));
+}
+
+template<typename OrderExt>
+std::size_t PassiveOrderBook<OrderExt>::cancelClientOrders(const ClientType &client,
+                                                           const std::optional<OrderSide> &side) {
+  std::size_t cancelled = trigger_order_book_.cancelClientOrders(client, side);
+
+  auto client_itr = client_orders_map_.find(client);
+  if (client_itr == client_orders_map_.end()) return cancelled;
+
+  auto &[_, order_id_map] = *client_itr;
+  for (auto order_itr = order_id_map.begin(); order_itr != order_id_map.end();) {
+    auto &passive_order = order_itr->second;
+    if (side && passive_order->side_ != *side) {
+      ++order_itr;
+      continue;
     }
+
+    // Left in its price level to be skipped and removed by matching, as with a single cancel
+    if (auto *level = findPriceLevel(*passive_order)) level->total_size_ -= passive_order->getOpenSize();
+    passive_order->remaining_size_ = 0;
+    passive_order->reserve_size_ = 0;
+    eraseOrderID(order_id_map, order_itr++);
+    cancelled++;
+  }
+  return cancelled;
+}
+
+template<typename OrderExt>
+template<typename F>
+void PassiveOrderBook<OrderExt>::forEachClientOrder(const ClientType &client, F &&f) const {
+  auto client_itr = client_orders_map_.find(client);
+  if (client_itr == client_orders_map_.end()) return;
+
+  for (const auto &[_, passive_order] : client_itr->second) {
+    f(*passive_order);
   }
 }
 
@@ -85,26 +375,117 @@ void PassiveOrderBook<OrderExt>::placePassiveOrder(const ClientType &client,
                                                    const OrderSide &order_side,
                                                    const PriceType &price,
                                                    const SizeType &size,
-                                                   const std::shared_ptr<OrderExt> &custom_fields) {
+                                                   const std::shared_ptr<OrderExt> &custom_fields,
+                                                   const std::uint64_t &expire_time,
+                                                   const SizeType &display_size) {
   if (size > 0 && order_type != OrderType::MARKET) {
-    PassiveOrderPtr ptr = std::make_shared<PassiveOrder<OrderExt>>(client, cln_order_id, size, custom_fields);
+    if (expire_time > 0) {
+      if (!expiry_wheel_) expiry_wheel_ = std::make_unique<TimingWheel<ExpiringOrder>>();
+      expiry_wheel_->schedule(expire_time, ExpiringOrder{client, cln_order_id, next_sequence_});
+    }
+
+    const SizeType shown_size = (display_size > 0) ? std::min(display_size, size) : size;
+    PassiveOrderPtr ptr = std::allocate_shared<PassiveOrder<OrderExt>>(
+        PoolAllocator<PassiveOrder<OrderExt>>{order_pool_},
+        client, cln_order_id, shown_size, custom_fields, order_side, price, next_sequence_++, expire_time,
+        order_type, display_size);
+    ptr->reserve_size_ = size - shown_size;
 
-    if (order_side == OrderSide::BUY)
-      bid_orders_[price].push_back(ptr);
-    else
-      ask_orders_[price].push_back(ptr);
+    auto &level = isPegOrderType(order_type) ? getPegQueue(order_side, order_type)
+                  : (order_side == OrderSide::BUY) ? getPriceLevel(bid_orders_, price)
+                                                   : getPriceLevel(ask_orders_, price);
+    level.push_back(ptr);
+    level.total_size_ += size;
+
+    auto &order_id_map = client_orders_map_[client];
+    if (spare_order_ids_.empty()) {
+      order_id_map[cln_order_id] = std::move(ptr);
+      return;
+    }
+
+    auto order_id_node = std::move(spare_order_ids_.back());
+    spare_order_ids_.pop_back();
+    order_id_node.key() = cln_order_id;
+    order_id_node.mapped() = std::move(ptr);
+    auto insert_result = order_id_map.insert(std::move(order_id_node));
+    if (!insert_result.inserted) {
+      // Same order id placed twice, the later order replaces the earlier one in the lookup
+      insert_result.position->second = std::move(insert_result.node.mapped());
+      spare_order_ids_.push_back(std::move(insert_result.node));
+    }
+  }
+}
 
-    client_orders_map_[client][ptr->cln_order_id_] = std::move(ptr);
+template<typename OrderExt>
+void PassiveOrderBook<OrderExt>::placeTriggerOrder(const ClientOrderRequest<OrderExt> &order_request) {
+  if (order_request.expire_time_ > 0 && order_request.time_in_force_ == TimeInForce::GTT) {
+    if (!expiry_wheel_) expiry_wheel_ = std::make_unique<TimingWheel<ExpiringOrder>>();
+    expiry_wheel_->schedule(order_request.expire_time_,
+                            ExpiringOrder{order_request.client_, order_request.cln_order_id_, 0, true});
   }
+  trigger_order_book_.placeTriggerOrder(order_request);
+}
+
+template<typename OrderExt>
+template<typename F, typename T>
+void PassiveOrderBook<OrderExt>::expireOrders(const std::uint64_t &time, F &&on_expired, T &&on_trigger_expired) {
+  if (!expiry_wheel_ || expiry_wheel_->empty()) return;
+
+  expiry_wheel_->advance(time, [&](const std::uint64_t &, const ExpiringOrder &expiring_order) {
+    if (expiring_order.trigger_order_) {
+      const auto trigger_order = trigger_order_book_.getTriggerOrder(expiring_order.client_,
+                                                                     expiring_order.cln_order_id_);
+      if (!trigger_order || trigger_order->time_in_force_ != TimeInForce::GTT || trigger_order->expire_time_ > time) {
+        return;
+      }
+
+      on_trigger_expired(*trigger_order);
+      trigger_order_book_.cancelTriggerOrder(expiring_order.client_, expiring_order.cln_order_id_);
+      return;
+    }
+
+    const auto passive_order = getEngineOrderFromCache(expiring_order.client_, expiring_order.cln_order_id_);
+    if (!passive_order || passive_order->sequence_ != expiring_order.sequence_) return;
+
+    on_expired(*passive_order);
+    cancelClientOrder(expiring_order.client_, expiring_order.cln_order_id_);
+  });
+}
+
+template<typename OrderExt>
+std::optional<PriceType> PassiveOrderBook<OrderExt>::getBestPrice(const OrderSide &side) const {
+  // Levels left with cancelled orders only linger until matched through
+  const auto best_price = [](const auto &order_queues) -> std::optional<PriceType> {
+    for (const auto &[price, order_queue] : order_queues) {
+      if (order_queue.total_size_ > 0) return price;
+    }
+    return std::nullopt;
+  };
+  return (side == OrderSide::BUY) ? best_price(bid_orders_) : best_price(ask_orders_);
+}
+
+template<typename OrderExt>
+std::optional<PriceType> PassiveOrderBook<OrderExt>::getPegPrice(const OrderSide &side,
+                                                                 const OrderType &order_type) const {
+  if (order_type == OrderType::PRIMARY_PEG) return getBestPrice(side);
+
+  const auto best_bid = getBestPrice(OrderSide::BUY);
+  const auto best_ask = getBestPrice(OrderSide::SELL);
+  if (!best_bid || !best_ask) return std::nullopt;
+  // Mid between two ticks is rounded down for bids and up for asks, never crossing the opposite side
+  return (side == OrderSide::BUY) ? *best_bid + (*best_ask - *best_bid) / 2
+                                  : *best_ask - (*best_ask - *best_bid) / 2;
 }
 
 template<typename OrderExt>
 [[nodiscard]] bool PassiveOrderBook<OrderExt>::isOrderExist(const ClientType &client,
                                                             const OrderIDType &order_id) const {
   auto itr = client_orders_map_.find(client);
-  if (itr == client_orders_map_.end()) return false;
-  const auto &[_, order_id_map] {*itr};
-  return order_id_map.find(order_id) != order_id_map.end();
+  if (itr != client_orders_map_.end()) {
+    const auto &[_, order_id_map] {*itr};
+    if (order_id_map.find(order_id) != order_id_map.end()) return true;
+  }
+  return trigger_order_book_.isOrderExist(client, order_id);
 }
 
 template<typename OrderExt>
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+
+#include "types.h"
+#include "matching/passive_order.h"
+#include "matching/passive_order_book.hpp"
+#include "matching/matching_algo.hpp"
+#include "matching/validators/validators.hpp"
+#include "interface/i_engine_event_observer.h"
+
+namespace codetest::matching_engine_sim {
+
+// Allocates an order across the orders of a price level in proportion to their open sizes, time priority only
+// settling rounding. Allocation is rounded up on cumulative open sizes, so odd lots go to the earliest orders and
+// allocations add up to the size matched at the level exactly, in a single pass over the level sized up by its
+// aggregate size.
+// Orders match validators skip take no share. Matching stops before any allocation should an order stop it.
+// An iceberg shares by its reserve along with its shown slice, and keeps its place in the level once replenished.
+struct ProRataAllocation final {
+  template<typename OrderExt, typename MatchValidators, typename OrderContainer>
+  void operator()(ClientOrderRequest<OrderExt> &order_request,
+                  OrderContainer &order_queue,
+                  const PriceType &price,
+                  PassiveOrderBook<OrderExt> &passive_order_book,
+                  const InstrumentType &instrument,
+                  IEngineEventObserver &observer,
+                  const MatchValidators &match_validators,
+                  ValidationResponse &current_validation) const;
+};
+
+template<
+    typename OrderExt = NoOrderExt,
+    typename MatchValidators = NoValidator,
+    typename NewValidators = NoValidator,
+    typename CancelValidators = NoValidator,
+    typename AmendValidators = Validators<OrderExt>>
+using ProRataMatching = PriceTimePriorityMatching<OrderExt, MatchValidators, NewValidators, CancelValidators,
+                                                  AmendValidators, ProRataAllocation>;
+
+template<typename OrderExt, typename MatchValidators, typename OrderContainer>
+void ProRataAllocation::operator()(ClientOrderRequest<OrderExt> &order_request,
+                                   OrderContainer &order_queue,
+                                   const PriceType &price,
+                                   PassiveOrderBook<OrderExt> &passive_order_book,
+                                   const InstrumentType &instrument,
+                                   IEngineEventObserver &observer,
+                                   const MatchValidators &match_validators,
+                                   ValidationResponse &current_validation) const {
+
+  const auto is_matchable = [&](const PassiveOrder<OrderExt> &passive_order) {
+    if (passive_order.getOpenSize() == 0) return false;
+    if constexpr (IsNoValidators<MatchValidators>::value) {
+      return true;
+    } else {
+      current_validation = match_validators.validate(order_request, passive_order_book, passive_order);
+      return current_validation == ValidationResponse::NO_ERROR;
+    }
+  };
+
+  // Without match validators every order of the level shares, the level size being theirs
+  SizeType level_size{order_queue.total_size_};
+  if constexpr (!IsNoValidators<MatchValidators>::value) {
+    level_size = 0;
+    for (const auto &passive_order_ptr : order_queue) {
+      if (is_matchable(*passive_order_ptr)) {
+        level_size += passive_order_ptr->getOpenSize();
+      } else if (isMatchingStopped(current_validation)) {
+        return;
+      }
+    }
+  }
+  if (level_size == 0 || order_request.size_ == 0) return;
+
+  const SizeType allocated_size = std::min(order_request.size_, level_size);
+  SizeType cumulative_size{0};
+  SizeType cumulative_allocated_size{0};
+  std::size_t kept{0};
+
+  // Orders done with are compacted out of the level along the way
+  for (std::size_t index = 0; index < order_queue.size(); index++) {
+    PassiveOrder<OrderExt> &passive_order = *order_queue[index];
+
+    if (is_matchable(passive_order)) {
+      cumulative_size += passive_order.getOpenSize();
+      // Widened as the product of two sizes may not fit a size
+      const auto allocated_up_to_order = static_cast<SizeType>(
+          (static_cast<unsigned __int128>(cumulative_size) * allocated_size + level_size - 1) / level_size);
+      const SizeType trade_size = allocated_up_to_order - cumulative_allocated_size;
+      cumulative_allocated_size = allocated_up_to_order;
+
+      if (trade_size > 0) {
+        // An iceberg may be allocated more than its shown slice, taken slice after slice from its reserve
+        for (SizeType left_size = trade_size; left_size > 0;) {
+          if (passive_order.remaining_size_ == 0) passive_order_book.replenishPassiveOrder(passive_order);
+          const SizeType fill_size = std::min(left_size, passive_order.remaining_size_);
+          passive_order_book.fillPassiveOrder(order_queue, passive_order, fill_size);
+          left_size -= fill_size;
+        }
+        if (passive_order.remaining_size_ == 0 && passive_order.reserve_size_ > 0) {
+          passive_order_book.replenishPassiveOrder(passive_order);
+        }
+
+        observer.doTradeEvent(
+            order_request.client_,
+            order_request.cln_order_id_,
+            passive_order.client_,
+            passive_order.cln_order_id_,
+            instrument,
+            price,
+            trade_size
+        );
+        passive_order_book.recordTrade(price);
+      }
+    }
+
+    if (passive_order.getOpenSize() > 0) {
+      if (kept != index) order_queue[kept] = std::move(order_queue[index]);
+      kept++;
+    }
+  }
+
+  order_queue.erase(order_queue.begin() + kept, order_queue.end());
+  order_request.size_ -= cumulative_allocated_size;
+
+}
+
+} // end of namespace
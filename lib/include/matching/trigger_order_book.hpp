@@ -0,0 +1,247 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+#include "events/client_order_request.h"
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Stop and stop limit orders waiting for their trigger, kept alongside the passive order book of an instrument.
+ *
+ * Orders are indexed by trigger price, each side ordered by which trigger a trade crosses first: buy stops trigger on
+ * trades at or above their trigger price, lowest first, sell stops on trades at or below it, highest first. A trade
+ * therefore only looks at the front of either side, and takes off just the levels it crossed, so a trade triggering
+ * nothing costs two comparisons whatever the number of stops waiting.
+ *
+ * Triggered orders queue up in trigger order (trigger price, then arrival) until taken by the matching algo,
+ * which enters them one by one, any trade of theirs triggering further orders at the back of the queue.
+ */
+template<typename OrderExt = void>
+class TriggerOrderBook final {
+ public:
+  using TriggerLevel = std::vector<ClientOrderRequest<OrderExt>>;
+  using BuyTriggerLevels = std::map<PriceType, TriggerLevel>;
+  using SellTriggerLevels = std::map<PriceType, TriggerLevel, std::greater<PriceType>>;
+
+  TriggerOrderBook() = default;
+  TriggerOrderBook(const TriggerOrderBook &) = default;
+  TriggerOrderBook(TriggerOrderBook &&) noexcept = default;
+  TriggerOrderBook &operator=(const TriggerOrderBook &) = default;
+  TriggerOrderBook &operator=(TriggerOrderBook &&) noexcept = default;
+  ~TriggerOrderBook() = default;
+
+  [[nodiscard]] const auto &getBuyTriggerLevels() const { return buy_triggers_; }
+  [[nodiscard]] const auto &getSellTriggerLevels() const { return sell_triggers_; }
+  [[nodiscard]] bool empty() const { return trigger_orders_map_.empty(); }
+
+  void placeTriggerOrder(const ClientOrderRequest<OrderExt> &order_request);
+
+  [[nodiscard]] bool isOrderExist(const ClientType &client, const OrderIDType &order_id) const;
+
+  // Returns nullptr if there is no such order waiting
+  [[nodiscard]] const ClientOrderRequest<OrderExt> *getTriggerOrder(const ClientType &client,
+                                                                    const OrderIDType &order_id) const;
+
+  // Returns false if there is no such order waiting
+  bool cancelTriggerOrder(const ClientType &client, const OrderIDType &order_id);
+
+  // Cancels every order of client, of side only when given, returns number of orders cancelled
+  std::size_t cancelClientOrders(const ClientType &client, const std::optional<OrderSide> &side = std::nullopt);
+
+  // Queues up orders triggered by a trade at trade_price
+  void triggerOrders(const PriceType &trade_price) {
+    if (!buy_triggers_.empty() && buy_triggers_.begin()->first <= trade_price) {
+      triggerLevels(buy_triggers_, trade_price);
+    }
+    if (!sell_triggers_.empty() && sell_triggers_.begin()->first >= trade_price) {
+      triggerLevels(sell_triggers_, trade_price);
+    }
+  }
+
+  // Triggered orders not yet taken, in trigger order
+  [[nodiscard]] bool hasTriggeredOrders() const { return !triggered_orders_.empty(); }
+
+  // Takes triggered orders one at a time, including those triggered meanwhile, until there is none left
+  template<typename F>
+  void takeTriggeredOrders(F &&f);
+
+ private:
+  template<typename TriggerLevels>
+  void triggerLevels(TriggerLevels &trigger_levels, const PriceType &trade_price);
+
+  template<typename TriggerLevels>
+  static const ClientOrderRequest<OrderExt> *findTriggerOrder(const TriggerLevels &trigger_levels,
+                                                              const PriceType &trigger_price,
+                                                              const ClientType &client,
+                                                              const OrderIDType &order_id);
+
+  template<typename TriggerLevels>
+  static void eraseTriggerOrder(TriggerLevels &trigger_levels,
+                                const PriceType &trigger_price,
+                                const ClientType &client,
+                                const OrderIDType &order_id);
+
+  BuyTriggerLevels buy_triggers_{};
+  SellTriggerLevels sell_triggers_{};
+
+  // Side and trigger price of waiting orders by ClientID-OrderID, for cancels to go straight to their level
+  struct TriggerOrderRef {
+    OrderSide side_{};
+    PriceType trigger_price_{};
+  };
+  std::unordered_map<ClientType, std::unordered_map<OrderIDType, TriggerOrderRef>> trigger_orders_map_{};
+
+  std::vector<ClientOrderRequest<OrderExt>> triggered_orders_{};
+  std::vector<ClientOrderRequest<OrderExt>> taking_orders_{};
+};
+
+template<typename OrderExt>
+void TriggerOrderBook<OrderExt>::placeTriggerOrder(const ClientOrderRequest<OrderExt> &order_request) {
+  if (order_request.side_ == OrderSide::BUY) {
+    buy_triggers_[order_request.trigger_price_].push_back(order_request);
+  } else {
+    sell_triggers_[order_request.trigger_price_].push_back(order_request);
+  }
+  trigger_orders_map_[order_request.client_][order_request.cln_order_id_] =
+      TriggerOrderRef{order_request.side_, order_request.trigger_price_};
+}
+
+template<typename OrderExt>
+bool TriggerOrderBook<OrderExt>::isOrderExist(const ClientType &client, const OrderIDType &order_id) const {
+  auto itr = trigger_orders_map_.find(client);
+  return itr != trigger_orders_map_.end() && itr->second.find(order_id) != itr->second.end();
+}
+
+template<typename OrderExt>
+const ClientOrderRequest<OrderExt> *TriggerOrderBook<OrderExt>::getTriggerOrder(const ClientType &client,
+                                                                                const OrderIDType &order_id) const {
+  auto client_itr = trigger_orders_map_.find(client);
+  if (client_itr == trigger_orders_map_.end()) return nullptr;
+  auto order_itr = client_itr->second.find(order_id);
+  if (order_itr == client_itr->second.end()) return nullptr;
+
+  const auto &[side, trigger_price] = order_itr->second;
+  return (side == OrderSide::BUY) ? findTriggerOrder(buy_triggers_, trigger_price, client, order_id)
+                                  : findTriggerOrder(sell_triggers_, trigger_price, client, order_id);
+}
+
+template<typename OrderExt>
+bool TriggerOrderBook<OrderExt>::cancelTriggerOrder(const ClientType &client, const OrderIDType &order_id) {
+  auto client_itr = trigger_orders_map_.find(client);
+  if (client_itr == trigger_orders_map_.end()) return false;
+  auto &order_id_map = client_itr->second;
+  auto order_itr = order_id_map.find(order_id);
+  if (order_itr == order_id_map.end()) return false;
+
+  const auto &[side, trigger_price] = order_itr->second;
+  if (side == OrderSide::BUY) {
+    eraseTriggerOrder(buy_triggers_, trigger_price, client, order_id);
+  } else {
+    eraseTriggerOrder(sell_triggers_, trigger_price, client, order_id);
+  }
+
+  order_id_map.erase(order_itr);
+  if (order_id_map.empty()) trigger_orders_map_.erase(client_itr);
+  return true;
+}
+
+template<typename OrderExt>
+std::size_t TriggerOrderBook<OrderExt>::cancelClientOrders(const ClientType &client,
+                                                           const std::optional<OrderSide> &side) {
+  auto client_itr = trigger_orders_map_.find(client);
+  if (client_itr == trigger_orders_map_.end()) return 0;
+  auto &order_id_map = client_itr->second;
+
+  std::size_t cancelled{0};
+  for (auto order_itr = order_id_map.begin(); order_itr != order_id_map.end();) {
+    const auto &[order_id, order_ref] = *order_itr;
+    if (side && order_ref.side_ != *side) {
+      ++order_itr;
+      continue;
+    }
+
+    if (order_ref.side_ == OrderSide::BUY) {
+      eraseTriggerOrder(buy_triggers_, order_ref.trigger_price_, client, order_id);
+    } else {
+      eraseTriggerOrder(sell_triggers_, order_ref.trigger_price_, client, order_id);
+    }
+    order_itr = order_id_map.erase(order_itr);
+    cancelled++;
+  }
+
+  if (order_id_map.empty()) trigger_orders_map_.erase(client_itr);
+  return cancelled;
+}
+
+template<typename OrderExt>
+template<typename TriggerLevels>
+void TriggerOrderBook<OrderExt>::triggerLevels(TriggerLevels &trigger_levels, const PriceType &trade_price) {
+  auto level_itr = trigger_levels.begin();
+  // Levels are ordered by which trigger a trade crosses first, the first level not crossed ends it
+  for (; level_itr != trigger_levels.end() && !trigger_levels.key_comp()(trade_price, level_itr->first);
+         level_itr++) {
+    for (auto &order_request : level_itr->second) {
+      auto client_itr = trigger_orders_map_.find(order_request.client_);
+      client_itr->second.erase(order_request.cln_order_id_);
+      if (client_itr->second.empty()) trigger_orders_map_.erase(client_itr);
+
+      triggered_orders_.push_back(std::move(order_request));
+    }
+  }
+  trigger_levels.erase(trigger_levels.begin(), level_itr);
+}
+
+template<typename OrderExt>
+template<typename F>
+void TriggerOrderBook<OrderExt>::takeTriggeredOrders(F &&f) {
+  // Orders triggered while taking queue up behind, so a cascade is worked through iteratively, in trigger order
+  while (!triggered_orders_.empty()) {
+    taking_orders_.swap(triggered_orders_);
+    for (auto &order_request : taking_orders_) {
+      f(order_request);
+    }
+    taking_orders_.clear();
+  }
+}
+
+template<typename OrderExt>
+template<typename TriggerLevels>
+const ClientOrderRequest<OrderExt> *TriggerOrderBook<OrderExt>::findTriggerOrder(const TriggerLevels &trigger_levels,
+                                                                                 const PriceType &trigger_price,
+                                                                                 const ClientType &client,
+                                                                                 const OrderIDType &order_id) {
+  auto level_itr = trigger_levels.find(trigger_price);
+  if (level_itr == trigger_levels.end()) return nullptr;
+
+  for (const auto &order_request : level_itr->second) {
+    if (order_request.client_ == client && order_request.cln_order_id_ == order_id) return &order_request;
+  }
+  return nullptr;
+}
+
+template<typename OrderExt>
+template<typename TriggerLevels>
+void TriggerOrderBook<OrderExt>::eraseTriggerOrder(TriggerLevels &trigger_levels,
+                                                   const PriceType &trigger_price,
+                                                   const ClientType &client,
+                                                   const OrderIDType &order_id) {
+  auto level_itr = trigger_levels.find(trigger_price);
+  if (level_itr == trigger_levels.end()) return;
+
+  auto &trigger_level = level_itr->second;
+  for (auto itr = trigger_level.begin(); itr != trigger_level.end(); itr++) {
+    if (itr->client_ == client && itr->cln_order_id_ == order_id) {
+      trigger_level.erase(itr);
+      if (trigger_level.empty()) trigger_levels.erase(level_itr);
+      return;
+    }
+  }
+}
+
+} // end of namespace
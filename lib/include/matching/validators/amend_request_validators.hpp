@@ -0,0 +1,21 @@
+#pragma once
+
+#include "interface/i_validator.hpp"
+#include "events/client_order_request.h"
+
+namespace codetest::matching_engine_sim {
+
+// For venues only supporting native amendment: size down at an unchanged price, the order keeping its priority
+template<typename OrderExt = void>
+struct InPlaceAmendOnlyValidator final : public IValidator<InPlaceAmendOnlyValidator<OrderExt>, OrderExt> {
+  ValidationResponse operator()(
+      const ClientOrderRequest<OrderExt> &order_request,
+      const PassiveOrderBook<OrderExt> &passive_order_book,
+      const PassiveOrder<OrderExt> &passive_order = PassiveOrder<OrderExt>()) override {
+    return order_request.price_ == passive_order.price_ && order_request.size_ <= passive_order.getOpenSize()
+           ? ValidationResponse::NO_ERROR
+           : ValidationResponse::INVALID_ORDER_REQUEST;
+  }
+};
+
+} // end of namespace
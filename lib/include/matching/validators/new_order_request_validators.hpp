@@ -11,7 +11,11 @@ struct NoSuchOrderInsertValidator final : public IValidator<NoSuchOrderInsertVal
       const ClientOrderRequest<OrderExt> &order_request,
       const PassiveOrderBook<OrderExt> &passive_order_book,
       const PassiveOrder<OrderExt> &passive_order = PassiveOrder<OrderExt>()) override {
-    return passive_order_book.isOrderExist(order_request.client_, order_request.cln_order_id_)
+    // An amendment losing priority is validated as a new order, replacing the resting order seen as passive order
+    const bool replacing = passive_order.getOpenSize() > 0
+        && passive_order.client_ == order_request.client_
+        && passive_order.cln_order_id_ == order_request.cln_order_id_;
+    return !replacing && passive_order_book.isOrderExist(order_request.client_, order_request.cln_order_id_)
            ? ValidationResponse::ORDER_ID_PREEXIST
            : ValidationResponse::NO_ERROR;
   }
@@ -34,4 +34,11 @@ struct Validators<OrderExt, V> {
   }
 };
 
+// Whether validators are empty and so never reject, for callers to skip work done only for the sake of validation
+template<typename V>
+struct IsNoValidators : std::false_type {};
+
+template<typename OrderExt>
+struct IsNoValidators<Validators<OrderExt>> : std::true_type {};
+
 } // end of namespace
\ No newline at end of file
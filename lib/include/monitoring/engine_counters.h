@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "types.h"
+#include "interface/i_engine_event_observer.h"
+
+namespace codetest::matching_engine_sim {
+
+constexpr std::size_t ENGINE_COUNTERS_CACHE_LINE_SIZE = 64;
+
+// Point in time copy of the counters of one instrument or one processor thread, summable for aggregation
+struct EngineCounters {
+  std::uint64_t requests_{};
+  std::uint64_t cancels_{};
+  std::uint64_t amends_{};
+  std::uint64_t mass_cancels_{};
+  std::uint64_t acks_{};
+  std::array<std::uint64_t, static_cast<std::size_t>(ValidationResponse::_RESPONSE_SIZE_)> nacks_{};
+  // Resting orders the engine took out of the book itself, e.g. on expiry
+  std::uint64_t unsolicited_cancels_{};
+  std::uint64_t trades_{};
+  std::uint64_t traded_volume_{};
+  // Largest batch of requests drained off a queue at once
+  std::uint64_t queue_depth_high_water_mark_{};
+  // Processor thread only, time spent in passes over its queues which found requests, or found none
+  std::chrono::nanoseconds busy_time_{};
+  std::chrono::nanoseconds idle_time_{};
+
+  [[nodiscard]] std::uint64_t getNacks() const;
+  [[nodiscard]] std::uint64_t getNacks(const ValidationResponse &validation_response) const {
+    return nacks_[static_cast<std::size_t>(validation_response)];
+  }
+
+  EngineCounters &operator+=(const EngineCounters &other);
+};
+
+/*
+ * Live counters of one instrument or one processor thread. Only ever written by the processor thread owning them,
+ * as relaxed atomic stores without read-modify-write, and readable from any thread. Each block starts on a cache line
+ * of its own, so blocks written by different threads never share one.
+ */
+class alignas(ENGINE_COUNTERS_CACHE_LINE_SIZE) EngineCounterBlock final {
+ public:
+  EngineCounterBlock() = default;
+  EngineCounterBlock(const EngineCounterBlock &) = delete;
+  EngineCounterBlock &operator=(const EngineCounterBlock &) = delete;
+  ~EngineCounterBlock() = default;
+
+  void countRequest(const OrderAction &order_action) {
+    increment(requests_, 1);
+    if (order_action == OrderAction::CANCEL) increment(cancels_, 1);
+    if (order_action == OrderAction::AMEND) increment(amends_, 1);
+    if (order_action == OrderAction::MASS_CANCEL || order_action == OrderAction::MASS_CANCEL_SIDE) {
+      increment(mass_cancels_, 1);
+    }
+  }
+
+  void countResponse(const OrderRequestResult &order_request_result, const ValidationResponse &validation_response) {
+    if (order_request_result == OrderRequestResult::ACK) {
+      increment(acks_, 1);
+    } else if (order_request_result == OrderRequestResult::CANCELLED) {
+      increment(unsolicited_cancels_, 1);
+    } else if (validation_response < ValidationResponse::_RESPONSE_SIZE_) {
+      increment(nacks_[static_cast<std::size_t>(validation_response)], 1);
+    }
+  }
+
+  void countTrade(const SizeType &size) {
+    increment(trades_, 1);
+    increment(traded_volume_, size);
+  }
+
+  void recordQueueDepth(const std::uint64_t &queue_depth) {
+    if (queue_depth > queue_depth_high_water_mark_.load(std::memory_order_relaxed)) {
+      queue_depth_high_water_mark_.store(queue_depth, std::memory_order_relaxed);
+    }
+  }
+
+  // Time stamp counter ticks of one pass over the queues of a processor thread
+  void addPassTime(const bool &busy, const std::uint64_t &ticks) { increment(busy ? busy_ticks_ : idle_ticks_, ticks); }
+
+  [[nodiscard]] EngineCounters read() const;
+
+ private:
+  static void increment(std::atomic<std::uint64_t> &counter, const std::uint64_t &value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  std::atomic<std::uint64_t> requests_{};
+  std::atomic<std::uint64_t> cancels_{};
+  std::atomic<std::uint64_t> amends_{};
+  std::atomic<std::uint64_t> mass_cancels_{};
+  std::atomic<std::uint64_t> acks_{};
+  std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(ValidationResponse::_RESPONSE_SIZE_)> nacks_{};
+  std::atomic<std::uint64_t> unsolicited_cancels_{};
+  std::atomic<std::uint64_t> trades_{};
+  std::atomic<std::uint64_t> traded_volume_{};
+  std::atomic<std::uint64_t> queue_depth_high_water_mark_{};
+  std::atomic<std::uint64_t> busy_ticks_{};
+  std::atomic<std::uint64_t> idle_ticks_{};
+};
+
+// Counts engine events into the processor thread block and the block of the instrument being processed,
+// forwarding every event downstream
+class CountingEngineEventObserver final : public IEngineEventObserver {
+ public:
+  CountingEngineEventObserver(EngineCounterBlock &thread_counters,
+                              const std::shared_ptr<IEngineEventObserver> &downstream_observer)
+      : thread_counters_(thread_counters), downstream_observer_(downstream_observer) {}
+
+  void setInstrumentCounters(EngineCounterBlock *instrument_counters) { instrument_counters_ = instrument_counters; }
+
+  void doTradeEvent(
+      const ClientType &client1,
+      const OrderIDType &client1_order_id,
+      const ClientType &client2,
+      const OrderIDType &client2_order_id,
+      const InstrumentType &instrument,
+      const PriceType &trade_price,
+      const SizeType &size) override {
+    thread_counters_.countTrade(size);
+    if (instrument_counters_) instrument_counters_->countTrade(size);
+    downstream_observer_->doTradeEvent(client1, client1_order_id, client2, client2_order_id, instrument,
+                                       trade_price, size);
+  }
+
+  void doOrderRequestResponse(
+      const ClientType &client,
+      const OrderIDType &client_order_id,
+      const InstrumentType &instrument,
+      const PriceType &order_price,
+      const SizeType &order_size,
+      const OrderRequestResult &order_request_result,
+      const ValidationResponse &validation_response) override {
+    thread_counters_.countResponse(order_request_result, validation_response);
+    if (instrument_counters_) instrument_counters_->countResponse(order_request_result, validation_response);
+    downstream_observer_->doOrderRequestResponse(client, client_order_id, instrument, order_price, order_size,
+                                                 order_request_result, validation_response);
+  }
+
+  void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) override {
+    downstream_observer_->setClientMap(clients);
+  }
+
+ private:
+  EngineCounterBlock &thread_counters_;
+  EngineCounterBlock *instrument_counters_{nullptr};
+  std::shared_ptr<IEngineEventObserver> downstream_observer_{};
+};
+
+} // end of namespace
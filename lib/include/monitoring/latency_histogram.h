@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Log-linear histogram in the manner of HdrHistogram, covering the whole uint64 range at a fixed relative precision.
+ * Values below SUB_BUCKET_COUNT are counted exactly, every further power of two is split into SUB_BUCKET_COUNT
+ * equal buckets, so a reported value is at most 1/SUB_BUCKET_COUNT above the value recorded.
+ *
+ * A histogram has a single writer and is lock free: counts are relaxed atomics only ever stored by the writer thread,
+ * hence readable from any other thread at any time, at the cost of a slightly stale view.
+ */
+class LatencyHistogram final {
+ public:
+  static constexpr unsigned SUB_BUCKET_BITS = 5;
+  static constexpr std::size_t SUB_BUCKET_COUNT = std::size_t{1} << SUB_BUCKET_BITS;
+  static constexpr std::size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (64 - SUB_BUCKET_BITS + 1);
+
+  LatencyHistogram() = default;
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+  ~LatencyHistogram() = default;
+
+  // Writer thread only
+  void record(const std::uint64_t &value) noexcept {
+    increment(counts_[bucketIndex(value)], 1);
+    increment(total_count_, 1);
+    increment(total_value_, value);
+    if (value > max_.load(std::memory_order_relaxed)) max_.store(value, std::memory_order_relaxed);
+  }
+
+  // Adds every count of other, writer thread of this histogram only
+  void merge(const LatencyHistogram &other);
+
+  [[nodiscard]] std::uint64_t getCount() const { return total_count_.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::uint64_t getMax() const { return max_.load(std::memory_order_relaxed); }
+  [[nodiscard]] double getMean() const;
+
+  // Smallest recorded value at or above which lie no more than (100 - percentile)% of the values, up to precision
+  [[nodiscard]] std::uint64_t getValueAtPercentile(const double &percentile) const;
+
+  [[nodiscard]] static constexpr std::size_t bucketIndex(const std::uint64_t &value) {
+    if (value < SUB_BUCKET_COUNT) return static_cast<std::size_t>(value);
+    const unsigned magnitude = 63 - static_cast<unsigned>(__builtin_clzll(value));
+    const auto sub_bucket = static_cast<std::size_t>(value >> (magnitude - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    return SUB_BUCKET_COUNT * (magnitude - SUB_BUCKET_BITS + 1) + sub_bucket;
+  }
+
+  // Largest value counted into bucket at index
+  [[nodiscard]] static constexpr std::uint64_t bucketHighestValue(const std::size_t &index) {
+    if (index < SUB_BUCKET_COUNT) return index;
+    const unsigned magnitude = static_cast<unsigned>(index / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+    const std::uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+    const unsigned width_bits = magnitude - SUB_BUCKET_BITS;
+    const std::uint64_t lowest = (std::uint64_t{1} << magnitude) | (sub_bucket << width_bits);
+    return lowest + ((std::uint64_t{1} << width_bits) - 1);
+  }
+
+ private:
+  // Single writer, no read-modify-write instruction required
+  static void increment(std::atomic<std::uint64_t> &counter, const std::uint64_t &value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> counts_{};
+  std::atomic<std::uint64_t> total_count_{};
+  std::atomic<std::uint64_t> total_value_{};
+  std::atomic<std::uint64_t> max_{};
+};
+
+static_assert(LatencyHistogram::bucketIndex(~std::uint64_t{0}) == LatencyHistogram::BUCKET_COUNT - 1);
+static_assert(LatencyHistogram::bucketHighestValue(LatencyHistogram::BUCKET_COUNT - 1) == ~std::uint64_t{0});
+
+} // end of namespace
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "interface/i_engine_event_observer.h"
+#include "monitoring/latency_histogram.h"
+#include "monitoring/latency_tracking_options.h"
+
+namespace codetest::matching_engine_sim {
+
+// Time stamp counter where available, steady clock nanoseconds otherwise
+inline std::uint64_t readTimestampCounter() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Measured once against steady clock on first use, assumes an invariant time stamp counter
+double timestampCounterTicksPerNanosecond();
+
+// Stages between the time stamps taken at submission, dequeue, first event dispatched and matching done
+enum class LatencyStage : std::uint8_t {
+  QUEUEING = 0,       // submission to dequeue by the processor thread
+  FIRST_EVENT = 1,    // dequeue to first engine event dispatched
+  PROCESSING = 2,     // dequeue to matching done, every event dispatched
+  END_TO_END = 3,     // submission to matching done
+  _STAGE_SIZE_ = 4
+};
+
+[[nodiscard]] const char *toString(const LatencyStage &latency_stage);
+
+// Histograms of one processor thread, in time stamp counter ticks
+class LatencyTracker final {
+ public:
+  LatencyTracker() = default;
+  LatencyTracker(const LatencyTracker &) = delete;
+  LatencyTracker &operator=(const LatencyTracker &) = delete;
+  ~LatencyTracker() = default;
+
+  // Processor thread only, first_event of 0 means no event was dispatched
+  void recordRequest(const std::uint64_t &submitted,
+                     const std::uint64_t &dequeued,
+                     const std::uint64_t &first_event,
+                     const std::uint64_t &matched) noexcept;
+
+  [[nodiscard]] const LatencyHistogram &getHistogram(const LatencyStage &latency_stage) const {
+    return histograms_[static_cast<std::size_t>(latency_stage)];
+  }
+
+ private:
+  std::array<LatencyHistogram, static_cast<std::size_t>(LatencyStage::_STAGE_SIZE_)> histograms_{};
+};
+
+// Forwards engine events downstream, remembering when the first event of the current request was dispatched
+class LatencyStampingObserver final : public IEngineEventObserver {
+ public:
+  explicit LatencyStampingObserver(const std::shared_ptr<IEngineEventObserver> &downstream_observer)
+      : downstream_observer_(downstream_observer) {}
+
+  void beginRequest() { first_event_ = 0; }
+  [[nodiscard]] std::uint64_t getFirstEventTimestamp() const { return first_event_; }
+
+  void doTradeEvent(
+      const ClientType &client1,
+      const OrderIDType &client1_order_id,
+      const ClientType &client2,
+      const OrderIDType &client2_order_id,
+      const InstrumentType &instrument,
+      const PriceType &trade_price,
+      const SizeType &size) override {
+    if (first_event_ == 0) first_event_ = readTimestampCounter();
+    downstream_observer_->doTradeEvent(client1, client1_order_id, client2, client2_order_id, instrument,
+                                       trade_price, size);
+  }
+
+  void doOrderRequestResponse(
+      const ClientType &client,
+      const OrderIDType &client_order_id,
+      const InstrumentType &instrument,
+      const PriceType &order_price,
+      const SizeType &order_size,
+      const OrderRequestResult &order_request_result,
+      const ValidationResponse &validation_response) override {
+    if (first_event_ == 0) first_event_ = readTimestampCounter();
+    downstream_observer_->doOrderRequestResponse(client, client_order_id, instrument, order_price, order_size,
+                                                 order_request_result, validation_response);
+  }
+
+  void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) override {
+    downstream_observer_->setClientMap(clients);
+  }
+
+ private:
+  std::shared_ptr<IEngineEventObserver> downstream_observer_{};
+  std::uint64_t first_event_{};
+};
+
+// One line per stage with count, mean and percentiles in nanoseconds, for every tracker and all of them combined
+void writeLatencyReport(std::ostream &os, const std::vector<const LatencyTracker *> &latency_trackers);
+
+} // end of namespace
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+namespace codetest::matching_engine_sim {
+
+struct LatencyTrackingOptions {
+  // Time stamps every request at submission, dequeue, first event dispatched and matching done
+  bool enabled_{false};
+  // Latency report of every processor thread is written here on terminate, if given
+  std::string report_path_{};
+};
+
+} // end of namespace
@@ -0,0 +1,372 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include "types.h"
+#include "matching/passive_order_book.hpp"
+#include "persistence/mapped_file.h"
+#include "persistence/order_ext_codec.h"
+#include "persistence/request_journal.hpp"
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Snapshot layout
+ *
+ * BookSnapshotHeader
+ * bid levels, best price first, followed by ask levels, best price first, each as
+ *   BookSnapshotLevel followed by its orders in time priority as fixed size BookSnapshotOrder records
+ * peg queues, bid primary and mid followed by ask primary and mid, each as a BookSnapshotLevel without price
+ *   followed by its orders in time priority
+ * BookSnapshotTriggers followed by stop orders waiting for their trigger, buys then sells in trigger order,
+ *   each as a journal record
+ *
+ * Cancelled orders still sitting in the level queues are left out, the ClientID-OrderID index is rebuilt on load.
+ */
+
+constexpr std::uint64_t BOOK_SNAPSHOT_MAGIC{0x3150414E53454DULL}; // "MESNAP1"
+constexpr std::uint32_t BOOK_SNAPSHOT_VERSION{6};
+
+struct BookSnapshotHeader {
+  std::uint64_t magic_{BOOK_SNAPSHOT_MAGIC};
+  std::uint32_t version_{BOOK_SNAPSHOT_VERSION};
+  std::uint32_t order_record_size_{};
+  InstrumentType instrument_{};
+  // Journal position of the first request not reflected in the snapshot
+  JournalPosition journal_position_{};
+  std::uint32_t bid_level_count_{};
+  std::uint32_t ask_level_count_{};
+  std::uint64_t order_count_{};
+  std::uint64_t reserved_{};
+};
+static_assert(sizeof(BookSnapshotHeader) == 64);
+
+struct BookSnapshotLevel {
+  PriceType price_{};
+  std::uint64_t order_count_{};
+};
+
+struct BookSnapshotOrder {
+  ClientType client_{};
+  OrderIDType cln_order_id_{};
+  SizeType remaining_size_{};
+  std::uint64_t has_custom_fields_{};
+  // Good till time orders only, 0 for orders resting until cancelled
+  std::uint64_t expire_time_{};
+  // Iceberg orders only, remaining size being the size of the slice shown
+  SizeType display_size_{};
+  SizeType reserve_size_{};
+};
+
+struct BookSnapshotTriggers {
+  // Stop orders placed after the snapshot trigger on it as they would have on the original book
+  PriceType last_trade_price_{};
+  std::uint64_t order_count_{};
+};
+
+template<typename OrderExt>
+constexpr std::size_t BOOK_SNAPSHOT_ORDER_SIZE =
+    (sizeof(BookSnapshotOrder) + OrderExtCodec<OrderExt>::ENCODED_SIZE + 7) & ~static_cast<std::size_t>(7);
+
+[[nodiscard]] inline std::string bookSnapshotFileName(const InstrumentType &instrument) {
+  char file_name[48];
+  std::snprintf(file_name, sizeof(file_name), "book_%llu.snap", static_cast<unsigned long long>(instrument));
+  return file_name;
+}
+
+namespace {
+
+// Upper bound of snapshot size, cancelled orders included
+template<typename OrderExt, typename OrderQueues>
+std::size_t bookSnapshotCapacity(const OrderQueues &order_queues) {
+  std::size_t capacity{0};
+  for (const auto &[price, order_queue] : order_queues) {
+    capacity += sizeof(BookSnapshotLevel) + order_queue.size() * BOOK_SNAPSHOT_ORDER_SIZE<OrderExt>;
+  }
+  return capacity;
+}
+
+template<typename OrderExt>
+std::size_t bookSnapshotPegQueuesCapacity(const PassiveOrderBook<OrderExt> &passive_order_book) {
+  std::size_t capacity{0};
+  for (const auto &side : {OrderSide::BUY, OrderSide::SELL}) {
+    for (const auto &peg_type : {OrderType::PRIMARY_PEG, OrderType::MID_PEG}) {
+      capacity += sizeof(BookSnapshotLevel)
+          + passive_order_book.getPegQueue(side, peg_type).size() * BOOK_SNAPSHOT_ORDER_SIZE<OrderExt>;
+    }
+  }
+  return capacity;
+}
+
+template<typename OrderExt>
+std::size_t bookSnapshotTriggersCapacity(const TriggerOrderBook<OrderExt> &trigger_order_book) {
+  std::size_t order_count{0};
+  for (const auto &[trigger_price, trigger_level] : trigger_order_book.getBuyTriggerLevels()) {
+    order_count += trigger_level.size();
+  }
+  for (const auto &[trigger_price, trigger_level] : trigger_order_book.getSellTriggerLevels()) {
+    order_count += trigger_level.size();
+  }
+  return sizeof(BookSnapshotTriggers) + order_count * JOURNAL_RECORD_SIZE<OrderExt>;
+}
+
+template<typename OrderExt>
+char *writeBookSnapshotTriggers(const PassiveOrderBook<OrderExt> &passive_order_book, char *cursor) {
+  BookSnapshotTriggers triggers{passive_order_book.getLastTradePrice(), 0};
+  char *triggers_cursor = cursor;
+  cursor += sizeof(BookSnapshotTriggers);
+
+  const auto write_trigger_levels = [&](const auto &trigger_levels) {
+    for (const auto &[trigger_price, trigger_level] : trigger_levels) {
+      for (const auto &order_request : trigger_level) {
+        encodeJournalRecord(order_request, triggers.order_count_++, 0, cursor);
+        cursor += JOURNAL_RECORD_SIZE<OrderExt>;
+      }
+    }
+  };
+  write_trigger_levels(passive_order_book.getTriggerOrderBook().getBuyTriggerLevels());
+  write_trigger_levels(passive_order_book.getTriggerOrderBook().getSellTriggerLevels());
+
+  std::memcpy(triggers_cursor, &triggers, sizeof(triggers));
+  return cursor;
+}
+
+template<typename OrderExt>
+const char *readBookSnapshotTriggers(const char *cursor,
+                                     const char *end,
+                                     PassiveOrderBook<OrderExt> &passive_order_book) {
+  if (cursor + sizeof(BookSnapshotTriggers) > end) throw std::runtime_error("truncated book snapshot");
+
+  BookSnapshotTriggers triggers;
+  std::memcpy(&triggers, cursor, sizeof(triggers));
+  cursor += sizeof(BookSnapshotTriggers);
+
+  if (cursor + triggers.order_count_ * JOURNAL_RECORD_SIZE<OrderExt> > end) {
+    throw std::runtime_error("truncated book snapshot");
+  }
+
+  // Last trade goes in first, while there is no stop order yet for it to trigger
+  if (triggers.last_trade_price_ > 0) passive_order_book.recordTrade(triggers.last_trade_price_);
+
+  for (std::uint64_t order_index = 0; order_index < triggers.order_count_; order_index++) {
+    ClientOrderRequest<OrderExt> order_request;
+    std::uint64_t sequence{}, request_time{};
+    if (!decodeJournalRecord(cursor, order_request, sequence, request_time)) {
+      throw std::runtime_error("corrupt book snapshot");
+    }
+    passive_order_book.placeTriggerOrder(order_request);
+    cursor += JOURNAL_RECORD_SIZE<OrderExt>;
+  }
+  return cursor;
+}
+
+// Writes orders of order_queue left to fill, in time priority, counting them into order_count
+template<typename OrderExt, typename OrderContainer>
+char *writeBookSnapshotOrders(const OrderContainer &order_queue, char *cursor, std::uint64_t &order_count) {
+  for (const auto &passive_order : order_queue) {
+    if (passive_order->remaining_size_ == 0) continue;
+
+    BookSnapshotOrder order{passive_order->client_,
+                            passive_order->cln_order_id_,
+                            passive_order->remaining_size_,
+                            passive_order->custom_fields_ ? 1U : 0U,
+                            passive_order->expire_time_,
+                            passive_order->display_size_,
+                            passive_order->reserve_size_};
+    std::memcpy(cursor, &order, sizeof(order));
+    if (order.has_custom_fields_) {
+      OrderExtCodec<OrderExt>::encode(passive_order->custom_fields_, cursor + sizeof(BookSnapshotOrder));
+    }
+    cursor += BOOK_SNAPSHOT_ORDER_SIZE<OrderExt>;
+    order_count++;
+  }
+  return cursor;
+}
+
+template<typename OrderExt>
+const char *readBookSnapshotOrders(const char *cursor,
+                                   const char *end,
+                                   const std::uint64_t &order_count,
+                                   const OrderSide &side,
+                                   const OrderType &order_type,
+                                   const PriceType &price,
+                                   PassiveOrderBook<OrderExt> &passive_order_book) {
+  if (cursor + order_count * BOOK_SNAPSHOT_ORDER_SIZE<OrderExt> > end) {
+    throw std::runtime_error("truncated book snapshot");
+  }
+
+  for (std::uint64_t order_index = 0; order_index < order_count; order_index++) {
+    BookSnapshotOrder order;
+    std::memcpy(&order, cursor, sizeof(order));
+    passive_order_book.placePassiveOrder(
+        order.client_,
+        order.cln_order_id_,
+        order_type,
+        side,
+        price,
+        order.remaining_size_ + order.reserve_size_,
+        order.has_custom_fields_ ? OrderExtCodec<OrderExt>::decode(cursor + sizeof(BookSnapshotOrder)) : nullptr,
+        order.expire_time_,
+        order.display_size_);
+    // An iceberg is placed showing a full slice, when it may have been partly filled
+    if (order.reserve_size_ > 0) {
+      auto passive_order = passive_order_book.getEngineOrderFromCache(order.client_, order.cln_order_id_);
+      passive_order->remaining_size_ = order.remaining_size_;
+      passive_order->reserve_size_ = order.reserve_size_;
+    }
+    cursor += BOOK_SNAPSHOT_ORDER_SIZE<OrderExt>;
+  }
+  return cursor;
+}
+
+template<typename OrderExt, typename OrderQueues>
+char *writeBookSnapshotLevels(const OrderQueues &order_queues,
+                              char *cursor,
+                              std::uint32_t &level_count,
+                              std::uint64_t &order_count) {
+  for (const auto &[price, order_queue] : order_queues) {
+    BookSnapshotLevel level{price, 0};
+    char *level_cursor = cursor;
+    cursor += sizeof(BookSnapshotLevel);
+    cursor = writeBookSnapshotOrders<OrderExt>(order_queue, cursor, level.order_count_);
+
+    // Levels left with cancelled orders only are dropped
+    if (level.order_count_ == 0) {
+      cursor = level_cursor;
+      continue;
+    }
+
+    std::memcpy(level_cursor, &level, sizeof(level));
+    level_count++;
+    order_count += level.order_count_;
+  }
+  return cursor;
+}
+
+template<typename OrderExt>
+const char *readBookSnapshotLevels(const char *cursor,
+                                   const char *end,
+                                   const std::uint32_t &level_count,
+                                   const OrderSide &side,
+                                   PassiveOrderBook<OrderExt> &passive_order_book) {
+  for (std::uint32_t level_index = 0; level_index < level_count; level_index++) {
+    if (cursor + sizeof(BookSnapshotLevel) > end) throw std::runtime_error("truncated book snapshot");
+
+    BookSnapshotLevel level;
+    std::memcpy(&level, cursor, sizeof(level));
+    cursor += sizeof(BookSnapshotLevel);
+    cursor = readBookSnapshotOrders(cursor, end, level.order_count_, side, OrderType::LIMIT, level.price_,
+                                    passive_order_book);
+  }
+  return cursor;
+}
+
+template<typename OrderExt>
+char *writeBookSnapshotPegQueues(const PassiveOrderBook<OrderExt> &passive_order_book,
+                                 char *cursor,
+                                 std::uint64_t &order_count) {
+  for (const auto &side : {OrderSide::BUY, OrderSide::SELL}) {
+    for (const auto &peg_type : {OrderType::PRIMARY_PEG, OrderType::MID_PEG}) {
+      BookSnapshotLevel peg_queue{0, 0};
+      char *peg_queue_cursor = cursor;
+      cursor += sizeof(BookSnapshotLevel);
+      cursor = writeBookSnapshotOrders<OrderExt>(passive_order_book.getPegQueue(side, peg_type), cursor,
+                                                 peg_queue.order_count_);
+      std::memcpy(peg_queue_cursor, &peg_queue, sizeof(peg_queue));
+      order_count += peg_queue.order_count_;
+    }
+  }
+  return cursor;
+}
+
+template<typename OrderExt>
+const char *readBookSnapshotPegQueues(const char *cursor,
+                                      const char *end,
+                                      PassiveOrderBook<OrderExt> &passive_order_book) {
+  for (const auto &side : {OrderSide::BUY, OrderSide::SELL}) {
+    for (const auto &peg_type : {OrderType::PRIMARY_PEG, OrderType::MID_PEG}) {
+      if (cursor + sizeof(BookSnapshotLevel) > end) throw std::runtime_error("truncated book snapshot");
+
+      BookSnapshotLevel peg_queue;
+      std::memcpy(&peg_queue, cursor, sizeof(peg_queue));
+      cursor += sizeof(BookSnapshotLevel);
+      cursor = readBookSnapshotOrders(cursor, end, peg_queue.order_count_, side, peg_type, 0, passive_order_book);
+    }
+  }
+  return cursor;
+}
+
+} // end of anonymous local namespace
+
+// Writes passive_order_book into a snapshot file at path, returns the snapshot size in bytes.
+// The file is written aside and renamed into place, so a reader never observes a partial snapshot.
+template<typename OrderExt>
+std::size_t saveBookSnapshot(const std::string &path,
+                             const PassiveOrderBook<OrderExt> &passive_order_book,
+                             const InstrumentType &instrument,
+                             const JournalPosition &journal_position = JournalPosition{}) {
+  const auto &bid_order_queues = passive_order_book.getBidOrderQueue();
+  const auto &ask_order_queues = passive_order_book.getAskOrderQueue();
+
+  const std::size_t capacity = sizeof(BookSnapshotHeader)
+      + bookSnapshotCapacity<OrderExt>(bid_order_queues)
+      + bookSnapshotCapacity<OrderExt>(ask_order_queues)
+      + bookSnapshotPegQueuesCapacity(passive_order_book)
+      + bookSnapshotTriggersCapacity(passive_order_book.getTriggerOrderBook());
+
+  const auto staging_path = path + ".tmp";
+  MappedFile snapshot_file{staging_path, MappedFile::Mode::READ_WRITE, capacity};
+
+  BookSnapshotHeader header;
+  header.order_record_size_ = static_cast<std::uint32_t>(BOOK_SNAPSHOT_ORDER_SIZE<OrderExt>);
+  header.instrument_ = instrument;
+  header.journal_position_ = journal_position;
+
+  char *cursor = snapshot_file.data() + sizeof(BookSnapshotHeader);
+  cursor = writeBookSnapshotLevels<OrderExt>(bid_order_queues, cursor, header.bid_level_count_, header.order_count_);
+  cursor = writeBookSnapshotLevels<OrderExt>(ask_order_queues, cursor, header.ask_level_count_, header.order_count_);
+  cursor = writeBookSnapshotPegQueues(passive_order_book, cursor, header.order_count_);
+  cursor = writeBookSnapshotTriggers(passive_order_book, cursor);
+  std::memcpy(snapshot_file.data(), &header, sizeof(header));
+
+  const auto size = static_cast<std::size_t>(cursor - snapshot_file.data());
+  snapshot_file.sync(0, size, true);
+  snapshot_file.close(size);
+  std::filesystem::rename(staging_path, path);
+  return size;
+}
+
+// Rebuilds passive_order_book, expected to be empty, from the snapshot file at path
+template<typename OrderExt>
+BookSnapshotHeader loadBookSnapshot(const std::string &path, PassiveOrderBook<OrderExt> &passive_order_book) {
+  MappedFile snapshot_file{path, MappedFile::Mode::READ_ONLY};
+  snapshot_file.adviseSequential();
+
+  if (snapshot_file.size() < sizeof(BookSnapshotHeader)) {
+    throw std::runtime_error("truncated book snapshot " + path);
+  }
+
+  BookSnapshotHeader header;
+  std::memcpy(&header, snapshot_file.data(), sizeof(header));
+  if (header.magic_ != BOOK_SNAPSHOT_MAGIC || header.version_ != BOOK_SNAPSHOT_VERSION) {
+    throw std::runtime_error("unrecognised book snapshot " + path);
+  }
+  if (header.order_record_size_ != BOOK_SNAPSHOT_ORDER_SIZE<OrderExt>) {
+    throw std::runtime_error("book snapshot order record size does not match order extension " + path);
+  }
+
+  const char *end = snapshot_file.data() + snapshot_file.size();
+  const char *cursor = snapshot_file.data() + sizeof(BookSnapshotHeader);
+  cursor = readBookSnapshotLevels(cursor, end, header.bid_level_count_, OrderSide::BUY, passive_order_book);
+  cursor = readBookSnapshotLevels(cursor, end, header.ask_level_count_, OrderSide::SELL, passive_order_book);
+  cursor = readBookSnapshotPegQueues(cursor, end, passive_order_book);
+  readBookSnapshotTriggers(cursor, end, passive_order_book);
+
+  return header;
+}
+
+} // end of namespace
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace codetest::matching_engine_sim {
+
+enum class JournalFlushPolicy : std::uint8_t {
+  NONE = 0,           // leave write back to the kernel page cache
+  PER_BATCH = 1,      // synchronously flush every request batch before it is matched
+  FSYNC_INTERVAL = 2  // synchronously flush at most once per fsync_interval_
+};
+
+struct JournalOptions {
+  // Journal is disabled when no directory is given
+  std::string directory_{};
+  JournalFlushPolicy flush_policy_{JournalFlushPolicy::NONE};
+  std::chrono::milliseconds fsync_interval_{std::chrono::milliseconds(100)};
+  std::size_t segment_size_{64 * 1024 * 1024};
+  // Rebuild order books from journal found in directory_ before accepting any request
+  bool replay_on_start_{false};
+
+  [[nodiscard]] bool isEnabled() const { return !directory_.empty(); }
+};
+
+} // end of namespace
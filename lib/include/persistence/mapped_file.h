@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace codetest::matching_engine_sim {
+
+// RAII wrapper of a file mapped into memory with MAP_SHARED,
+// used as the building block of journal, snapshot and tape files
+class MappedFile final {
+ public:
+  enum class Mode : std::uint8_t {
+    READ_ONLY = 0,
+    READ_WRITE = 1
+  };
+
+  MappedFile() = default;
+  // READ_WRITE creates (or truncates) the file to exactly size bytes; READ_ONLY maps the whole existing file
+  MappedFile(const std::string &path, const Mode &mode, const std::size_t &size = 0);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  ~MappedFile();
+
+  [[nodiscard]] char *data() { return data_; }
+  [[nodiscard]] const char *data() const { return data_; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool isOpen() const { return fd_ >= 0; }
+  [[nodiscard]] const std::string &path() const { return path_; }
+
+  // Flushes [offset, offset + length) to the file, expanding to page boundaries as msync requires
+  void sync(const std::size_t &offset, const std::size_t &length, const bool &blocking);
+
+  // Hints the kernel the mapping is going to be read front to back
+  void adviseSequential();
+
+  // Unmaps and closes; a writable file is truncated to final_size when given
+  void close();
+  void close(const std::size_t &final_size);
+
+ private:
+  std::string path_{};
+  char *data_{nullptr};
+  std::size_t size_{};
+  int fd_{-1};
+  Mode mode_{Mode::READ_ONLY};
+};
+
+} // end of namespace
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "types.h"
+#include "events/client_order_request.h"
+
+namespace codetest::matching_engine_sim {
+
+struct UnspecialisedOrderExtCodec {};
+
+// Binary encoding of the custom order fields for journal and snapshot files, the extension point for persisting a
+// user custom type: specialise it with ENCODED_SIZE, encode and decode as below.
+// A custom type without a specialisation still compiles and matches, but an order carrying it cannot be persisted,
+// and a matching engine refuses journaling and snapshots for it.
+template<typename OrderExt>
+struct OrderExtCodec : UnspecialisedOrderExtCodec {
+  static constexpr std::size_t ENCODED_SIZE = 0;
+
+  static void encode(const std::shared_ptr<OrderExt> &, char *) {
+    throw std::logic_error("no OrderExtCodec specialised to persist custom order fields");
+  }
+  [[nodiscard]] static std::shared_ptr<OrderExt> decode(const char *) {
+    throw std::logic_error("no OrderExtCodec specialised to restore custom order fields");
+  }
+};
+
+template<typename OrderExt>
+struct HasOrderExtCodec
+    : std::bool_constant<!std::is_base_of_v<UnspecialisedOrderExtCodec, OrderExtCodec<OrderExt>>> {};
+
+template<>
+struct OrderExtCodec<void> {
+  static constexpr std::size_t ENCODED_SIZE = 0;
+
+  static void encode(const std::shared_ptr<void> &, char *) {}
+  [[nodiscard]] static std::shared_ptr<void> decode(const char *) { return nullptr; }
+};
+
+template<>
+struct OrderExtCodec<MinExecQtyExtension> {
+  static constexpr std::size_t ENCODED_SIZE = sizeof(SizeType);
+
+  static void encode(const std::shared_ptr<MinExecQtyExtension> &custom_fields, char *buffer) {
+    std::memcpy(buffer, &custom_fields->min_exec_qty_, sizeof(SizeType));
+  }
+
+  [[nodiscard]] static std::shared_ptr<MinExecQtyExtension> decode(const char *buffer) {
+    SizeType min_exec_qty{};
+    std::memcpy(&min_exec_qty, buffer, sizeof(SizeType));
+    return std::make_shared<MinExecQtyExtension>(min_exec_qty);
+  }
+};
+
+} // end of namespace
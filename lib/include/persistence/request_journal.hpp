@@ -0,0 +1,407 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+#include "events/client_order_request.h"
+#include "persistence/mapped_file.h"
+#include "persistence/journal_options.h"
+#include "persistence/order_ext_codec.h"
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Journal layout
+ *
+ * One journal per processor thread per engine run (epoch), split into fixed size segment files
+ *   journal_<epoch>_<thread>_<segment>.bin
+ * Each segment is a JournalSegmentHeader followed by fixed size records.
+ * A record is only valid once its marker is stamped, which is done after the record body is written,
+ * so a torn tail after a crash is detected and ignored by the reader.
+ * Each record carries the engine clock its batch was processed at, so that replay expires good till time orders
+ * exactly when the live run did.
+ */
+
+constexpr std::uint64_t JOURNAL_MAGIC{0x314C4E524A454DULL}; // "MEJRNL1"
+constexpr std::uint32_t JOURNAL_VERSION{6};
+constexpr std::uint32_t JOURNAL_RECORD_MARKER{0x5EC0A1EDU};
+
+// Identifies a point of the input stream, records of an epoch are ordered by sequence
+struct JournalPosition {
+  std::uint64_t epoch_{};
+  std::uint64_t sequence_{};
+
+  [[nodiscard]] bool operator<(const JournalPosition &rhs) const {
+    return std::tie(epoch_, sequence_) < std::tie(rhs.epoch_, rhs.sequence_);
+  }
+};
+
+struct JournalSegmentHeader {
+  std::uint64_t magic_{JOURNAL_MAGIC};
+  std::uint32_t version_{JOURNAL_VERSION};
+  std::uint32_t record_size_{};
+  std::uint64_t epoch_{};
+  std::uint64_t segment_index_{};
+  std::uint64_t first_sequence_{};
+  std::uint32_t thread_index_{};
+  std::uint32_t reserved_{};
+  std::uint64_t padding_[2]{};
+};
+static_assert(sizeof(JournalSegmentHeader) == 64);
+
+struct JournalRecord {
+  std::uint32_t marker_{};
+  std::uint8_t side_{};
+  std::uint8_t order_action_{};
+  std::uint8_t order_type_{};
+  std::uint8_t has_custom_fields_{};
+  std::uint64_t sequence_{};
+  OrderIDType cln_order_id_{};
+  SizeType size_{};
+  PriceType price_{};
+  ClientType client_{};
+  InstrumentType instrument_{};
+  std::uint8_t time_in_force_{};
+  // Room for further order attributes without changing record size
+  std::uint8_t reserved_[7]{};
+  std::uint64_t expire_time_{};
+  PriceType trigger_price_{};
+  SizeType display_size_{};
+  // Engine clock of the batch, orders expiring by it were out of the book before the request was processed
+  std::uint64_t request_time_{};
+};
+static_assert(sizeof(JournalRecord) == 96);
+
+template<typename OrderExt>
+constexpr std::size_t JOURNAL_RECORD_SIZE =
+    (sizeof(JournalRecord) + OrderExtCodec<OrderExt>::ENCODED_SIZE + 7) & ~static_cast<std::size_t>(7);
+
+struct JournalSegmentInfo {
+  std::string path_{};
+  std::uint64_t epoch_{};
+  std::uint32_t thread_index_{};
+  std::uint64_t segment_index_{};
+};
+
+[[nodiscard]] inline std::string journalSegmentFileName(const std::uint64_t &epoch,
+                                                        const std::uint32_t &thread_index,
+                                                        const std::uint64_t &segment_index) {
+  char file_name[64];
+  std::snprintf(file_name, sizeof(file_name), "journal_%08llu_%04u_%08llu.bin",
+                static_cast<unsigned long long>(epoch),
+                thread_index,
+                static_cast<unsigned long long>(segment_index));
+  return file_name;
+}
+
+// All segments found in directory, ordered by epoch, thread and segment
+[[nodiscard]] inline std::vector<JournalSegmentInfo> listJournalSegments(const std::string &directory) {
+  std::vector<JournalSegmentInfo> segments;
+  if (!std::filesystem::is_directory(directory)) return segments;
+
+  for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+    unsigned long long epoch{}, segment_index{};
+    unsigned thread_index{};
+    char extension[8]{};
+    const auto file_name = entry.path().filename().string();
+    if (std::sscanf(file_name.c_str(), "journal_%llu_%u_%llu.%3s", &epoch, &thread_index, &segment_index, extension)
+        == 4 && std::strcmp(extension, "bin") == 0) {
+      segments.push_back({entry.path().string(), epoch, thread_index, segment_index});
+    }
+  }
+
+  std::sort(segments.begin(), segments.end(), [](const auto &lhs, const auto &rhs) {
+    return std::tie(lhs.epoch_, lhs.thread_index_, lhs.segment_index_)
+        < std::tie(rhs.epoch_, rhs.thread_index_, rhs.segment_index_);
+  });
+  return segments;
+}
+
+[[nodiscard]] inline std::uint64_t nextJournalEpoch(const std::string &directory) {
+  const auto segments = listJournalSegments(directory);
+  return segments.empty() ? 1 : segments.back().epoch_ + 1;
+}
+
+template<typename OrderExt>
+void encodeJournalRecord(const ClientOrderRequest<OrderExt> &order_request,
+                         const std::uint64_t &sequence,
+                         const std::uint64_t &request_time,
+                         char *buffer) {
+  JournalRecord record;
+  record.side_ = static_cast<std::uint8_t>(order_request.side_);
+  record.order_action_ = static_cast<std::uint8_t>(order_request.order_action_);
+  record.order_type_ = static_cast<std::uint8_t>(order_request.order_type_);
+  record.has_custom_fields_ = order_request.custom_fields_ ? 1 : 0;
+  record.sequence_ = sequence;
+  record.cln_order_id_ = order_request.cln_order_id_;
+  record.size_ = order_request.size_;
+  record.price_ = order_request.price_;
+  record.client_ = order_request.client_;
+  record.instrument_ = order_request.instrument_;
+  record.time_in_force_ = static_cast<std::uint8_t>(order_request.time_in_force_);
+  record.expire_time_ = order_request.expire_time_;
+  record.trigger_price_ = order_request.trigger_price_;
+  record.display_size_ = order_request.display_size_;
+  record.request_time_ = request_time;
+
+  if (record.has_custom_fields_) {
+    OrderExtCodec<OrderExt>::encode(order_request.custom_fields_, buffer + sizeof(JournalRecord));
+  }
+
+  // Marker goes in last so that a partially written record is never mistaken as valid
+  std::memcpy(buffer, &record, sizeof(JournalRecord));
+  const std::uint32_t marker{JOURNAL_RECORD_MARKER};
+  std::memcpy(buffer, &marker, sizeof(marker));
+}
+
+// Returns false on an unstamped record, which marks the end of valid journal
+template<typename OrderExt>
+[[nodiscard]] bool decodeJournalRecord(const char *buffer,
+                                       ClientOrderRequest<OrderExt> &order_request,
+                                       std::uint64_t &sequence,
+                                       std::uint64_t &request_time) {
+  JournalRecord record;
+  std::memcpy(&record, buffer, sizeof(JournalRecord));
+  if (record.marker_ != JOURNAL_RECORD_MARKER) return false;
+
+  order_request.side_ = static_cast<OrderSide>(record.side_);
+  order_request.order_action_ = static_cast<OrderAction>(record.order_action_);
+  order_request.order_type_ = static_cast<OrderType>(record.order_type_);
+  order_request.cln_order_id_ = record.cln_order_id_;
+  order_request.size_ = record.size_;
+  order_request.price_ = record.price_;
+  order_request.client_ = record.client_;
+  order_request.instrument_ = record.instrument_;
+  order_request.time_in_force_ = static_cast<TimeInForce>(record.time_in_force_);
+  order_request.expire_time_ = record.expire_time_;
+  order_request.trigger_price_ = record.trigger_price_;
+  order_request.display_size_ = record.display_size_;
+  order_request.custom_fields_ = record.has_custom_fields_
+                                 ? OrderExtCodec<OrderExt>::decode(buffer + sizeof(JournalRecord))
+                                 : nullptr;
+  sequence = record.sequence_;
+  request_time = record.request_time_;
+  return true;
+}
+
+template<typename OrderExt = void>
+class RequestJournalWriter final {
+ public:
+  RequestJournalWriter(const JournalOptions &options, const std::uint64_t &epoch, const std::uint32_t &thread_index);
+  RequestJournalWriter(const RequestJournalWriter &) = delete;
+  RequestJournalWriter(RequestJournalWriter &&) noexcept = default;
+  RequestJournalWriter &operator=(const RequestJournalWriter &) = delete;
+  RequestJournalWriter &operator=(RequestJournalWriter &&) noexcept = default;
+  ~RequestJournalWriter();
+
+  // request_time is the engine clock the request is processed at
+  void append(const ClientOrderRequest<OrderExt> &order_request, const std::uint64_t &request_time);
+
+  // Marks the end of a batch of appended requests, flushing as the policy demands
+  void commitBatch();
+  // Under FSYNC_INTERVAL, flushes requests appended since the last flush once the interval has passed. Called on idle
+  // passes too, so that the last batch before a lull is not left unflushed until the next batch commits.
+  void flushIfDue();
+  void close();
+
+  [[nodiscard]] bool hasUnflushedWrites() const { return segment_.isOpen() && write_offset_ > flushed_offset_; }
+
+  // Position of the next request to be appended
+  [[nodiscard]] JournalPosition getPosition() const { return {epoch_, next_sequence_}; }
+
+ private:
+  static constexpr std::size_t RECORD_SIZE = JOURNAL_RECORD_SIZE<OrderExt>;
+
+  void openSegment();
+  void closeSegment();
+  void flush();
+
+  JournalOptions options_{};
+  std::uint64_t epoch_{};
+  std::uint32_t thread_index_{};
+  std::uint64_t segment_index_{};
+  std::uint64_t next_sequence_{};
+
+  MappedFile segment_{};
+  std::size_t write_offset_{};
+  std::size_t flushed_offset_{};
+  std::chrono::steady_clock::time_point last_flush_time_{};
+};
+
+template<typename OrderExt>
+RequestJournalWriter<OrderExt>::RequestJournalWriter(const JournalOptions &options,
+                                                     const std::uint64_t &epoch,
+                                                     const std::uint32_t &thread_index)
+    : options_(options), epoch_(epoch), thread_index_(thread_index) {
+
+  if (options_.segment_size_ < sizeof(JournalSegmentHeader) + RECORD_SIZE) {
+    throw std::invalid_argument("journal segment size too small to hold a record");
+  }
+
+  std::filesystem::create_directories(options_.directory_);
+  openSegment();
+}
+
+template<typename OrderExt>
+RequestJournalWriter<OrderExt>::~RequestJournalWriter() {
+  try {
+    close();
+  } catch (...) {
+    // nothing sensible to do on destruction
+  }
+}
+
+template<typename OrderExt>
+void RequestJournalWriter<OrderExt>::append(const ClientOrderRequest<OrderExt> &order_request,
+                                            const std::uint64_t &request_time) {
+  if (write_offset_ + RECORD_SIZE > segment_.size()) {
+    closeSegment();
+    segment_index_++;
+    openSegment();
+  }
+
+  encodeJournalRecord(order_request, next_sequence_++, request_time, segment_.data() + write_offset_);
+  write_offset_ += RECORD_SIZE;
+}
+
+template<typename OrderExt>
+void RequestJournalWriter<OrderExt>::commitBatch() {
+  switch (options_.flush_policy_) {
+    case JournalFlushPolicy::PER_BATCH:
+      flush();
+      break;
+    case JournalFlushPolicy::FSYNC_INTERVAL:
+      flushIfDue();
+      break;
+    case JournalFlushPolicy::NONE:
+      break;
+  }
+}
+
+template<typename OrderExt>
+void RequestJournalWriter<OrderExt>::flushIfDue() {
+  if (options_.flush_policy_ != JournalFlushPolicy::FSYNC_INTERVAL || !hasUnflushedWrites()) return;
+  if (std::chrono::steady_clock::now() - last_flush_time_ >= options_.fsync_interval_) flush();
+}
+
+template<typename OrderExt>
+void RequestJournalWriter<OrderExt>::close() {
+  if (segment_.isOpen()) closeSegment();
+}
+
+template<typename OrderExt>
+void RequestJournalWriter<OrderExt>::openSegment() {
+  const auto path = std::filesystem::path(options_.directory_)
+      / journalSegmentFileName(epoch_, thread_index_, segment_index_);
+  segment_ = MappedFile(path.string(), MappedFile::Mode::READ_WRITE, options_.segment_size_);
+
+  JournalSegmentHeader header;
+  header.record_size_ = static_cast<std::uint32_t>(RECORD_SIZE);
+  header.epoch_ = epoch_;
+  header.segment_index_ = segment_index_;
+  header.first_sequence_ = next_sequence_;
+  header.thread_index_ = thread_index_;
+  std::memcpy(segment_.data(), &header, sizeof(header));
+
+  write_offset_ = sizeof(JournalSegmentHeader);
+  flushed_offset_ = 0;
+  last_flush_time_ = std::chrono::steady_clock::now();
+}
+
+template<typename OrderExt>
+void RequestJournalWriter<OrderExt>::closeSegment() {
+  if (options_.flush_policy_ != JournalFlushPolicy::NONE) flush();
+  segment_.close(write_offset_);
+}
+
+template<typename OrderExt>
+void RequestJournalWriter<OrderExt>::flush() {
+  segment_.sync(flushed_offset_, write_offset_ - flushed_offset_, true);
+  flushed_offset_ = write_offset_;
+  last_flush_time_ = std::chrono::steady_clock::now();
+}
+
+template<typename OrderExt = void>
+class RequestJournalReader final {
+ public:
+  explicit RequestJournalReader(const std::string &path);
+
+  [[nodiscard]] const JournalSegmentHeader &getHeader() const { return header_; }
+
+  // Invokes f(JournalPosition, ClientOrderRequest<OrderExt> &) for every valid record in order, or
+  // f(JournalPosition, ClientOrderRequest<OrderExt> &, request time) where f takes it. Returns number of records read.
+  template<typename F>
+  std::size_t forEach(F &&f) const;
+
+ private:
+  static constexpr std::size_t RECORD_SIZE = JOURNAL_RECORD_SIZE<OrderExt>;
+
+  MappedFile segment_{};
+  JournalSegmentHeader header_{};
+};
+
+template<typename OrderExt>
+RequestJournalReader<OrderExt>::RequestJournalReader(const std::string &path)
+    : segment_(path, MappedFile::Mode::READ_ONLY) {
+
+  if (segment_.size() < sizeof(JournalSegmentHeader)) {
+    throw std::runtime_error("truncated journal segment " + path);
+  }
+
+  std::memcpy(&header_, segment_.data(), sizeof(header_));
+  if (header_.magic_ != JOURNAL_MAGIC || header_.version_ != JOURNAL_VERSION) {
+    throw std::runtime_error("unrecognised journal segment " + path);
+  }
+  if (header_.record_size_ != RECORD_SIZE) {
+    throw std::runtime_error("journal segment record size does not match order extension " + path);
+  }
+
+  segment_.adviseSequential();
+}
+
+template<typename OrderExt>
+template<typename F>
+std::size_t RequestJournalReader<OrderExt>::forEach(F &&f) const {
+  std::size_t count{0};
+  ClientOrderRequest<OrderExt> order_request;
+  JournalPosition position{header_.epoch_, 0};
+  std::uint64_t request_time{};
+
+  for (std::size_t offset = sizeof(JournalSegmentHeader);
+       offset + RECORD_SIZE <= segment_.size();
+       offset += RECORD_SIZE) {
+    if (!decodeJournalRecord(segment_.data() + offset, order_request, position.sequence_, request_time)) break;
+    if constexpr (std::is_invocable_v<F, const JournalPosition &, ClientOrderRequest<OrderExt> &,
+                                      const std::uint64_t &>) {
+      f(static_cast<const JournalPosition &>(position), order_request, std::as_const(request_time));
+    } else {
+      f(static_cast<const JournalPosition &>(position), order_request);
+    }
+    count++;
+  }
+
+  return count;
+}
+
+// Streams every journaled request found in directory to f as RequestJournalReader::forEach does, epoch by epoch.
+// Within an epoch an instrument is owned by a single thread, so per instrument order is preserved.
+template<typename OrderExt = void, typename F>
+std::size_t replayJournal(const std::string &directory, F &&f) {
+  std::size_t count{0};
+  for (const auto &segment : listJournalSegments(directory)) {
+    count += RequestJournalReader<OrderExt>(segment.path_).forEach(f);
+  }
+  return count;
+}
+
+} // end of namespace
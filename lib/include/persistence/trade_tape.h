@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "interface/i_engine_event_observer.h"
+#include "persistence/mapped_file.h"
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Trade tape layout
+ *
+ * Trades are sharded by instrument, every shard writes segments of up to rows_per_segment_ trades.
+ * A segment is one plain uint64 array file per column
+ *   tape_<shard>_<segment>.<column>.col
+ * and an index file with the row count and per column min/max, written as the segment is sealed
+ *   tape_<shard>_<segment>.idx
+ * Analysis maps only the columns it needs and skips whole segments by their min/max.
+ * A writer opening a directory holding a tape already carries on after the last sealed segment of every shard.
+ */
+
+enum class TradeTapeColumn : std::uint8_t {
+  TIMESTAMP = 0,
+  INSTRUMENT = 1,
+  PRICE = 2,
+  SIZE = 3,
+  AGGRESSOR_CLIENT = 4,
+  AGGRESSOR_ORDER_ID = 5,
+  PASSIVE_CLIENT = 6,
+  PASSIVE_ORDER_ID = 7,
+  _COLUMN_SIZE_ = 8
+};
+
+constexpr std::size_t TRADE_TAPE_COLUMN_SIZE = static_cast<std::size_t>(TradeTapeColumn::_COLUMN_SIZE_);
+constexpr std::uint64_t TRADE_TAPE_MAGIC{0x3145504154454DULL}; // "METAPE1"
+constexpr std::uint32_t TRADE_TAPE_VERSION{1};
+
+struct TradeTapeSegmentIndex {
+  std::uint64_t magic_{TRADE_TAPE_MAGIC};
+  std::uint32_t version_{TRADE_TAPE_VERSION};
+  std::uint32_t shard_{};
+  std::uint64_t segment_{};
+  std::uint64_t row_count_{};
+  std::array<std::uint64_t, TRADE_TAPE_COLUMN_SIZE> min_{};
+  std::array<std::uint64_t, TRADE_TAPE_COLUMN_SIZE> max_{};
+
+  // Whether any row of the segment may hold a column value within [low, high]
+  [[nodiscard]] bool mayContain(const TradeTapeColumn &column,
+                                const std::uint64_t &low,
+                                const std::uint64_t &high) const;
+};
+
+struct TradeTapeOptions {
+  std::string directory_{};
+  std::size_t rows_per_segment_{1 << 20};
+  // Instruments are spread over shards each with its own lock, so processor threads rarely contend
+  std::size_t number_of_shards_{16};
+  // Trade timestamp in nanoseconds, system clock when not given (back-tests would supply simulated time)
+  std::function<std::uint64_t()> clock_{};
+};
+
+// Engine event observer writing every trade onto a memory-mapped columnar tape,
+// events are forwarded to the downstream observer when one is given
+class TradeTapeWriter final : public IEngineEventObserver {
+ public:
+  explicit TradeTapeWriter(const TradeTapeOptions &options,
+                           const std::shared_ptr<IEngineEventObserver> &downstream_observer = nullptr);
+  TradeTapeWriter(const TradeTapeWriter &) = delete;
+  TradeTapeWriter(TradeTapeWriter &&) noexcept = delete;
+  TradeTapeWriter &operator=(const TradeTapeWriter &) = delete;
+  TradeTapeWriter &operator=(TradeTapeWriter &&) noexcept = delete;
+  ~TradeTapeWriter() override;
+
+  void doTradeEvent(
+      const ClientType &client1,
+      const OrderIDType &client1_order_id,
+      const ClientType &client2,
+      const OrderIDType &client2_order_id,
+      const InstrumentType &instrument,
+      const PriceType &trade_price,
+      const SizeType &size) override;
+
+  void doOrderRequestResponse(
+      const ClientType &client,
+      const OrderIDType &client_order_id,
+      const InstrumentType &instrument,
+      const PriceType &order_price,
+      const SizeType &order_size,
+      const OrderRequestResult &order_request_result,
+      const ValidationResponse &validation_response) override;
+
+  void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) override;
+
+  // Seals every open segment, writing its index. Trades arriving afterwards start new segments.
+  void close();
+
+ private:
+  struct alignas(64) Shard {
+    std::mutex mutex_{};
+    std::uint32_t shard_index_{};
+    std::uint64_t segment_{};
+    std::array<MappedFile, TRADE_TAPE_COLUMN_SIZE> columns_{};
+    TradeTapeSegmentIndex index_{};
+  };
+
+  void openSegment(Shard &shard);
+  void sealSegment(Shard &shard);
+
+  TradeTapeOptions options_{};
+  std::shared_ptr<IEngineEventObserver> downstream_observer_{};
+  std::vector<std::unique_ptr<Shard>> shards_{};
+};
+
+// Read-only view of one column of a sealed segment
+class TradeTapeColumnView final {
+ public:
+  TradeTapeColumnView(MappedFile &&file, const std::uint64_t &row_count)
+      : file_(std::move(file)), row_count_(row_count) {}
+
+  [[nodiscard]] const std::uint64_t *data() const { return reinterpret_cast<const std::uint64_t *>(file_.data()); }
+  [[nodiscard]] std::size_t size() const { return row_count_; }
+  [[nodiscard]] const std::uint64_t *begin() const { return data(); }
+  [[nodiscard]] const std::uint64_t *end() const { return data() + row_count_; }
+  [[nodiscard]] std::uint64_t operator[](const std::size_t &row) const { return data()[row]; }
+
+ private:
+  MappedFile file_{};
+  std::uint64_t row_count_{};
+};
+
+class TradeTapeReader final {
+ public:
+  explicit TradeTapeReader(const std::string &directory);
+
+  // Sealed segments ordered by shard and segment
+  [[nodiscard]] const std::vector<TradeTapeSegmentIndex> &getSegments() const { return segments_; }
+
+  [[nodiscard]] TradeTapeColumnView mapColumn(const TradeTapeSegmentIndex &segment,
+                                              const TradeTapeColumn &column) const;
+
+ private:
+  std::string directory_{};
+  std::vector<TradeTapeSegmentIndex> segments_{};
+};
+
+} // end of namespace
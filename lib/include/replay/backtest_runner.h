@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+#include "interface/i_engine_event_observer.h"
+#include "interface/i_matching_algo.h"
+#include "replay/order_flow_file.h"
+
+namespace codetest::matching_engine_sim {
+
+struct BacktestResult {
+  std::uint64_t messages_{};
+  std::uint64_t acks_{};
+  std::uint64_t nacks_{};
+  // Resting orders the engine took out of the book itself, e.g. on expiry
+  std::uint64_t unsolicited_cancels_{};
+  std::uint64_t trades_{};
+  std::uint64_t traded_size_{};
+  std::uint64_t traded_notional_{};
+  // Sum of time spent matching, across all tasks merged in
+  std::chrono::nanoseconds busy_time_{};
+
+  BacktestResult &operator+=(const BacktestResult &rhs);
+};
+
+struct BacktestScenarioResult {
+  std::string name_{};
+  BacktestResult total_{};
+  std::map<InstrumentType, BacktestResult> instruments_{};
+};
+
+struct BacktestScenario {
+  std::string name_{};
+  // Invoked once per instrument, every task matches with its own algo instance
+  std::function<std::unique_ptr<IMatchingAlgo<>>()> matching_algo_factory_{};
+  // Optional, observer of the events of one instrument in addition to result accounting
+  std::function<std::shared_ptr<IEngineEventObserver>(const InstrumentType &)> observer_factory_{};
+};
+
+// Accounts engine events into a BacktestResult, forwarding them to downstream observer when one is given
+class BacktestResultObserver final : public IEngineEventObserver {
+ public:
+  explicit BacktestResultObserver(const std::shared_ptr<IEngineEventObserver> &downstream_observer = nullptr)
+      : downstream_observer_(downstream_observer) {}
+
+  void doTradeEvent(
+      const ClientType &client1,
+      const OrderIDType &client1_order_id,
+      const ClientType &client2,
+      const OrderIDType &client2_order_id,
+      const InstrumentType &instrument,
+      const PriceType &trade_price,
+      const SizeType &size) override;
+
+  void doOrderRequestResponse(
+      const ClientType &client,
+      const OrderIDType &client_order_id,
+      const InstrumentType &instrument,
+      const PriceType &order_price,
+      const SizeType &order_size,
+      const OrderRequestResult &order_request_result,
+      const ValidationResponse &validation_response) override;
+
+  void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) override;
+
+  [[nodiscard]] BacktestResult &getResult() { return result_; }
+
+ private:
+  BacktestResult result_{};
+  std::shared_ptr<IEngineEventObserver> downstream_observer_{};
+};
+
+/*
+ * Runs many independent scenarios over the same order flow in parallel.
+ *
+ * Input file is mapped once and shared read-only by every task. Order flow is split by instrument up front,
+ * and each scenario x instrument is a task matching that instrument's flow into its own book with its own
+ * matching algo, so tasks share no mutable state. A fixed number of worker threads pull tasks, largest
+ * instrument first, until none is left; per task results are merged per scenario once all are done.
+ */
+class BacktestRunner final {
+ public:
+  explicit BacktestRunner(const OrderFlowFileReader &reader, const std::size_t &number_of_threads = 0);
+  BacktestRunner(const BacktestRunner &) = delete;
+  BacktestRunner &operator=(const BacktestRunner &) = delete;
+  ~BacktestRunner() = default;
+
+  // Results in the order of scenarios, rethrows the first failure of any task
+  [[nodiscard]] std::vector<BacktestScenarioResult> run(const std::vector<BacktestScenario> &scenarios) const;
+
+  [[nodiscard]] std::size_t getNumberOfThreads() const { return number_of_threads_; }
+
+ private:
+  [[nodiscard]] BacktestResult runTask(const BacktestScenario &scenario,
+                                       const InstrumentType &instrument,
+                                       const std::vector<std::size_t> &record_indices) const;
+
+  const OrderFlowFileReader &reader_;
+  std::size_t number_of_threads_{};
+  // Indices of each instrument's records in the order flow, instruments with the most records first
+  std::vector<std::pair<InstrumentType, std::vector<std::size_t>>> instrument_records_{};
+};
+
+} // end of namespace
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "types.h"
+#include "persistence/mapped_file.h"
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Order flow file layout
+ *
+ * An OrderFlowFileHeader followed by fixed size, time ordered OrderFlowRecord of 80 bytes, without padding,
+ * so a replay maps the file and walks it front to back without any parsing.
+ *
+ * Version 2 added trigger_price_ and display_size_ to the record, growing it out of its 64 bytes.
+ */
+
+constexpr std::uint64_t ORDER_FLOW_MAGIC{0x31574F4C46454DULL}; // "MEFLOW1"
+constexpr std::uint32_t ORDER_FLOW_VERSION{2};
+
+struct OrderFlowFileHeader {
+  std::uint64_t magic_{ORDER_FLOW_MAGIC};
+  std::uint32_t version_{ORDER_FLOW_VERSION};
+  std::uint32_t record_size_{};
+  std::uint64_t record_count_{};
+  std::uint64_t first_timestamp_{};
+  std::uint64_t last_timestamp_{};
+  std::uint64_t reserved_[3]{};
+};
+static_assert(sizeof(OrderFlowFileHeader) == 64);
+
+struct OrderFlowRecord {
+  std::uint64_t timestamp_{};
+  InstrumentType instrument_{};
+  ClientType client_{};
+  OrderIDType cln_order_id_{};
+  PriceType price_{};
+  SizeType size_{};
+  std::uint8_t side_{};
+  std::uint8_t order_action_{};
+  std::uint8_t order_type_{};
+  std::uint8_t time_in_force_{};
+  // Room for further order attributes without changing record size
+  std::uint8_t reserved_[4]{};
+  std::uint64_t expire_time_{};
+  // Stop and stop limit orders only
+  PriceType trigger_price_{};
+  // Iceberg orders only, 0 showing the whole order
+  SizeType display_size_{};
+};
+static_assert(sizeof(OrderFlowRecord) == 80);
+
+// Appends time ordered records, header is completed on close
+class OrderFlowFileWriter final {
+ public:
+  explicit OrderFlowFileWriter(const std::string &path);
+  OrderFlowFileWriter(const OrderFlowFileWriter &) = delete;
+  OrderFlowFileWriter &operator=(const OrderFlowFileWriter &) = delete;
+  ~OrderFlowFileWriter();
+
+  void append(const OrderFlowRecord &record);
+  void close();
+
+  [[nodiscard]] std::uint64_t getRecordCount() const { return header_.record_count_; }
+
+ private:
+  std::string path_{};
+  std::ofstream file_{};
+  OrderFlowFileHeader header_{};
+};
+
+// Throws on a file of another format or version, and on a record with a side, action, type or time in force out of
+// range, naming the record
+class OrderFlowFileReader final {
+ public:
+  explicit OrderFlowFileReader(const std::string &path);
+
+  [[nodiscard]] const OrderFlowFileHeader &getHeader() const { return header_; }
+  [[nodiscard]] const OrderFlowRecord *data() const {
+    return reinterpret_cast<const OrderFlowRecord *>(file_.data() + sizeof(OrderFlowFileHeader));
+  }
+  [[nodiscard]] std::size_t size() const { return header_.record_count_; }
+  [[nodiscard]] const OrderFlowRecord *begin() const { return data(); }
+  [[nodiscard]] const OrderFlowRecord *end() const { return data() + size(); }
+
+ private:
+  MappedFile file_{};
+  OrderFlowFileHeader header_{};
+};
+
+/*
+ * Converts a CSV order flow into an order flow file, returns number of records written.
+ * One order event per line, a leading header line is skipped
+ *   timestamp,instrument,client,order_id,side,action,type,price,size[,trigger_price,display_size]
+ * with
+ *   side   BUY, SELL
+ *   action NEW, CANCEL, AMEND, MASS_CANCEL, MASS_CANCEL_SIDE
+ *   type   LIMIT, MARKET, STOP, STOP_LIMIT, PRIMARY_PEG, MID_PEG
+ * Time in force and expire time are not importable, every imported order is good till cancelled.
+ * Throws std::invalid_argument naming the line of any other value or column count, or of a line back in time.
+ */
+std::uint64_t importOrderFlowCsv(const std::string &csv_path, const std::string &order_flow_path);
+
+} // end of namespace
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+
+#include "types.h"
+#include "events/client_order_request.h"
+#include "interface/i_engine_event_observer.h"
+#include "interface/i_matching_algo.h"
+#include "matching/passive_order_book.hpp"
+#include "matching/matching_algo.hpp"
+#include "replay/order_flow_file.h"
+
+namespace codetest::matching_engine_sim {
+
+// Records ahead of the one being matched to pull into cache, covering a few matches worth of latency
+constexpr std::size_t ORDER_FLOW_PREFETCH_DISTANCE = 16;
+
+struct ReplayStatistics {
+  std::uint64_t messages_{};
+  std::size_t instruments_{};
+  std::chrono::nanoseconds elapsed_{};
+
+  [[nodiscard]] double messagesPerSecond() const {
+    return elapsed_.count() == 0 ? 0.0 : static_cast<double>(messages_) * 1e9 / static_cast<double>(elapsed_.count());
+  }
+};
+
+[[nodiscard]] inline ClientOrderRequest<> toClientOrderRequest(const OrderFlowRecord &record) {
+  ClientOrderRequest<> order_request{static_cast<OrderSide>(record.side_),
+                                     static_cast<OrderAction>(record.order_action_),
+                                     static_cast<OrderType>(record.order_type_),
+                                     record.cln_order_id_,
+                                     record.size_,
+                                     record.price_,
+                                     record.client_,
+                                     record.instrument_};
+  order_request.time_in_force_ = static_cast<TimeInForce>(record.time_in_force_);
+  order_request.expire_time_ = record.expire_time_;
+  order_request.trigger_price_ = record.trigger_price_;
+  order_request.display_size_ = record.display_size_;
+  return order_request;
+}
+
+/*
+ * Replays an order flow file straight through the matching algo, one passive order book per instrument,
+ * on the calling thread. There is no queueing or validation of instruments as in matching engine,
+ * every instrument appearing in the flow gets its book on first sight.
+ */
+template<typename MatchingAlgo = PriceTimePriorityMatching<>>
+class OrderFlowReplayDriver final {
+  static_assert(std::is_base_of_v<IMatchingAlgo<>, MatchingAlgo>,
+                "Order flow carries no custom fields, matching algo of no order extension required");
+
+ public:
+  explicit OrderFlowReplayDriver(IEngineEventObserver &observer) : observer_(observer) {}
+  OrderFlowReplayDriver(const OrderFlowReplayDriver &) = delete;
+  OrderFlowReplayDriver &operator=(const OrderFlowReplayDriver &) = delete;
+  ~OrderFlowReplayDriver() = default;
+
+  ReplayStatistics replay(const OrderFlowFileReader &reader);
+
+  [[nodiscard]] const std::unordered_map<InstrumentType, PassiveOrderBook<>> &getPassiveOrderBooks() const {
+    return passive_order_books_;
+  }
+
+ private:
+  MatchingAlgo matching_algo_{};
+  IEngineEventObserver &observer_;
+  std::unordered_map<InstrumentType, PassiveOrderBook<>> passive_order_books_{};
+};
+
+template<typename MatchingAlgo>
+ReplayStatistics OrderFlowReplayDriver<MatchingAlgo>::replay(const OrderFlowFileReader &reader) {
+  const auto start_time = std::chrono::steady_clock::now();
+
+  const OrderFlowRecord *const records = reader.data();
+  const std::size_t record_count = reader.size();
+
+  // Flow of a single instrument tends to come in bursts, saves a hash lookup per message
+  InstrumentType last_instrument{};
+  PassiveOrderBook<> *last_passive_order_book{nullptr};
+
+  for (std::size_t index = 0; index < record_count; index++) {
+    // Prefetch never faults, running past the end of mapping is harmless
+    __builtin_prefetch(records + index + ORDER_FLOW_PREFETCH_DISTANCE);
+
+    const auto &record = records[index];
+    if (last_passive_order_book == nullptr || record.instrument_ != last_instrument) {
+      last_instrument = record.instrument_;
+      last_passive_order_book = &passive_order_books_[record.instrument_];
+    }
+
+    // Flow time stamps are the clock of good till time orders
+    matching_algo_.doExpireOrders(*last_passive_order_book, record.instrument_, record.timestamp_, observer_);
+
+    auto order_request = toClientOrderRequest(record);
+    matching_algo_.doProcessOrderRequest(order_request, *last_passive_order_book, observer_);
+  }
+
+  return {record_count,
+          passive_order_books_.size(),
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time)};
+}
+
+} // end of namespace
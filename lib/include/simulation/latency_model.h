@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_map>
+
+#include "types.h"
+
+namespace codetest::matching_engine_sim {
+
+// One way latency in nanoseconds, drawn from the simulation's random engine
+using LatencyDistribution = std::function<std::uint64_t(std::mt19937_64 &)>;
+
+[[nodiscard]] LatencyDistribution constantLatency(const std::uint64_t &latency);
+[[nodiscard]] LatencyDistribution uniformLatency(const std::uint64_t &min_latency, const std::uint64_t &max_latency);
+// Right skewed with a long tail, as network latency tends to be; sigma of the underlying normal
+[[nodiscard]] LatencyDistribution logNormalLatency(const std::uint64_t &median_latency, const double &sigma);
+
+// Processing time within the venue can be folded into either leg
+struct ClientLatencyProfile {
+  // Client sending a request until it reaches the order book
+  LatencyDistribution request_latency_{constantLatency(0)};
+  // Engine emitting a response or trade until it reaches the client
+  LatencyDistribution response_latency_{constantLatency(0)};
+};
+
+struct LatencyModel {
+  ClientLatencyProfile default_profile_{};
+  std::unordered_map<ClientType, ClientLatencyProfile> client_profiles_{};
+  // Same seed, same flow, same outcome
+  std::uint64_t seed_{0};
+
+  [[nodiscard]] const ClientLatencyProfile &getProfile(const ClientType &client) const {
+    const auto itr = client_profiles_.find(client);
+    return itr == client_profiles_.end() ? default_profile_ : itr->second;
+  }
+};
+
+} // end of namespace
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "types.h"
+#include "events/client_order_request.h"
+#include "external/i_client.h"
+#include "interface/i_engine_event_observer.h"
+#include "matching/passive_order_book.hpp"
+#include "matching/matching_algo.hpp"
+#include "simulation/latency_model.h"
+#include "simulation/timing_wheel.hpp"
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Event time back-test front end delaying order flow by a latency model.
+ *
+ * A request submitted at its send time reaches the order book after the client's request latency, and is matched
+ * right then. Every response and trade it causes reaches each client involved after that client's own response
+ * latency. All of these are events on a timing wheel, delivered in time order as simulation time is advanced.
+ * Like a network connection, a client's requests, and separately its notifications, never overtake each other.
+ */
+template<typename OrderExt = void, typename MatchingAlgo = PriceTimePriorityMatching<OrderExt>>
+class LatencySimulator final {
+ public:
+  LatencySimulator(const std::set<InstrumentType> &instruments,
+                   const LatencyModel &latency_model,
+                   const std::uint64_t &start_time = 0);
+  LatencySimulator(const LatencySimulator &) = delete;
+  LatencySimulator &operator=(const LatencySimulator &) = delete;
+  ~LatencySimulator() = default;
+
+  void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) { clients_ = clients; }
+
+  // Request leaving the client at send_time, which cannot be before current simulation time
+  void submit(const std::uint64_t &send_time, const ClientOrderRequest<OrderExt> &order_request);
+
+  // Delivers every event due up to and including time, in time order
+  void advanceTo(const std::uint64_t &time);
+
+  // Delivers every outstanding event, however far in the future
+  void drain();
+
+  [[nodiscard]] std::uint64_t getCurrentTime() const { return current_time_; }
+  [[nodiscard]] std::size_t getPendingEvents() const { return timing_wheel_.size(); }
+  [[nodiscard]] const PassiveOrderBook<OrderExt> *getPassiveOrderBook(const InstrumentType &instrument) const;
+
+ private:
+  enum class EventType : std::uint8_t {
+    REQUEST_ARRIVAL = 0,
+    ORDER_RESPONSE = 1,
+    TRADE = 2
+  };
+
+  struct SimulatedEvent {
+    EventType event_type_{};
+    OrderRequestResult order_request_result_{};
+    ValidationResponse validation_response_{};
+    ClientType client_{};
+    OrderIDType cln_order_id_{};
+    InstrumentType instrument_{};
+    PriceType price_{};
+    SizeType size_{};
+    // Arriving request only
+    ClientOrderRequest<OrderExt> order_request_{};
+  };
+
+  // Matching algo reports into this, turning every engine event into delayed client notifications
+  class DelayingObserver final : public IEngineEventObserver {
+   public:
+    explicit DelayingObserver(LatencySimulator &simulator) : simulator_(simulator) {}
+
+    void doTradeEvent(
+        const ClientType &client1,
+        const OrderIDType &client1_order_id,
+        const ClientType &client2,
+        const OrderIDType &client2_order_id,
+        const InstrumentType &instrument,
+        const PriceType &trade_price,
+        const SizeType &size) override {
+      simulator_.scheduleNotification({EventType::TRADE, {}, {}, client1, client1_order_id, instrument,
+                                       trade_price, size});
+      simulator_.scheduleNotification({EventType::TRADE, {}, {}, client2, client2_order_id, instrument,
+                                       trade_price, size});
+    }
+
+    void doOrderRequestResponse(
+        const ClientType &client,
+        const OrderIDType &client_order_id,
+        const InstrumentType &instrument,
+        const PriceType &order_price,
+        const SizeType &order_size,
+        const OrderRequestResult &order_request_result,
+        const ValidationResponse &validation_response) override {
+      simulator_.scheduleNotification({EventType::ORDER_RESPONSE, order_request_result, validation_response,
+                                       client, client_order_id, instrument, order_price, order_size});
+    }
+
+    void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &) override {}
+
+   private:
+    LatencySimulator &simulator_;
+  };
+
+  void scheduleNotification(SimulatedEvent &&event);
+  void schedule(const std::uint64_t &time, SimulatedEvent &&event);
+  void deliver(const std::uint64_t &time, SimulatedEvent &event);
+
+  const LatencyModel latency_model_{};
+  std::mt19937_64 random_engine_{};
+  MatchingAlgo matching_algo_{};
+  DelayingObserver delaying_observer_{*this};
+  TimingWheel<SimulatedEvent> timing_wheel_{};
+
+  // Time of the event being delivered while advancing, so clients may react by submitting at current time
+  std::uint64_t current_time_{};
+  std::uint64_t latest_scheduled_time_{};
+
+  std::unordered_map<InstrumentType, PassiveOrderBook<OrderExt>> passive_order_books_{};
+  std::unordered_map<ClientType, std::shared_ptr<IClient>> clients_{};
+  // Latest arrival per client and direction, keeping each of them in order
+  std::unordered_map<ClientType, std::uint64_t> last_request_arrival_{};
+  std::unordered_map<ClientType, std::uint64_t> last_notification_arrival_{};
+};
+
+template<typename OrderExt, typename MatchingAlgo>
+LatencySimulator<OrderExt, MatchingAlgo>::LatencySimulator(const std::set<InstrumentType> &instruments,
+                                                           const LatencyModel &latency_model,
+                                                           const std::uint64_t &start_time)
+    : latency_model_(latency_model),
+      random_engine_(latency_model.seed_),
+      timing_wheel_(start_time),
+      current_time_(start_time),
+      latest_scheduled_time_(start_time) {
+  for (const InstrumentType &inst : instruments) {
+    passive_order_books_.try_emplace(inst);
+  }
+}
+
+template<typename OrderExt, typename MatchingAlgo>
+void LatencySimulator<OrderExt, MatchingAlgo>::submit(const std::uint64_t &send_time,
+                                                      const ClientOrderRequest<OrderExt> &order_request) {
+  if (send_time < current_time_) {
+    throw std::invalid_argument("order request cannot be sent before current simulation time");
+  }
+
+  const auto &profile = latency_model_.getProfile(order_request.client_);
+  auto &last_arrival = last_request_arrival_[order_request.client_];
+  last_arrival = std::max(last_arrival, send_time + profile.request_latency_(random_engine_));
+
+  SimulatedEvent event{};
+  event.event_type_ = EventType::REQUEST_ARRIVAL;
+  event.order_request_ = order_request;
+  schedule(last_arrival, std::move(event));
+}
+
+template<typename OrderExt, typename MatchingAlgo>
+void LatencySimulator<OrderExt, MatchingAlgo>::scheduleNotification(SimulatedEvent &&event) {
+  const auto &profile = latency_model_.getProfile(event.client_);
+  auto &last_arrival = last_notification_arrival_[event.client_];
+  last_arrival = std::max(last_arrival, current_time_ + profile.response_latency_(random_engine_));
+  schedule(last_arrival, std::move(event));
+}
+
+template<typename OrderExt, typename MatchingAlgo>
+void LatencySimulator<OrderExt, MatchingAlgo>::schedule(const std::uint64_t &time, SimulatedEvent &&event) {
+  latest_scheduled_time_ = std::max(latest_scheduled_time_, time);
+  timing_wheel_.schedule(time, std::move(event));
+}
+
+template<typename OrderExt, typename MatchingAlgo>
+void LatencySimulator<OrderExt, MatchingAlgo>::advanceTo(const std::uint64_t &time) {
+  timing_wheel_.advance(time, [this](const std::uint64_t &event_time, SimulatedEvent &event) {
+    deliver(event_time, event);
+  });
+  current_time_ = std::max(current_time_, time);
+}
+
+template<typename OrderExt, typename MatchingAlgo>
+void LatencySimulator<OrderExt, MatchingAlgo>::drain() {
+  while (!timing_wheel_.empty()) {
+    advanceTo(latest_scheduled_time_);
+  }
+}
+
+template<typename OrderExt, typename MatchingAlgo>
+void LatencySimulator<OrderExt, MatchingAlgo>::deliver(const std::uint64_t &time, SimulatedEvent &event) {
+  current_time_ = time;
+
+  // Simulation time is the clock of good till time orders, taken out of the books before any event due at time
+  for (auto &[instrument, passive_order_book] : passive_order_books_) {
+    matching_algo_.doExpireOrders(passive_order_book, instrument, time, delaying_observer_);
+  }
+
+  switch (event.event_type_) {
+    case EventType::REQUEST_ARRIVAL: {
+      auto itr = passive_order_books_.find(event.order_request_.instrument_);
+      if (itr != passive_order_books_.end() && event.order_request_.order_action_ < OrderAction::_ACTION_SIZE_) {
+        matching_algo_.doProcessOrderRequest(event.order_request_, itr->second, delaying_observer_);
+      }
+      break;
+    }
+    case EventType::ORDER_RESPONSE:
+      if (auto client_itr = clients_.find(event.client_); client_itr != clients_.end()) {
+        client_itr->second->onOrderRequestResponse(event.cln_order_id_,
+                                                   event.instrument_,
+                                                   event.price_,
+                                                   event.size_,
+                                                   event.order_request_result_,
+                                                   event.validation_response_);
+      }
+      break;
+    case EventType::TRADE:
+      if (auto client_itr = clients_.find(event.client_); client_itr != clients_.end()) {
+        client_itr->second->onTradeEvent(event.cln_order_id_, event.instrument_, event.price_, event.size_);
+      }
+      break;
+  }
+}
+
+template<typename OrderExt, typename MatchingAlgo>
+const PassiveOrderBook<OrderExt> *LatencySimulator<OrderExt, MatchingAlgo>::getPassiveOrderBook(
+    const InstrumentType &instrument) const {
+  const auto itr = passive_order_books_.find(instrument);
+  return itr == passive_order_books_.end() ? nullptr : &itr->second;
+}
+
+} // end of namespace
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+#include "events/client_order_request.h"
+#include "interface/i_engine_event_observer.h"
+#include "matching/passive_order_book.hpp"
+#include "matching/matching_algo.hpp"
+#include "replay/order_flow_file.h"
+#include "replay/order_flow_replay.hpp"
+
+namespace codetest::matching_engine_sim {
+
+struct ShadowOrder {
+  OrderIDType order_id_{};
+  OrderSide side_{};
+  PriceType price_{};
+  SizeType size_{};
+  SizeType remaining_size_{};
+  // Historical size still ahead of the order in the queue of its price level
+  SizeType volume_ahead_{};
+  // Book sequence at placement, historical orders at the same price with a lower sequence are ahead
+  std::uint64_t sequence_{};
+};
+
+// Invoked for every fill of a shadow order, after its remaining size is updated
+using ShadowFillHandler = std::function<void(const ShadowOrder &order, const PriceType &price, const SizeType &size)>;
+
+/*
+ * Simulated (shadow) orders living alongside a book reconstructed from historical order-by-order flow.
+ *
+ * Historical flow is matched as recorded, shadow orders never take liquidity away from it (no market impact).
+ * A resting shadow order joins the back of its price level and tracks the historical volume ahead of it:
+ * trades at its price first eat into that volume, cancels and expiry of orders ahead of it reduce it, and only volume
+ * trading beyond it fills the shadow order. Historical trades at a price worse than a shadow order fill it outright, as
+ * the aggressor would have met it first. A shadow order crossing the book on placement fills against the historical
+ * liquidity it crosses, the rest of it rests.
+ */
+template<typename MatchingAlgo = PriceTimePriorityMatching<>>
+class ShadowOrderSimulator final {
+ public:
+  explicit ShadowOrderSimulator(const ShadowFillHandler &fill_handler = nullptr,
+                                const std::shared_ptr<IEngineEventObserver> &historical_observer = nullptr)
+      : fill_handler_(fill_handler), historical_observer_(*this, historical_observer) {}
+  ShadowOrderSimulator(const ShadowOrderSimulator &) = delete;
+  ShadowOrderSimulator &operator=(const ShadowOrderSimulator &) = delete;
+  ~ShadowOrderSimulator() = default;
+
+  void processHistoricalOrderRequest(const ClientOrderRequest<> &order_request);
+
+  // Expires historical good till time orders of instrument up to time, replay does so by record time stamps
+  void expireHistoricalOrders(const InstrumentType &instrument, const std::uint64_t &time);
+
+  // Processes the flow of one instrument, calling on_record(record) after each of its records, where shadow orders
+  // may be placed or cancelled. Returns number of records processed.
+  template<typename F>
+  std::uint64_t replay(const OrderFlowFileReader &reader, const InstrumentType &instrument, F &&on_record);
+  std::uint64_t replay(const OrderFlowFileReader &reader, const InstrumentType &instrument) {
+    return replay(reader, instrument, [](const OrderFlowRecord &) {});
+  }
+
+  void placeShadowOrder(const OrderIDType &order_id, const OrderSide &side, const PriceType &price,
+                        const SizeType &size);
+  bool cancelShadowOrder(const OrderIDType &order_id);
+
+  // Resting shadow order, nullptr once fully filled or cancelled
+  [[nodiscard]] const ShadowOrder *getShadowOrder(const OrderIDType &order_id) const;
+  [[nodiscard]] const PassiveOrderBook<> &getPassiveOrderBook() const { return passive_order_book_; }
+
+ private:
+  // Observes historical matching to drive shadow queue positions, forwarding to downstream observer if any
+  class HistoricalObserver final : public IEngineEventObserver {
+   public:
+    HistoricalObserver(ShadowOrderSimulator &simulator, const std::shared_ptr<IEngineEventObserver> &downstream)
+        : simulator_(simulator), downstream_observer_(downstream) {}
+
+    void doTradeEvent(
+        const ClientType &client1,
+        const OrderIDType &client1_order_id,
+        const ClientType &client2,
+        const OrderIDType &client2_order_id,
+        const InstrumentType &instrument,
+        const PriceType &trade_price,
+        const SizeType &size) override {
+      if (!simulator_.shadow_orders_.empty()) simulator_.onHistoricalTrade(trade_price, size);
+      if (downstream_observer_) {
+        downstream_observer_->doTradeEvent(client1, client1_order_id, client2, client2_order_id, instrument,
+                                           trade_price, size);
+      }
+    }
+
+    void doOrderRequestResponse(
+        const ClientType &client,
+        const OrderIDType &client_order_id,
+        const InstrumentType &instrument,
+        const PriceType &order_price,
+        const SizeType &order_size,
+        const OrderRequestResult &order_request_result,
+        const ValidationResponse &validation_response) override {
+      if (validation_response == ValidationResponse::ORDER_EXPIRED && !simulator_.shadow_orders_.empty()) {
+        simulator_.onHistoricalOrderExpired(client, client_order_id);
+      }
+      if (downstream_observer_) {
+        downstream_observer_->doOrderRequestResponse(client, client_order_id, instrument, order_price, order_size,
+                                                     order_request_result, validation_response);
+      }
+    }
+
+    void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) override {
+      if (downstream_observer_) downstream_observer_->setClientMap(clients);
+    }
+
+   private:
+    ShadowOrderSimulator &simulator_;
+    std::shared_ptr<IEngineEventObserver> downstream_observer_{};
+  };
+
+  template<typename ShadowLevels>
+  void fillThroughLevels(ShadowLevels &shadow_levels, const PriceType &trade_price, const SizeType &trade_size);
+  template<typename ShadowLevels>
+  void reduceVolumeAhead(ShadowLevels &shadow_levels, const PassiveOrder<> &cancelled_order,
+                         const SizeType &cancelled_size);
+  template<typename HistoricalLevels>
+  void fillAgainstHistoricalLevels(ShadowOrder &shadow_order, const HistoricalLevels &historical_levels);
+  template<typename ShadowLevels>
+  void removeFromLevel(ShadowLevels &shadow_levels, const ShadowOrder &shadow_order);
+
+  void onHistoricalTrade(const PriceType &trade_price, const SizeType &trade_size);
+  // Order is still in the book when reported expired
+  void onHistoricalOrderExpired(const ClientType &client, const OrderIDType &order_id);
+  void fill(ShadowOrder &shadow_order, const PriceType &price, const SizeType &size);
+
+  MatchingAlgo matching_algo_{};
+  PassiveOrderBook<> passive_order_book_{};
+  ShadowFillHandler fill_handler_{};
+  HistoricalObserver historical_observer_;
+
+  // Side of the historical request being matched, trades hit the other side
+  OrderSide aggressor_side_{};
+
+  std::unordered_map<OrderIDType, ShadowOrder> shadow_orders_{};
+  // Shadow order ids by price level in time priority, best price first as in the passive order book
+  std::map<PriceType, std::vector<OrderIDType>, std::greater<PriceType>> bid_shadow_levels_{};
+  std::map<PriceType, std::vector<OrderIDType>> ask_shadow_levels_{};
+};
+
+template<typename MatchingAlgo>
+void ShadowOrderSimulator<MatchingAlgo>::processHistoricalOrderRequest(const ClientOrderRequest<> &order_request) {
+  if (order_request.order_action_ >= OrderAction::_ACTION_SIZE_) return;
+
+  auto order_request_clone = order_request;
+  aggressor_side_ = order_request.side_;
+
+  // Cancel of a historical order ahead of a shadow order, or amending it down, moves the shadow order up the queue.
+  // An amendment losing priority leaves the old order cancelled, its replacement joining behind the shadow order.
+  PassiveOrderBook<>::PassiveOrderPtr cancelled_order{};
+  SizeType cancelled_size{0};
+  if ((order_request.order_action_ == OrderAction::CANCEL || order_request.order_action_ == OrderAction::AMEND)
+      && !shadow_orders_.empty()) {
+    cancelled_order = passive_order_book_.getEngineOrderFromCache(order_request.client_, order_request.cln_order_id_);
+    if (cancelled_order) cancelled_size = cancelled_order->remaining_size_;
+  }
+
+  // Mass cancel of historical orders ahead of shadow orders, their sizes taken before they are zeroed. Cancelled
+  // orders stay in their price levels until matching skips them, which cannot happen while the request is processed.
+  std::vector<std::pair<const PassiveOrder<> *, SizeType>> mass_cancelled_orders{};
+  if ((order_request.order_action_ == OrderAction::MASS_CANCEL
+      || order_request.order_action_ == OrderAction::MASS_CANCEL_SIDE) && !shadow_orders_.empty()) {
+    passive_order_book_.forEachClientOrder(order_request.client_, [&](const auto &passive_order) {
+      if (order_request.order_action_ == OrderAction::MASS_CANCEL || passive_order.side_ == order_request.side_) {
+        mass_cancelled_orders.emplace_back(&passive_order, passive_order.remaining_size_);
+      }
+    });
+  }
+
+  matching_algo_.doProcessOrderRequest(order_request_clone, passive_order_book_, historical_observer_);
+
+  for (const auto &[mass_cancelled_order, mass_cancelled_size] : mass_cancelled_orders) {
+    if (mass_cancelled_order->side_ == OrderSide::BUY) {
+      reduceVolumeAhead(bid_shadow_levels_, *mass_cancelled_order, mass_cancelled_size);
+    } else {
+      reduceVolumeAhead(ask_shadow_levels_, *mass_cancelled_order, mass_cancelled_size);
+    }
+  }
+
+  if (cancelled_order && cancelled_order->remaining_size_ < cancelled_size) {
+    const SizeType reduced_size = cancelled_size - cancelled_order->remaining_size_;
+    if (cancelled_order->side_ == OrderSide::BUY) {
+      reduceVolumeAhead(bid_shadow_levels_, *cancelled_order, reduced_size);
+    } else {
+      reduceVolumeAhead(ask_shadow_levels_, *cancelled_order, reduced_size);
+    }
+  }
+}
+
+template<typename MatchingAlgo>
+void ShadowOrderSimulator<MatchingAlgo>::expireHistoricalOrders(const InstrumentType &instrument,
+                                                                const std::uint64_t &time) {
+  matching_algo_.doExpireOrders(passive_order_book_, instrument, time, historical_observer_);
+}
+
+template<typename MatchingAlgo>
+template<typename F>
+std::uint64_t ShadowOrderSimulator<MatchingAlgo>::replay(const OrderFlowFileReader &reader,
+                                                         const InstrumentType &instrument,
+                                                         F &&on_record) {
+  const OrderFlowRecord *const records = reader.data();
+  const std::size_t record_count = reader.size();
+  std::uint64_t processed{0};
+
+  for (std::size_t index = 0; index < record_count; index++) {
+    __builtin_prefetch(records + index + ORDER_FLOW_PREFETCH_DISTANCE);
+
+    const auto &record = records[index];
+    if (record.instrument_ != instrument) continue;
+
+    // Flow time stamps are the clock of good till time orders, as in replay
+    expireHistoricalOrders(instrument, record.timestamp_);
+    processHistoricalOrderRequest(toClientOrderRequest(record));
+    processed++;
+    on_record(record);
+  }
+  return processed;
+}
+
+template<typename MatchingAlgo>
+void ShadowOrderSimulator<MatchingAlgo>::placeShadowOrder(const OrderIDType &order_id,
+                                                          const OrderSide &side,
+                                                          const PriceType &price,
+                                                          const SizeType &size) {
+  if (size == 0) {
+    throw std::invalid_argument("shadow order size cannot be 0");
+  }
+  if (shadow_orders_.count(order_id) > 0) {
+    throw std::invalid_argument("shadow order id already in use");
+  }
+
+  ShadowOrder shadow_order{order_id, side, price, size, size, 0, passive_order_book_.getNextSequence()};
+  if (side == OrderSide::BUY) {
+    fillAgainstHistoricalLevels(shadow_order, passive_order_book_.getAskOrderQueue());
+  } else {
+    fillAgainstHistoricalLevels(shadow_order, passive_order_book_.getBidOrderQueue());
+  }
+  if (shadow_order.remaining_size_ == 0) return;
+
+  // Joins the back of its level, behind every historical order resting there
+  const auto count_level_size = [&](const auto &historical_levels) {
+    SizeType level_size{0};
+    if (const auto itr = historical_levels.find(price); itr != historical_levels.end()) {
+      for (const auto &passive_order : itr->second) {
+        level_size += passive_order->remaining_size_;
+      }
+    }
+    return level_size;
+  };
+
+  if (side == OrderSide::BUY) {
+    shadow_order.volume_ahead_ = count_level_size(passive_order_book_.getBidOrderQueue());
+    bid_shadow_levels_[price].push_back(order_id);
+  } else {
+    shadow_order.volume_ahead_ = count_level_size(passive_order_book_.getAskOrderQueue());
+    ask_shadow_levels_[price].push_back(order_id);
+  }
+  shadow_orders_.emplace(order_id, shadow_order);
+}
+
+template<typename MatchingAlgo>
+bool ShadowOrderSimulator<MatchingAlgo>::cancelShadowOrder(const OrderIDType &order_id) {
+  const auto itr = shadow_orders_.find(order_id);
+  if (itr == shadow_orders_.end()) return false;
+
+  if (itr->second.side_ == OrderSide::BUY) {
+    removeFromLevel(bid_shadow_levels_, itr->second);
+  } else {
+    removeFromLevel(ask_shadow_levels_, itr->second);
+  }
+  shadow_orders_.erase(itr);
+  return true;
+}
+
+template<typename MatchingAlgo>
+const ShadowOrder *ShadowOrderSimulator<MatchingAlgo>::getShadowOrder(const OrderIDType &order_id) const {
+  const auto itr = shadow_orders_.find(order_id);
+  return itr == shadow_orders_.end() ? nullptr : &itr->second;
+}
+
+template<typename MatchingAlgo>
+void ShadowOrderSimulator<MatchingAlgo>::onHistoricalTrade(const PriceType &trade_price, const SizeType &trade_size) {
+  if (aggressor_side_ == OrderSide::SELL) {
+    fillThroughLevels(bid_shadow_levels_, trade_price, trade_size);
+  } else {
+    fillThroughLevels(ask_shadow_levels_, trade_price, trade_size);
+  }
+}
+
+template<typename MatchingAlgo>
+void ShadowOrderSimulator<MatchingAlgo>::onHistoricalOrderExpired(const ClientType &client,
+                                                                  const OrderIDType &order_id) {
+  const auto expired_order = passive_order_book_.getEngineOrderFromCache(client, order_id);
+  if (!expired_order) return;
+
+  if (expired_order->side_ == OrderSide::BUY) {
+    reduceVolumeAhead(bid_shadow_levels_, *expired_order, expired_order->remaining_size_);
+  } else {
+    reduceVolumeAhead(ask_shadow_levels_, *expired_order, expired_order->remaining_size_);
+  }
+}
+
+template<typename MatchingAlgo>
+template<typename ShadowLevels>
+void ShadowOrderSimulator<MatchingAlgo>::fillThroughLevels(ShadowLevels &shadow_levels,
+                                                           const PriceType &trade_price,
+                                                           const SizeType &trade_size) {
+  // Levels from best down to the trade price, anything beyond it is untouched by the trade
+  for (auto level_itr = shadow_levels.begin();
+       level_itr != shadow_levels.end() && !shadow_levels.key_comp()(trade_price, level_itr->first);) {
+
+    const bool traded_through = level_itr->first != trade_price;
+    auto &order_ids = level_itr->second;
+
+    for (auto id_itr = order_ids.begin(); id_itr != order_ids.end();) {
+      auto &shadow_order = shadow_orders_.at(*id_itr);
+
+      SizeType fillable_size = trade_size;
+      if (!traded_through) {
+        fillable_size = trade_size > shadow_order.volume_ahead_ ? trade_size - shadow_order.volume_ahead_ : 0;
+        shadow_order.volume_ahead_ -= std::min(shadow_order.volume_ahead_, trade_size);
+      }
+
+      if (fillable_size > 0) fill(shadow_order, shadow_order.price_, fillable_size);
+
+      if (shadow_order.remaining_size_ == 0) {
+        shadow_orders_.erase(*id_itr);
+        id_itr = order_ids.erase(id_itr);
+      } else {
+        id_itr++;
+      }
+    }
+
+    level_itr = order_ids.empty() ? shadow_levels.erase(level_itr) : std::next(level_itr);
+  }
+}
+
+template<typename MatchingAlgo>
+template<typename ShadowLevels>
+void ShadowOrderSimulator<MatchingAlgo>::reduceVolumeAhead(ShadowLevels &shadow_levels,
+                                                           const PassiveOrder<> &cancelled_order,
+                                                           const SizeType &cancelled_size) {
+  const auto level_itr = shadow_levels.find(cancelled_order.price_);
+  if (level_itr == shadow_levels.end()) return;
+
+  for (const auto &order_id : level_itr->second) {
+    auto &shadow_order = shadow_orders_.at(order_id);
+    if (cancelled_order.sequence_ < shadow_order.sequence_) {
+      shadow_order.volume_ahead_ -= std::min(shadow_order.volume_ahead_, cancelled_size);
+    }
+  }
+}
+
+template<typename MatchingAlgo>
+template<typename HistoricalLevels>
+void ShadowOrderSimulator<MatchingAlgo>::fillAgainstHistoricalLevels(ShadowOrder &shadow_order,
+                                                                     const HistoricalLevels &historical_levels) {
+  // Historical levels are keyed best first for the resting side, stop at the first one the shadow price does not reach
+  for (auto level_itr = historical_levels.begin();
+       level_itr != historical_levels.end() && shadow_order.remaining_size_ > 0
+           && !historical_levels.key_comp()(shadow_order.price_, level_itr->first);
+       level_itr++) {
+
+    SizeType level_size{0};
+    for (const auto &passive_order : level_itr->second) {
+      level_size += passive_order->remaining_size_;
+    }
+    if (level_size > 0) fill(shadow_order, level_itr->first, std::min(level_size, shadow_order.remaining_size_));
+  }
+}
+
+template<typename MatchingAlgo>
+template<typename ShadowLevels>
+void ShadowOrderSimulator<MatchingAlgo>::removeFromLevel(ShadowLevels &shadow_levels,
+                                                         const ShadowOrder &shadow_order) {
+  const auto level_itr = shadow_levels.find(shadow_order.price_);
+  if (level_itr == shadow_levels.end()) return;
+
+  auto &order_ids = level_itr->second;
+  order_ids.erase(std::remove(order_ids.begin(), order_ids.end(), shadow_order.order_id_), order_ids.end());
+  if (order_ids.empty()) shadow_levels.erase(level_itr);
+}
+
+template<typename MatchingAlgo>
+void ShadowOrderSimulator<MatchingAlgo>::fill(ShadowOrder &shadow_order, const PriceType &price,
+                                              const SizeType &size) {
+  const SizeType fill_size = std::min(size, shadow_order.remaining_size_);
+  shadow_order.remaining_size_ -= fill_size;
+  if (fill_handler_) fill_handler_(shadow_order, price, fill_size);
+}
+
+} // end of namespace
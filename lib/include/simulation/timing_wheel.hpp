@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace codetest::matching_engine_sim {
+
+/*
+ * Hierarchical timing wheel keyed by a 64 bit time.
+ *
+ * Level L has 256 slots, each covering 256^L ticks. An entry is placed at the level of the highest 8 bit digit in
+ * which its time differs from the wheel time, in the slot of its own digit there, so scheduling is O(1).
+ * Whenever the wheel time enters a slot of an upper level, that slot is cascaded into lower levels, each entry
+ * moving down at most once per level. Empty stretches of time are skipped via per level occupancy bitmaps
+ * rather than walked tick by tick, so sparse far away entries cost no more than dense ones.
+ *
+ * Entries fire in time order, entries of the same time in the order they were scheduled.
+ * Slot storage is kept across firing, so a wheel in steady state does not allocate.
+ */
+template<typename T>
+class TimingWheel final {
+ public:
+  explicit TimingWheel(const std::uint64_t &start_time = 0) : current_time_(start_time) {}
+  TimingWheel(const TimingWheel &) = default;
+  TimingWheel(TimingWheel &&) noexcept = default;
+  TimingWheel &operator=(const TimingWheel &) = default;
+  TimingWheel &operator=(TimingWheel &&) noexcept = default;
+  ~TimingWheel() = default;
+
+  // Entries in the past are due at the current wheel time
+  void schedule(const std::uint64_t &time, T value);
+
+  // Fires f(time, value) for every entry due at or before time. f may schedule further entries,
+  // which fire within the same call when due.
+  template<typename F>
+  void advance(const std::uint64_t &time, F &&f);
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  // Wheel time only moves as far as the entries require, it may lag behind the time last advanced to
+  [[nodiscard]] std::uint64_t getCurrentTime() const { return current_time_; }
+
+ private:
+  static constexpr unsigned SLOT_BITS = 8;
+  static constexpr std::size_t NUMBER_OF_SLOTS = std::size_t{1} << SLOT_BITS;
+  static constexpr std::size_t NUMBER_OF_LEVELS = 64 / SLOT_BITS;
+  static constexpr std::size_t BITMAP_WORDS = NUMBER_OF_SLOTS / 64;
+
+  struct Entry {
+    std::uint64_t time_{};
+    T value_{};
+  };
+
+  using Slot = std::vector<Entry>;
+
+  [[nodiscard]] static std::size_t digit(const std::uint64_t &time, const std::size_t &level) {
+    return static_cast<std::size_t>(time >> (level * SLOT_BITS)) & (NUMBER_OF_SLOTS - 1);
+  }
+
+  void place(Entry &&entry);
+  void markOccupied(const std::size_t &level, const std::size_t &slot);
+  void markEmpty(const std::size_t &level, const std::size_t &slot);
+  // First occupied slot after the given one within a level, NUMBER_OF_SLOTS if there is none
+  [[nodiscard]] std::size_t nextOccupied(const std::size_t &level, const std::size_t &slot) const;
+  void cascade(const std::size_t &level);
+
+  std::uint64_t current_time_{};
+  std::size_t size_{};
+  std::array<std::array<Slot, NUMBER_OF_SLOTS>, NUMBER_OF_LEVELS> slots_{};
+  std::array<std::array<std::uint64_t, BITMAP_WORDS>, NUMBER_OF_LEVELS> occupied_{};
+  Slot firing_{};
+  Slot cascading_{};
+};
+
+template<typename T>
+void TimingWheel<T>::schedule(const std::uint64_t &time, T value) {
+  place({std::max(time, current_time_), std::move(value)});
+  size_++;
+}
+
+template<typename T>
+void TimingWheel<T>::place(Entry &&entry) {
+  const std::uint64_t difference = entry.time_ ^ current_time_;
+  const std::size_t level = difference == 0
+                            ? 0
+                            : static_cast<std::size_t>(63 - __builtin_clzll(difference)) / SLOT_BITS;
+  const std::size_t slot = digit(entry.time_, level);
+  slots_[level][slot].emplace_back(std::move(entry));
+  markOccupied(level, slot);
+}
+
+template<typename T>
+void TimingWheel<T>::markOccupied(const std::size_t &level, const std::size_t &slot) {
+  occupied_[level][slot / 64] |= std::uint64_t{1} << (slot % 64);
+}
+
+template<typename T>
+void TimingWheel<T>::markEmpty(const std::size_t &level, const std::size_t &slot) {
+  occupied_[level][slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+}
+
+template<typename T>
+std::size_t TimingWheel<T>::nextOccupied(const std::size_t &level, const std::size_t &slot) const {
+  std::size_t word = (slot + 1) / 64;
+  if (word >= BITMAP_WORDS) return NUMBER_OF_SLOTS;
+
+  // Bits of the first word up to and including the given slot are masked off
+  std::uint64_t bits = occupied_[level][word] & (~std::uint64_t{0} << ((slot + 1) % 64));
+  while (true) {
+    if (bits != 0) return word * 64 + static_cast<std::size_t>(__builtin_ctzll(bits));
+    if (++word == BITMAP_WORDS) return NUMBER_OF_SLOTS;
+    bits = occupied_[level][word];
+  }
+}
+
+template<typename T>
+void TimingWheel<T>::cascade(const std::size_t &level) {
+  const std::size_t slot = digit(current_time_, level);
+  cascading_.swap(slots_[level][slot]);
+  markEmpty(level, slot);
+  for (auto &entry : cascading_) {
+    place(std::move(entry));
+  }
+  cascading_.clear();
+}
+
+template<typename T>
+template<typename F>
+void TimingWheel<T>::advance(const std::uint64_t &time, F &&f) {
+  while (true) {
+    // Every entry of the current level 0 slot is due exactly at current wheel time
+    const std::size_t current_slot = digit(current_time_, 0);
+    while (!slots_[0][current_slot].empty()) {
+      firing_.swap(slots_[0][current_slot]);
+      for (auto &entry : firing_) {
+        size_--;
+        f(entry.time_, entry.value_);
+      }
+      firing_.clear();
+    }
+    markEmpty(0, current_slot);
+
+    if (size_ == 0) {
+      current_time_ = std::max(current_time_, time);
+      return;
+    }
+
+    // Earliest slot holding entries, lowest level first. The slot of the current digit is empty on every level
+    // above 0 as it was cascaded on entering it, so the next one is always strictly ahead.
+    std::size_t level = 0;
+    std::size_t slot = NUMBER_OF_SLOTS;
+    for (; level < NUMBER_OF_LEVELS; level++) {
+      slot = nextOccupied(level, digit(current_time_, level));
+      if (slot != NUMBER_OF_SLOTS) break;
+    }
+
+    const std::size_t shift = level * SLOT_BITS;
+    const std::uint64_t upper_mask = (shift + SLOT_BITS >= 64) ? 0 : ~std::uint64_t{0} << (shift + SLOT_BITS);
+    const std::uint64_t next_time = (current_time_ & upper_mask) | (static_cast<std::uint64_t>(slot) << shift);
+    if (next_time > time) return;
+
+    current_time_ = next_time;
+    for (std::size_t cascade_level = level; cascade_level > 0; cascade_level--) {
+      cascade(cascade_level);
+    }
+  }
+}
+
+} // end of namespace
@@ -18,17 +18,51 @@ enum class OrderSide : uint8_t {
 enum class OrderAction : uint8_t {
   NEW = 0,
   CANCEL = 1,
-  _ACTION_SIZE_ = 2
+  // Amends price and/or size of a resting order, size_ being the new remaining size
+  AMEND = 2,
+  // Cancels every resting order of client_ in instrument_, or only those on side_ for MASS_CANCEL_SIDE
+  MASS_CANCEL = 3,
+  MASS_CANCEL_SIDE = 4,
+  _ACTION_SIZE_ = 5,
+  // Engine internal control requests, handled by the engine itself and never reaching matching algo
+  SNAPSHOT_BARRIER = 0x80
 };
 
 enum class OrderType : uint8_t {
   LIMIT = 0,
-  MARKET = 1
+  MARKET = 1,
+  // Waits off the book until a trade reaches its trigger price, then enters as a market order
+  STOP = 2,
+  // Waits off the book until a trade reaches its trigger price, then enters as a limit order at its price
+  STOP_LIMIT = 3,
+  // Rests at the best price of its own side, following it as it moves
+  PRIMARY_PEG = 4,
+  // Rests at the mid of best bid and best offer, rounded away from the opposite side, following it as it moves
+  MID_PEG = 5
+};
+
+[[nodiscard]] constexpr bool isPegOrderType(const OrderType &order_type) {
+  return order_type == OrderType::PRIMARY_PEG || order_type == OrderType::MID_PEG;
+}
+
+// How long what is left of an order after matching rests in the book
+enum class TimeInForce : uint8_t {
+  // Good till cancelled, rests until filled or cancelled
+  GTC = 0,
+  // Immediate or cancel, never rests
+  IOC = 1,
+  // Fill or kill, either fills in full on entry or is rejected without trading
+  FOK = 2,
+  // Good till time, rests until expire_time_ at the latest. Day and good till date orders are good till time orders
+  // expiring at the end of their day or date.
+  GTT = 3
 };
 
 enum class OrderRequestResult : uint8_t {
   NACK = 0,
-  ACK = 1
+  ACK = 1,
+  // Unsolicited, resting order taken out of the book by the engine itself, the validation response telling why
+  CANCELLED = 2
 };
 
 enum class ValidationResponse : uint8_t {
@@ -39,7 +73,12 @@ enum class ValidationResponse : uint8_t {
   ORDER_ID_PREEXIST = 4,
   ORDER_SIZE_EXCEED_LIMIT = 5,
   SELF_MATCH = 6,
-  INVALID_ORDER_REQUEST = 7
+  INVALID_ORDER_REQUEST = 7,
+  // Fill or kill order without enough liquidity to fill it in full
+  NOT_FILLABLE = 8,
+  // Good till time order taken out of the book on expiry, reported as CANCELLED
+  ORDER_EXPIRED = 9,
+  _RESPONSE_SIZE_ = 10
 };
 
 } // end of namespace
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "engine/snapshot_barrier.h"
+
+namespace codetest::matching_engine_sim {
+
+SnapshotBarrier::SnapshotBarrier(const std::string &directory, const std::size_t &number_of_instruments)
+    : directory_(directory), outstanding_instruments_(number_of_instruments) {}
+
+bool SnapshotBarrier::isComplete() const {
+  std::lock_guard<std::mutex> _{mutex_};
+  return outstanding_instruments_ == 0;
+}
+
+void SnapshotBarrier::wait() const {
+  std::unique_lock<std::mutex> lock{mutex_};
+  completed_.wait(lock, [this] { return outstanding_instruments_ == 0; });
+  if (failure_) std::rethrow_exception(failure_);
+}
+
+void SnapshotBarrier::onInstrumentSaved() {
+  std::lock_guard<std::mutex> _{mutex_};
+  if (--outstanding_instruments_ == 0) completed_.notify_all();
+}
+
+void SnapshotBarrier::onInstrumentFailed(const std::exception_ptr &failure) {
+  std::lock_guard<std::mutex> _{mutex_};
+  if (!failure_) failure_ = failure;
+  if (--outstanding_instruments_ == 0) completed_.notify_all();
+}
+
+} // end of namespace
@@ -11,13 +11,46 @@
 #include "matching/validators/matching_validators.hpp"
 #include "matching/validators/new_order_request_validators.hpp"
 #include "matching/validators/cancel_request_validators.hpp"
+#include "matching/validators/amend_request_validators.hpp"
 #include "matching/validators/validators.hpp"
 
+#include "matching/fixed_block_pool.h"
 #include "matching/passive_order.h"
+#include "matching/trigger_order_book.hpp"
 #include "matching/passive_order_book.hpp"
 #include "matching/matching_algo.hpp"
+#include "matching/pro_rata_matching.hpp"
+#include "matching/call_auction_matching.hpp"
+
+#include "persistence/mapped_file.h"
+#include "persistence/journal_options.h"
+#include "persistence/order_ext_codec.h"
+#include "persistence/request_journal.hpp"
+#include "persistence/book_snapshot.hpp"
+#include "persistence/trade_tape.h"
+
+#include "replay/order_flow_file.h"
+#include "replay/order_flow_replay.hpp"
+#include "replay/backtest_runner.h"
+
+#include "simulation/timing_wheel.hpp"
+#include "simulation/latency_model.h"
+#include "simulation/latency_simulator.hpp"
+#include "simulation/shadow_order_simulator.hpp"
+
+#include "monitoring/latency_histogram.h"
+#include "monitoring/latency_tracking_options.h"
+#include "monitoring/latency_tracker.h"
+#include "monitoring/engine_counters.h"
+
+#include "loadgen/order_flow_generator.h"
+#include "loadgen/load_generator.h"
 
 #include "external/i_client.h"
 
 #include "engine/default_engine_event_handler.h"
+#include "engine/null_engine_event_observer.h"
+#include "engine/matching_engine_options.h"
+#include "engine/snapshot_barrier.h"
 #include "engine/matching_engine.h"
+#include "engine/synchronous_matching_engine.h"
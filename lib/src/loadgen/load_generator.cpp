@@ -0,0 +1,215 @@
+#include "loadgen/load_generator.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "monitoring/latency_histogram.h"
+#include "monitoring/latency_tracker.h"
+
+namespace codetest::matching_engine_sim {
+
+namespace {
+
+// Order ids carry the producer above this bit and the producer's order sequence below it
+constexpr unsigned PRODUCER_ORDER_ID_SHIFT = 40;
+constexpr OrderIDType ORDER_SEQUENCE_MASK = (OrderIDType{1} << PRODUCER_ORDER_ID_SHIFT) - 1;
+
+} // end of anonymous local namespace
+
+class LoadGenerator::ResponseTimingObserver final : public IEngineEventObserver {
+ public:
+  ResponseTimingObserver(LoadGenerator &load_generator,
+                         const std::shared_ptr<IEngineEventObserver> &downstream_observer)
+      : load_generator_(load_generator), downstream_observer_(downstream_observer) {}
+
+  void doTradeEvent(
+      const ClientType &client1,
+      const OrderIDType &client1_order_id,
+      const ClientType &client2,
+      const OrderIDType &client2_order_id,
+      const InstrumentType &instrument,
+      const PriceType &trade_price,
+      const SizeType &size) override {
+    if (downstream_observer_) {
+      downstream_observer_->doTradeEvent(client1, client1_order_id, client2, client2_order_id, instrument,
+                                         trade_price, size);
+    }
+  }
+
+  void doOrderRequestResponse(
+      const ClientType &client,
+      const OrderIDType &client_order_id,
+      const InstrumentType &instrument,
+      const PriceType &order_price,
+      const SizeType &order_size,
+      const OrderRequestResult &order_request_result,
+      const ValidationResponse &validation_response) override {
+    const auto producer = static_cast<std::size_t>(client_order_id >> PRODUCER_ORDER_ID_SHIFT);
+    const auto sequence = client_order_id & ORDER_SEQUENCE_MASK;
+    auto &producer_slots = load_generator_.producer_slots_;
+
+    // Only the first response times a new order, later ones belong to the same order or to its cancel
+    if (producer < producer_slots.size() && sequence < load_generator_.run_options_.requests_per_producer_) {
+      auto &responded = producer_slots[producer].responded_[sequence];
+      if (responded.load(std::memory_order_relaxed) == 0) {
+        responded.store(std::max<std::uint64_t>(1, readTimestampCounter()), std::memory_order_relaxed);
+        load_generator_.responded_new_orders_.fetch_add(1, std::memory_order_release);
+      }
+    }
+
+    if (downstream_observer_) {
+      downstream_observer_->doOrderRequestResponse(client, client_order_id, instrument, order_price, order_size,
+                                                   order_request_result, validation_response);
+    }
+  }
+
+  void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) override {
+    if (downstream_observer_) downstream_observer_->setClientMap(clients);
+  }
+
+ private:
+  LoadGenerator &load_generator_;
+  std::shared_ptr<IEngineEventObserver> downstream_observer_{};
+};
+
+double LoadRunReport::sendRate() const {
+  return send_time_.count() == 0 ? 0 : static_cast<double>(requests_) * 1e9 / static_cast<double>(send_time_.count());
+}
+
+double LoadRunReport::throughput() const {
+  return elapsed_.count() == 0 ? 0 : static_cast<double>(requests_) * 1e9 / static_cast<double>(elapsed_.count());
+}
+
+LoadGenerator::LoadGenerator(const OrderFlowGeneratorConfig &flow_config,
+                             const LoadRunOptions &run_options,
+                             const std::shared_ptr<IEngineEventObserver> &downstream_observer)
+    : flow_config_(flow_config), run_options_(run_options) {
+  if (run_options.producers_ == 0) {
+    throw std::invalid_argument("load generator needs at least one producer");
+  }
+  if (run_options.requests_per_producer_ > ORDER_SEQUENCE_MASK) {
+    throw std::invalid_argument("too many requests per producer");
+  }
+
+  producer_slots_.reserve(run_options.producers_);
+  for (std::size_t producer = 0; producer < run_options.producers_; producer++) {
+    producer_slots_.emplace_back(run_options.requests_per_producer_);
+  }
+  observer_ = std::make_shared<ResponseTimingObserver>(*this, downstream_observer);
+}
+
+OrderFlowGeneratorConfig LoadGenerator::getProducerFlowConfig(const std::size_t &producer) const {
+  auto config = flow_config_;
+  if (run_options_.target_rate_ > 0) {
+    config.rate_ = run_options_.target_rate_ / static_cast<double>(run_options_.producers_);
+  }
+  config.seed_ = flow_config_.seed_ + producer;
+  config.first_client_ = flow_config_.first_client_ + producer * flow_config_.clients_;
+  config.first_order_id_ = static_cast<OrderIDType>(producer) << PRODUCER_ORDER_ID_SHIFT;
+  return config;
+}
+
+void LoadGenerator::produce(const std::size_t &producer, IMatchingEngine<void> &matching_engine,
+                            const std::uint64_t &start) {
+  OrderFlowGenerator generator{getProducerFlowConfig(producer)};
+  auto &slots = producer_slots_[producer];
+  const bool paced = run_options_.target_rate_ > 0;
+  const double ticks_per_nanosecond = timestampCounterTicksPerNanosecond();
+
+  for (std::uint64_t cnt = 0; cnt < run_options_.requests_per_producer_; cnt++) {
+    const auto generated = generator.next();
+    const auto &order_request = generated.order_request_;
+
+    if (paced) {
+      const auto due = start + static_cast<std::uint64_t>(static_cast<double>(generated.timestamp_)
+                                                              * ticks_per_nanosecond);
+      while (readTimestampCounter() < due) {}
+    }
+
+    const auto now = readTimestampCounter();
+    if (cnt == 0) slots.first_submission_ = now;
+    if (order_request.order_action_ == OrderAction::NEW) {
+      slots.submitted_[order_request.cln_order_id_ & ORDER_SEQUENCE_MASK] = now;
+      slots.new_orders_++;
+    }
+    slots.requests_++;
+    matching_engine.doOrderRequest(order_request);
+  }
+  slots.last_submission_ = readTimestampCounter();
+}
+
+LoadRunReport LoadGenerator::run(IMatchingEngine<void> &matching_engine) {
+  if (has_run_) throw std::runtime_error("load generator runs only once");
+  has_run_ = true;
+
+  const double ticks_per_nanosecond = timestampCounterTicksPerNanosecond();
+  const auto start = readTimestampCounter();
+
+  std::vector<std::exception_ptr> failures(run_options_.producers_);
+  std::vector<std::thread> producers;
+  for (std::size_t producer = 0; producer < run_options_.producers_; producer++) {
+    producers.emplace_back([&, producer] {
+      try {
+        produce(producer, matching_engine, start);
+      } catch (...) {
+        failures[producer] = std::current_exception();
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  for (const auto &failure : failures) {
+    if (failure) std::rethrow_exception(failure);
+  }
+
+  LoadRunReport report;
+  std::uint64_t first_submission = ~std::uint64_t{0};
+  std::uint64_t last_submission{0};
+  for (const auto &slots : producer_slots_) {
+    report.requests_ += slots.requests_;
+    report.new_orders_ += slots.new_orders_;
+    if (slots.requests_ > 0) {
+      first_submission = std::min(first_submission, slots.first_submission_);
+      last_submission = std::max(last_submission, slots.last_submission_);
+    }
+  }
+
+  const auto drain_deadline = std::chrono::steady_clock::now() + run_options_.drain_timeout_;
+  while (responded_new_orders_.load(std::memory_order_acquire) < report.new_orders_
+      && std::chrono::steady_clock::now() < drain_deadline) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  report.responded_new_orders_ = responded_new_orders_.load(std::memory_order_acquire);
+
+  LatencyHistogram latency_histogram;
+  std::uint64_t last_response{0};
+  for (const auto &slots : producer_slots_) {
+    for (std::uint64_t sequence = 0; sequence < slots.new_orders_; sequence++) {
+      const auto responded = slots.responded_[sequence].load(std::memory_order_relaxed);
+      if (responded == 0) continue;
+      const auto submitted = slots.submitted_[sequence];
+      latency_histogram.record(responded > submitted ? responded - submitted : 0);
+      last_response = std::max(last_response, responded);
+    }
+  }
+
+  const auto nanoseconds = [&](const double &ticks) { return ticks / ticks_per_nanosecond; };
+  if (report.requests_ > 0) {
+    report.send_time_ = std::chrono::nanoseconds{static_cast<std::int64_t>(
+        nanoseconds(static_cast<double>(last_submission - first_submission)))};
+    report.elapsed_ = std::chrono::nanoseconds{static_cast<std::int64_t>(
+        nanoseconds(static_cast<double>(std::max(last_response, last_submission) - first_submission)))};
+  }
+  report.latency_mean_ = nanoseconds(latency_histogram.getMean());
+  report.latency_p50_ = nanoseconds(static_cast<double>(latency_histogram.getValueAtPercentile(50)));
+  report.latency_p90_ = nanoseconds(static_cast<double>(latency_histogram.getValueAtPercentile(90)));
+  report.latency_p99_ = nanoseconds(static_cast<double>(latency_histogram.getValueAtPercentile(99)));
+  report.latency_p999_ = nanoseconds(static_cast<double>(latency_histogram.getValueAtPercentile(99.9)));
+  report.latency_max_ = nanoseconds(static_cast<double>(latency_histogram.getMax()));
+  return report;
+}
+
+} // end of namespace
@@ -0,0 +1,177 @@
+#include "loadgen/order_flow_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "replay/order_flow_file.h"
+
+namespace codetest::matching_engine_sim {
+
+namespace {
+
+void validateConfig(const OrderFlowGeneratorConfig &config) {
+  if (config.instruments_ == 0 || config.clients_ == 0) {
+    throw std::invalid_argument("order flow needs at least one instrument and one client");
+  }
+  if (!(config.rate_ > 0)) {
+    throw std::invalid_argument("order flow rate must be positive");
+  }
+  if (config.min_size_ == 0 || config.min_size_ > config.max_size_) {
+    throw std::invalid_argument("order size range must be positive and non-empty");
+  }
+  if (config.arrival_process_ == ArrivalProcess::HAWKES
+      && (config.hawkes_alpha_ < 0 || !(config.hawkes_beta_ > 0)
+          || config.hawkes_alpha_ >= config.hawkes_beta_)) {
+    throw std::invalid_argument("Hawkes process requires 0 <= alpha < beta");
+  }
+}
+
+std::vector<double> zipfWeights(const InstrumentType &instruments, const double &exponent) {
+  std::vector<double> weights;
+  weights.reserve(instruments);
+  for (InstrumentType rank = 1; rank <= instruments; rank++) {
+    weights.push_back(1.0 / std::pow(static_cast<double>(rank), exponent));
+  }
+  return weights;
+}
+
+} // end of anonymous local namespace
+
+OrderFlowGenerator::OrderFlowGenerator(const OrderFlowGeneratorConfig &config)
+    : config_((validateConfig(config), config)),
+      random_engine_(config.seed_),
+      client_distribution_(0, config.clients_ - 1),
+      size_distribution_(config.min_size_, config.max_size_),
+      price_offset_distribution_(1.0 / (1.0 + std::max(0.0, config.price_offset_mean_))),
+      next_order_id_(config.first_order_id_),
+      mids_(config.instruments_, config.initial_mid_),
+      live_orders_(config.instruments_) {
+
+  const auto weights = zipfWeights(config.instruments_, config.zipf_exponent_);
+  instrument_distribution_ = std::discrete_distribution<std::size_t>(weights.begin(), weights.end());
+
+  // Stationary Hawkes rate is baseline / (1 - alpha / beta), baseline chosen for the configured mean rate
+  baseline_intensity_ = config.rate_;
+  if (config.arrival_process_ == ArrivalProcess::HAWKES) {
+    baseline_intensity_ = config.rate_ * (1.0 - config.hawkes_alpha_ / config.hawkes_beta_);
+  }
+}
+
+double OrderFlowGenerator::nextArrivalTime() {
+  if (config_.arrival_process_ == ArrivalProcess::POISSON) {
+    return time_ + std::exponential_distribution<double>{baseline_intensity_}(random_engine_);
+  }
+
+  // Ogata thinning, intensity only decays between arrivals so its current value bounds it until the next one
+  double time = time_;
+  while (true) {
+    const double intensity_bound = baseline_intensity_ + excitation_;
+    const double wait = std::exponential_distribution<double>{intensity_bound}(random_engine_);
+    time += wait;
+    excitation_ *= std::exp(-config_.hawkes_beta_ * wait);
+    if (unit_distribution_(random_engine_) * intensity_bound <= baseline_intensity_ + excitation_) {
+      excitation_ += config_.hawkes_alpha_;
+      return time;
+    }
+  }
+}
+
+PriceType OrderFlowGenerator::nextMid(const std::size_t &instrument_index) {
+  auto &mid = mids_[instrument_index];
+  if (unit_distribution_(random_engine_) < config_.mid_move_probability_) {
+    if (unit_distribution_(random_engine_) < 0.5) {
+      mid++;
+    } else if (mid > 1) {
+      mid--;
+    }
+  }
+  return mid;
+}
+
+GeneratedOrderRequest OrderFlowGenerator::next() {
+  time_ = nextArrivalTime();
+
+  const auto instrument_index = instrument_distribution_(random_engine_);
+  const auto mid = nextMid(instrument_index);
+  auto &live_orders = live_orders_[instrument_index];
+
+  GeneratedOrderRequest generated;
+  generated.timestamp_ = static_cast<std::uint64_t>(std::llround(time_ * 1e9));
+  auto &order_request = generated.order_request_;
+  order_request.instrument_ = config_.first_instrument_ + instrument_index;
+  order_request.order_type_ = OrderType::LIMIT;
+
+  if (!live_orders.empty() && unit_distribution_(random_engine_) < config_.cancel_ratio_) {
+    const auto index = std::uniform_int_distribution<std::size_t>{0, live_orders.size() - 1}(random_engine_);
+    const auto live_order = live_orders[index];
+    live_orders[index] = live_orders.back();
+    live_orders.pop_back();
+
+    order_request.order_action_ = OrderAction::CANCEL;
+    order_request.client_ = live_order.client_;
+    order_request.cln_order_id_ = live_order.cln_order_id_;
+    order_request.side_ = live_order.side_;
+    order_request.price_ = live_order.price_;
+    return generated;
+  }
+
+  order_request.order_action_ = OrderAction::NEW;
+  order_request.client_ = config_.first_client_ + client_distribution_(random_engine_);
+  order_request.cln_order_id_ = next_order_id_++;
+  order_request.size_ = size_distribution_(random_engine_);
+  order_request.side_ = unit_distribution_(random_engine_) < 0.5 ? OrderSide::BUY : OrderSide::SELL;
+
+  if (unit_distribution_(random_engine_) < config_.market_order_ratio_) {
+    order_request.order_type_ = OrderType::MARKET;
+    return generated;
+  }
+
+  // Buy below mid or sell above it rests, the other way round crosses
+  const PriceType distance = 1 + price_offset_distribution_(random_engine_);
+  const bool aggressive = unit_distribution_(random_engine_) < config_.aggressive_ratio_;
+  if ((order_request.side_ == OrderSide::BUY) != aggressive) {
+    order_request.price_ = mid > distance ? mid - distance : 1;
+  } else {
+    order_request.price_ = mid + distance;
+  }
+
+  const LiveOrder live_order{order_request.client_, order_request.cln_order_id_, order_request.side_,
+                             order_request.price_};
+  if (live_orders.size() < config_.max_live_orders_) {
+    live_orders.push_back(live_order);
+  } else if (!live_orders.empty()) {
+    live_orders[std::uniform_int_distribution<std::size_t>{0, live_orders.size() - 1}(random_engine_)] = live_order;
+  }
+  return generated;
+}
+
+void writeGeneratedOrderFlow(const OrderFlowGeneratorConfig &config, const std::uint64_t &count,
+                             const std::string &path) {
+  OrderFlowGenerator generator{config};
+  OrderFlowFileWriter writer{path};
+
+  for (std::uint64_t cnt = 0; cnt < count; cnt++) {
+    const auto generated = generator.next();
+    const auto &order_request = generated.order_request_;
+
+    OrderFlowRecord record;
+    record.timestamp_ = generated.timestamp_;
+    record.instrument_ = order_request.instrument_;
+    record.client_ = order_request.client_;
+    record.cln_order_id_ = order_request.cln_order_id_;
+    record.price_ = order_request.price_;
+    record.size_ = order_request.size_;
+    record.side_ = static_cast<std::uint8_t>(order_request.side_);
+    record.order_action_ = static_cast<std::uint8_t>(order_request.order_action_);
+    record.order_type_ = static_cast<std::uint8_t>(order_request.order_type_);
+    record.time_in_force_ = static_cast<std::uint8_t>(order_request.time_in_force_);
+    record.expire_time_ = order_request.expire_time_;
+    record.trigger_price_ = order_request.trigger_price_;
+    record.display_size_ = order_request.display_size_;
+    writer.append(record);
+  }
+  writer.close();
+}
+
+} // end of namespace
@@ -0,0 +1,51 @@
+#include "matching/fixed_block_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace codetest::matching_engine_sim {
+
+FixedBlockPool::FixedBlockPool(const std::size_t &blocks_per_chunk) : blocks_per_chunk_(blocks_per_chunk) {
+  if (blocks_per_chunk == 0) {
+    throw std::invalid_argument("pool chunk needs at least one block");
+  }
+}
+
+void *FixedBlockPool::allocate(const std::size_t &size, const std::size_t &alignment) {
+  std::lock_guard<std::mutex> _{mutex_};
+
+  if (block_size_ == 0) {
+    // Rounded up so that every block in a chunk stays aligned, and can hold the free list link
+    constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+    block_size_ = std::max(size, sizeof(FreeBlock));
+    block_size_ = (block_size_ + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+  }
+  if (!fits(size, alignment)) return nullptr;
+
+  if (free_list_ == nullptr) addChunk();
+  FreeBlock *block = free_list_;
+  free_list_ = block->next_;
+  return block;
+}
+
+void FixedBlockPool::deallocate(void *block) noexcept {
+  std::lock_guard<std::mutex> _{mutex_};
+  free_list_ = new(block) FreeBlock{free_list_};
+}
+
+std::size_t FixedBlockPool::getCapacity() const {
+  std::lock_guard<std::mutex> _{mutex_};
+  return chunks_.size() * blocks_per_chunk_;
+}
+
+void FixedBlockPool::addChunk() {
+  chunks_.push_back(std::make_unique<std::byte[]>(block_size_ * blocks_per_chunk_));
+  std::byte *chunk = chunks_.back().get();
+
+  // Threaded back to front so that blocks are handed out in address order
+  for (std::size_t index = blocks_per_chunk_; index > 0; index--) {
+    free_list_ = new(chunk + (index - 1) * block_size_) FreeBlock{free_list_};
+  }
+}
+
+} // end of namespace
@@ -0,0 +1,61 @@
+#include "monitoring/engine_counters.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "monitoring/latency_tracker.h"
+
+namespace codetest::matching_engine_sim {
+
+namespace {
+
+std::chrono::nanoseconds ticksToNanoseconds(const std::uint64_t &ticks) {
+  if (ticks == 0) return std::chrono::nanoseconds{0};
+  return std::chrono::nanoseconds{
+      static_cast<std::int64_t>(static_cast<double>(ticks) / timestampCounterTicksPerNanosecond())};
+}
+
+} // end of anonymous local namespace
+
+std::uint64_t EngineCounters::getNacks() const {
+  return std::accumulate(nacks_.begin(), nacks_.end(), std::uint64_t{0});
+}
+
+EngineCounters &EngineCounters::operator+=(const EngineCounters &other) {
+  requests_ += other.requests_;
+  cancels_ += other.cancels_;
+  amends_ += other.amends_;
+  mass_cancels_ += other.mass_cancels_;
+  acks_ += other.acks_;
+  for (std::size_t index = 0; index < nacks_.size(); index++) {
+    nacks_[index] += other.nacks_[index];
+  }
+  unsolicited_cancels_ += other.unsolicited_cancels_;
+  trades_ += other.trades_;
+  traded_volume_ += other.traded_volume_;
+  queue_depth_high_water_mark_ = std::max(queue_depth_high_water_mark_, other.queue_depth_high_water_mark_);
+  busy_time_ += other.busy_time_;
+  idle_time_ += other.idle_time_;
+  return *this;
+}
+
+EngineCounters EngineCounterBlock::read() const {
+  EngineCounters counters;
+  counters.requests_ = requests_.load(std::memory_order_relaxed);
+  counters.cancels_ = cancels_.load(std::memory_order_relaxed);
+  counters.amends_ = amends_.load(std::memory_order_relaxed);
+  counters.mass_cancels_ = mass_cancels_.load(std::memory_order_relaxed);
+  counters.acks_ = acks_.load(std::memory_order_relaxed);
+  for (std::size_t index = 0; index < nacks_.size(); index++) {
+    counters.nacks_[index] = nacks_[index].load(std::memory_order_relaxed);
+  }
+  counters.unsolicited_cancels_ = unsolicited_cancels_.load(std::memory_order_relaxed);
+  counters.trades_ = trades_.load(std::memory_order_relaxed);
+  counters.traded_volume_ = traded_volume_.load(std::memory_order_relaxed);
+  counters.queue_depth_high_water_mark_ = queue_depth_high_water_mark_.load(std::memory_order_relaxed);
+  counters.busy_time_ = ticksToNanoseconds(busy_ticks_.load(std::memory_order_relaxed));
+  counters.idle_time_ = ticksToNanoseconds(idle_ticks_.load(std::memory_order_relaxed));
+  return counters;
+}
+
+} // end of namespace
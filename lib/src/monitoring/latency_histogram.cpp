@@ -0,0 +1,40 @@
+#include "monitoring/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace codetest::matching_engine_sim {
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+  for (std::size_t index = 0; index < BUCKET_COUNT; index++) {
+    const auto count = other.counts_[index].load(std::memory_order_relaxed);
+    if (count > 0) increment(counts_[index], count);
+  }
+  increment(total_count_, other.total_count_.load(std::memory_order_relaxed));
+  increment(total_value_, other.total_value_.load(std::memory_order_relaxed));
+  max_.store(std::max(getMax(), other.getMax()), std::memory_order_relaxed);
+}
+
+double LatencyHistogram::getMean() const {
+  const auto count = getCount();
+  return count == 0 ? 0 : static_cast<double>(total_value_.load(std::memory_order_relaxed))
+      / static_cast<double>(count);
+}
+
+std::uint64_t LatencyHistogram::getValueAtPercentile(const double &percentile) const {
+  const auto count = getCount();
+  if (count == 0) return 0;
+
+  const auto fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+  const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(
+      std::ceil(fraction * static_cast<double>(count))));
+
+  std::uint64_t seen{0};
+  for (std::size_t index = 0; index < BUCKET_COUNT; index++) {
+    seen += counts_[index].load(std::memory_order_relaxed);
+    if (seen >= rank) return std::min(bucketHighestValue(index), getMax());
+  }
+  return getMax();
+}
+
+} // end of namespace
@@ -0,0 +1,99 @@
+#include "monitoring/latency_tracker.h"
+
+#include <cstdio>
+#include <thread>
+
+namespace codetest::matching_engine_sim {
+
+namespace {
+
+constexpr std::chrono::milliseconds CALIBRATION_PERIOD{20};
+
+double calibrateTimestampCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+  const auto start_time = std::chrono::steady_clock::now();
+  const auto start_ticks = readTimestampCounter();
+  std::this_thread::sleep_for(CALIBRATION_PERIOD);
+  const auto end_ticks = readTimestampCounter();
+  const auto end_time = std::chrono::steady_clock::now();
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+  return elapsed <= 0 ? 1.0 : static_cast<double>(end_ticks - start_ticks) / static_cast<double>(elapsed);
+#else
+  return 1.0;
+#endif
+}
+
+// Time stamps taken on different cores may be slightly out of order
+inline std::uint64_t elapsedTicks(const std::uint64_t &from, const std::uint64_t &to) {
+  return to > from ? to - from : 0;
+}
+
+void writeStageLines(std::ostream &os, const std::string &label, const LatencyTracker *const *latency_trackers,
+                     const std::size_t &count, const double &ticks_per_nanosecond) {
+  for (std::size_t stage = 0; stage < static_cast<std::size_t>(LatencyStage::_STAGE_SIZE_); stage++) {
+    LatencyHistogram histogram;
+    for (std::size_t index = 0; index < count; index++) {
+      histogram.merge(latency_trackers[index]->getHistogram(static_cast<LatencyStage>(stage)));
+    }
+
+    const auto nanoseconds = [&](const double &ticks) { return ticks / ticks_per_nanosecond; };
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-10s %-12s %12llu %12.0f %12.0f %12.0f %12.0f %12.0f %12.0f\n",
+                  label.c_str(),
+                  toString(static_cast<LatencyStage>(stage)),
+                  static_cast<unsigned long long>(histogram.getCount()),
+                  nanoseconds(histogram.getMean()),
+                  nanoseconds(static_cast<double>(histogram.getValueAtPercentile(50))),
+                  nanoseconds(static_cast<double>(histogram.getValueAtPercentile(90))),
+                  nanoseconds(static_cast<double>(histogram.getValueAtPercentile(99))),
+                  nanoseconds(static_cast<double>(histogram.getValueAtPercentile(99.9))),
+                  nanoseconds(static_cast<double>(histogram.getMax())));
+    os << line;
+  }
+}
+
+} // end of anonymous local namespace
+
+double timestampCounterTicksPerNanosecond() {
+  static const double ticks_per_nanosecond = calibrateTimestampCounter();
+  return ticks_per_nanosecond;
+}
+
+const char *toString(const LatencyStage &latency_stage) {
+  switch (latency_stage) {
+    case LatencyStage::QUEUEING: return "QUEUEING";
+    case LatencyStage::FIRST_EVENT: return "FIRST_EVENT";
+    case LatencyStage::PROCESSING: return "PROCESSING";
+    case LatencyStage::END_TO_END: return "END_TO_END";
+    default: return "UNKNOWN";
+  }
+}
+
+void LatencyTracker::recordRequest(const std::uint64_t &submitted,
+                                   const std::uint64_t &dequeued,
+                                   const std::uint64_t &first_event,
+                                   const std::uint64_t &matched) noexcept {
+  histograms_[static_cast<std::size_t>(LatencyStage::QUEUEING)].record(elapsedTicks(submitted, dequeued));
+  if (first_event != 0) {
+    histograms_[static_cast<std::size_t>(LatencyStage::FIRST_EVENT)].record(elapsedTicks(dequeued, first_event));
+  }
+  histograms_[static_cast<std::size_t>(LatencyStage::PROCESSING)].record(elapsedTicks(dequeued, matched));
+  histograms_[static_cast<std::size_t>(LatencyStage::END_TO_END)].record(elapsedTicks(submitted, matched));
+}
+
+void writeLatencyReport(std::ostream &os, const std::vector<const LatencyTracker *> &latency_trackers) {
+  const auto ticks_per_nanosecond = timestampCounterTicksPerNanosecond();
+
+  char header[256];
+  std::snprintf(header, sizeof(header), "%-10s %-12s %12s %12s %12s %12s %12s %12s %12s\n",
+                "thread", "stage", "count", "mean(ns)", "p50(ns)", "p90(ns)", "p99(ns)", "p99.9(ns)", "max(ns)");
+  os << header;
+
+  for (std::size_t index = 0; index < latency_trackers.size(); index++) {
+    writeStageLines(os, std::to_string(index), &latency_trackers[index], 1, ticks_per_nanosecond);
+  }
+  writeStageLines(os, "all", latency_trackers.data(), latency_trackers.size(), ticks_per_nanosecond);
+}
+
+} // end of namespace
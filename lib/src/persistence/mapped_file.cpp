@@ -0,0 +1,128 @@
+#include "persistence/mapped_file.h"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace codetest::matching_engine_sim {
+
+namespace {
+
+[[noreturn]] void throwSystemError(const std::string &what, const std::string &path) {
+  throw std::system_error(errno, std::generic_category(), what + " " + path);
+}
+
+} // end of anonymous local namespace
+
+MappedFile::MappedFile(const std::string &path, const Mode &mode, const std::size_t &size)
+    : path_(path), mode_(mode) {
+
+  if (mode_ == Mode::READ_WRITE) {
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) throwSystemError("failed to create", path_);
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+      ::close(fd_);
+      throwSystemError("failed to size", path_);
+    }
+    size_ = size;
+  } else {
+    fd_ = ::open(path_.c_str(), O_RDONLY);
+    if (fd_ < 0) throwSystemError("failed to open", path_);
+    struct stat file_stat{};
+    if (::fstat(fd_, &file_stat) != 0) {
+      ::close(fd_);
+      throwSystemError("failed to stat", path_);
+    }
+    size_ = static_cast<std::size_t>(file_stat.st_size);
+  }
+
+  // mmap refuses zero length mapping, an empty file is simply left unmapped
+  if (size_ == 0) return;
+
+  const int protection = (mode_ == Mode::READ_WRITE) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  void *addr = ::mmap(nullptr, size_, protection, MAP_SHARED, fd_, 0);
+  if (addr == MAP_FAILED) {
+    ::close(fd_);
+    fd_ = -1;
+    throwSystemError("failed to map", path_);
+  }
+  data_ = static_cast<char *>(addr);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : path_(std::move(other.path_)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      fd_(std::exchange(other.fd_, -1)),
+      mode_(other.mode_) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    close();
+    path_ = std::move(other.path_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    fd_ = std::exchange(other.fd_, -1);
+    mode_ = other.mode_;
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+void MappedFile::sync(const std::size_t &offset, const std::size_t &length, const bool &blocking) {
+  if (!data_ || length == 0) return;
+
+  static const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const std::size_t aligned_offset = offset - (offset % page_size);
+
+  if (::msync(data_ + aligned_offset, offset + length - aligned_offset, blocking ? MS_SYNC : MS_ASYNC) != 0) {
+    throwSystemError("failed to sync", path_);
+  }
+}
+
+void MappedFile::adviseSequential() {
+  if (data_) {
+    // madvise advices are not flags, each has to be given separately
+    ::madvise(data_, size_, MADV_SEQUENTIAL);
+    ::madvise(data_, size_, MADV_WILLNEED);
+  }
+}
+
+void MappedFile::close() {
+  if (data_) {
+    ::munmap(data_, size_);
+    data_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  size_ = 0;
+}
+
+void MappedFile::close(const std::size_t &final_size) {
+  if (data_) {
+    ::munmap(data_, size_);
+    data_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    if (mode_ == Mode::READ_WRITE && ::ftruncate(fd_, static_cast<off_t>(final_size)) != 0) {
+      ::close(fd_);
+      fd_ = -1;
+      throwSystemError("failed to truncate", path_);
+    }
+    ::close(fd_);
+    fd_ = -1;
+  }
+  size_ = 0;
+}
+
+} // end of namespace
@@ -0,0 +1,241 @@
+#include "persistence/trade_tape.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace codetest::matching_engine_sim {
+
+namespace {
+
+constexpr std::array<const char *, TRADE_TAPE_COLUMN_SIZE> TRADE_TAPE_COLUMN_NAMES{
+    "timestamp",
+    "instrument",
+    "price",
+    "size",
+    "aggressor_client",
+    "aggressor_order_id",
+    "passive_client",
+    "passive_order_id"
+};
+
+std::string segmentFileStem(const std::string &directory, const std::uint32_t &shard, const std::uint64_t &segment) {
+  char file_stem[48];
+  std::snprintf(file_stem, sizeof(file_stem), "tape_%04u_%08llu", shard, static_cast<unsigned long long>(segment));
+  return (std::filesystem::path(directory) / file_stem).string();
+}
+
+std::string columnFilePath(const std::string &directory,
+                           const std::uint32_t &shard,
+                           const std::uint64_t &segment,
+                           const std::size_t &column) {
+  return segmentFileStem(directory, shard, segment) + "." + TRADE_TAPE_COLUMN_NAMES[column] + ".col";
+}
+
+std::string indexFilePath(const std::string &directory, const std::uint32_t &shard, const std::uint64_t &segment) {
+  return segmentFileStem(directory, shard, segment) + ".idx";
+}
+
+std::uint64_t systemClockNanoseconds() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // end of anonymous local namespace
+
+bool TradeTapeSegmentIndex::mayContain(const TradeTapeColumn &column,
+                                       const std::uint64_t &low,
+                                       const std::uint64_t &high) const {
+  const auto column_index = static_cast<std::size_t>(column);
+  return row_count_ > 0 && min_[column_index] <= high && max_[column_index] >= low;
+}
+
+TradeTapeWriter::TradeTapeWriter(const TradeTapeOptions &options,
+                                 const std::shared_ptr<IEngineEventObserver> &downstream_observer)
+    : options_(options), downstream_observer_(downstream_observer) {
+
+  if (options_.directory_.empty() || options_.rows_per_segment_ == 0 || options_.number_of_shards_ == 0) {
+    throw std::invalid_argument("trade tape requires a directory, rows per segment and shards");
+  }
+  if (!options_.clock_) options_.clock_ = &systemClockNanoseconds;
+
+  std::filesystem::create_directories(options_.directory_);
+
+  for (std::size_t shard_index = 0; shard_index < options_.number_of_shards_; shard_index++) {
+    auto shard = std::make_unique<Shard>();
+    shard->shard_index_ = static_cast<std::uint32_t>(shard_index);
+    shards_.emplace_back(std::move(shard));
+  }
+
+  // A tape written before is appended to, every shard resuming after its last sealed segment. Columns of a segment
+  // left unsealed have no index and are never read, so they are simply written over.
+  for (const auto &entry : std::filesystem::directory_iterator(options_.directory_)) {
+    unsigned shard_index{};
+    unsigned long long segment{};
+    char extension[8]{};
+    const auto file_name = entry.path().filename().string();
+    if (std::sscanf(file_name.c_str(), "tape_%u_%llu.%3s", &shard_index, &segment, extension) != 3
+        || std::strcmp(extension, "idx") != 0 || shard_index >= shards_.size()) {
+      continue;
+    }
+    auto &shard_segment = shards_[shard_index]->segment_;
+    shard_segment = std::max<std::uint64_t>(shard_segment, segment + 1);
+  }
+}
+
+TradeTapeWriter::~TradeTapeWriter() {
+  try {
+    close();
+  } catch (...) {
+    // nothing sensible to do on destruction
+  }
+}
+
+void TradeTapeWriter::doTradeEvent(
+    const ClientType &client1,
+    const OrderIDType &client1_order_id,
+    const ClientType &client2,
+    const OrderIDType &client2_order_id,
+    const InstrumentType &instrument,
+    const PriceType &trade_price,
+    const SizeType &size) {
+
+  const std::array<std::uint64_t, TRADE_TAPE_COLUMN_SIZE> row{
+      options_.clock_(),
+      instrument,
+      trade_price,
+      size,
+      client1,
+      client1_order_id,
+      client2,
+      client2_order_id
+  };
+
+  {
+    Shard &shard = *shards_[instrument % shards_.size()];
+    std::lock_guard<std::mutex> _{shard.mutex_};
+
+    if (!shard.columns_[0].isOpen()) openSegment(shard);
+
+    auto &index = shard.index_;
+    for (std::size_t column = 0; column < TRADE_TAPE_COLUMN_SIZE; column++) {
+      reinterpret_cast<std::uint64_t *>(shard.columns_[column].data())[index.row_count_] = row[column];
+      index.min_[column] = std::min(index.min_[column], row[column]);
+      index.max_[column] = std::max(index.max_[column], row[column]);
+    }
+
+    if (++index.row_count_ == options_.rows_per_segment_) sealSegment(shard);
+  }
+
+  if (downstream_observer_) {
+    downstream_observer_->doTradeEvent(client1,
+                                       client1_order_id,
+                                       client2,
+                                       client2_order_id,
+                                       instrument,
+                                       trade_price,
+                                       size);
+  }
+}
+
+void TradeTapeWriter::doOrderRequestResponse(
+    const ClientType &client,
+    const OrderIDType &client_order_id,
+    const InstrumentType &instrument,
+    const PriceType &order_price,
+    const SizeType &order_size,
+    const OrderRequestResult &order_request_result,
+    const ValidationResponse &validation_response) {
+
+  if (downstream_observer_) {
+    downstream_observer_->doOrderRequestResponse(client,
+                                                 client_order_id,
+                                                 instrument,
+                                                 order_price,
+                                                 order_size,
+                                                 order_request_result,
+                                                 validation_response);
+  }
+}
+
+void TradeTapeWriter::setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) {
+  if (downstream_observer_) downstream_observer_->setClientMap(clients);
+}
+
+void TradeTapeWriter::close() {
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> _{shard->mutex_};
+    if (shard->columns_[0].isOpen()) sealSegment(*shard);
+  }
+}
+
+void TradeTapeWriter::openSegment(Shard &shard) {
+  for (std::size_t column = 0; column < TRADE_TAPE_COLUMN_SIZE; column++) {
+    shard.columns_[column] = MappedFile(columnFilePath(options_.directory_, shard.shard_index_, shard.segment_, column),
+                                        MappedFile::Mode::READ_WRITE,
+                                        options_.rows_per_segment_ * sizeof(std::uint64_t));
+  }
+
+  shard.index_ = TradeTapeSegmentIndex{};
+  shard.index_.shard_ = shard.shard_index_;
+  shard.index_.segment_ = shard.segment_;
+  shard.index_.min_.fill(std::numeric_limits<std::uint64_t>::max());
+  shard.index_.max_.fill(std::numeric_limits<std::uint64_t>::min());
+}
+
+void TradeTapeWriter::sealSegment(Shard &shard) {
+  const auto row_count = shard.index_.row_count_;
+  for (auto &column : shard.columns_) {
+    column.close(row_count * sizeof(std::uint64_t));
+  }
+
+  // Index goes last, a segment without index is one that was never sealed
+  MappedFile index_file{indexFilePath(options_.directory_, shard.shard_index_, shard.segment_),
+                        MappedFile::Mode::READ_WRITE,
+                        sizeof(TradeTapeSegmentIndex)};
+  std::memcpy(index_file.data(), &shard.index_, sizeof(TradeTapeSegmentIndex));
+  index_file.close();
+
+  shard.segment_++;
+}
+
+TradeTapeReader::TradeTapeReader(const std::string &directory) : directory_(directory) {
+  for (const auto &entry : std::filesystem::directory_iterator(directory_)) {
+    if (entry.path().extension() != ".idx") continue;
+
+    MappedFile index_file{entry.path().string(), MappedFile::Mode::READ_ONLY};
+    if (index_file.size() != sizeof(TradeTapeSegmentIndex)) {
+      throw std::runtime_error("truncated trade tape index " + entry.path().string());
+    }
+
+    TradeTapeSegmentIndex index;
+    std::memcpy(&index, index_file.data(), sizeof(index));
+    if (index.magic_ != TRADE_TAPE_MAGIC || index.version_ != TRADE_TAPE_VERSION) {
+      throw std::runtime_error("unrecognised trade tape index " + entry.path().string());
+    }
+    segments_.push_back(index);
+  }
+
+  std::sort(segments_.begin(), segments_.end(), [](const auto &lhs, const auto &rhs) {
+    return std::tie(lhs.shard_, lhs.segment_) < std::tie(rhs.shard_, rhs.segment_);
+  });
+}
+
+TradeTapeColumnView TradeTapeReader::mapColumn(const TradeTapeSegmentIndex &segment,
+                                               const TradeTapeColumn &column) const {
+  MappedFile column_file{columnFilePath(directory_, segment.shard_, segment.segment_, static_cast<std::size_t>(column)),
+                         MappedFile::Mode::READ_ONLY};
+  if (column_file.size() < segment.row_count_ * sizeof(std::uint64_t)) {
+    throw std::runtime_error("truncated trade tape column " + column_file.path());
+  }
+  column_file.adviseSequential();
+  return {std::move(column_file), segment.row_count_};
+}
+
+} // end of namespace
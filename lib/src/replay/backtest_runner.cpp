@@ -0,0 +1,184 @@
+#include "replay/backtest_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include "matching/passive_order_book.hpp"
+#include "replay/order_flow_replay.hpp"
+
+namespace codetest::matching_engine_sim {
+
+BacktestResult &BacktestResult::operator+=(const BacktestResult &rhs) {
+  messages_ += rhs.messages_;
+  acks_ += rhs.acks_;
+  nacks_ += rhs.nacks_;
+  unsolicited_cancels_ += rhs.unsolicited_cancels_;
+  trades_ += rhs.trades_;
+  traded_size_ += rhs.traded_size_;
+  traded_notional_ += rhs.traded_notional_;
+  busy_time_ += rhs.busy_time_;
+  return *this;
+}
+
+void BacktestResultObserver::doTradeEvent(
+    const ClientType &client1,
+    const OrderIDType &client1_order_id,
+    const ClientType &client2,
+    const OrderIDType &client2_order_id,
+    const InstrumentType &instrument,
+    const PriceType &trade_price,
+    const SizeType &size) {
+
+  result_.trades_++;
+  result_.traded_size_ += size;
+  result_.traded_notional_ += trade_price * size;
+
+  if (downstream_observer_) {
+    downstream_observer_->doTradeEvent(client1,
+                                       client1_order_id,
+                                       client2,
+                                       client2_order_id,
+                                       instrument,
+                                       trade_price,
+                                       size);
+  }
+}
+
+void BacktestResultObserver::doOrderRequestResponse(
+    const ClientType &client,
+    const OrderIDType &client_order_id,
+    const InstrumentType &instrument,
+    const PriceType &order_price,
+    const SizeType &order_size,
+    const OrderRequestResult &order_request_result,
+    const ValidationResponse &validation_response) {
+
+  if (order_request_result == OrderRequestResult::ACK) {
+    result_.acks_++;
+  } else if (order_request_result == OrderRequestResult::CANCELLED) {
+    result_.unsolicited_cancels_++;
+  } else {
+    result_.nacks_++;
+  }
+
+  if (downstream_observer_) {
+    downstream_observer_->doOrderRequestResponse(client,
+                                                 client_order_id,
+                                                 instrument,
+                                                 order_price,
+                                                 order_size,
+                                                 order_request_result,
+                                                 validation_response);
+  }
+}
+
+void BacktestResultObserver::setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &clients) {
+  if (downstream_observer_) downstream_observer_->setClientMap(clients);
+}
+
+BacktestRunner::BacktestRunner(const OrderFlowFileReader &reader, const std::size_t &number_of_threads)
+    : reader_(reader),
+      number_of_threads_(number_of_threads > 0 ? number_of_threads
+                                               : std::max<std::size_t>(1, std::thread::hardware_concurrency())) {
+
+  std::unordered_map<InstrumentType, std::vector<std::size_t>> instrument_records;
+  for (std::size_t index = 0; index < reader_.size(); index++) {
+    instrument_records[reader_.data()[index].instrument_].push_back(index);
+  }
+
+  instrument_records_.assign(std::make_move_iterator(instrument_records.begin()),
+                             std::make_move_iterator(instrument_records.end()));
+
+  // Longest tasks go first so that the tail of a run is made of short tasks keeping every worker busy
+  std::sort(instrument_records_.begin(), instrument_records_.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.second.size() != rhs.second.size() ? lhs.second.size() > rhs.second.size() : lhs.first < rhs.first;
+  });
+}
+
+std::vector<BacktestScenarioResult> BacktestRunner::run(const std::vector<BacktestScenario> &scenarios) const {
+  for (const auto &scenario : scenarios) {
+    if (!scenario.matching_algo_factory_) {
+      throw std::invalid_argument("backtest scenario " + scenario.name_ + " has no matching algo factory");
+    }
+  }
+
+  // Instrument major, so all scenarios of the largest instrument are picked up first
+  const std::size_t number_of_tasks = instrument_records_.size() * scenarios.size();
+  std::vector<BacktestResult> task_results(number_of_tasks);
+  std::vector<std::exception_ptr> failures(number_of_tasks);
+  std::atomic<std::size_t> next_task{0};
+
+  auto worker = [&] {
+    for (std::size_t task = next_task.fetch_add(1, std::memory_order_relaxed);
+         task < number_of_tasks;
+         task = next_task.fetch_add(1, std::memory_order_relaxed)) {
+
+      const auto &[instrument, record_indices] = instrument_records_[task / scenarios.size()];
+      try {
+        task_results[task] = runTask(scenarios[task % scenarios.size()], instrument, record_indices);
+      } catch (...) {
+        failures[task] = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (std::size_t cnt = 0; cnt < std::min(number_of_threads_, number_of_tasks); cnt++) {
+    workers.emplace_back(worker);
+  }
+  for (auto &t : workers) {
+    t.join();
+  }
+
+  for (const auto &failure : failures) {
+    if (failure) std::rethrow_exception(failure);
+  }
+
+  std::vector<BacktestScenarioResult> scenario_results(scenarios.size());
+  for (std::size_t task = 0; task < number_of_tasks; task++) {
+    auto &scenario_result = scenario_results[task % scenarios.size()];
+    scenario_result.total_ += task_results[task];
+    scenario_result.instruments_[instrument_records_[task / scenarios.size()].first] = task_results[task];
+  }
+  for (std::size_t index = 0; index < scenarios.size(); index++) {
+    scenario_results[index].name_ = scenarios[index].name_;
+  }
+  return scenario_results;
+}
+
+BacktestResult BacktestRunner::runTask(const BacktestScenario &scenario,
+                                       const InstrumentType &instrument,
+                                       const std::vector<std::size_t> &record_indices) const {
+  const auto matching_algo = scenario.matching_algo_factory_();
+  BacktestResultObserver observer{scenario.observer_factory_ ? scenario.observer_factory_(instrument) : nullptr};
+  PassiveOrderBook<> passive_order_book{};
+
+  const auto start_time = std::chrono::steady_clock::now();
+
+  const OrderFlowRecord *const records = reader_.data();
+  const std::size_t record_count = record_indices.size();
+  for (std::size_t index = 0; index < record_count; index++) {
+    if (index + ORDER_FLOW_PREFETCH_DISTANCE < record_count) {
+      __builtin_prefetch(records + record_indices[index + ORDER_FLOW_PREFETCH_DISTANCE]);
+    }
+
+    const auto &record = records[record_indices[index]];
+    // Flow time stamps are the clock of good till time orders, as in replay
+    matching_algo->doExpireOrders(passive_order_book, instrument, record.timestamp_, observer);
+
+    auto order_request = toClientOrderRequest(record);
+    matching_algo->doProcessOrderRequest(order_request, passive_order_book, observer);
+  }
+
+  auto &result = observer.getResult();
+  result.messages_ = record_count;
+  result.busy_time_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start_time);
+  return result;
+}
+
+} // end of namespace
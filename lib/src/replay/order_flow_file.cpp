@@ -0,0 +1,165 @@
+#include "replay/order_flow_file.h"
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace codetest::matching_engine_sim {
+
+namespace {
+
+template<typename T>
+T parseCsvNumber(const std::string_view &field, const std::uint64_t &line_number) {
+  T value{};
+  const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  if (error != std::errc{} || end != field.data() + field.size()) {
+    throw std::invalid_argument("invalid number '" + std::string(field) + "' on line " + std::to_string(line_number));
+  }
+  return value;
+}
+
+template<typename Enum>
+std::uint8_t parseCsvEnum(const std::string_view &field,
+                          const std::initializer_list<std::pair<std::string_view, Enum>> &names,
+                          const std::uint64_t &line_number) {
+  for (const auto &[name, value] : names) {
+    if (field == name) return static_cast<std::uint8_t>(value);
+  }
+  throw std::invalid_argument("invalid value '" + std::string(field) + "' on line " + std::to_string(line_number));
+}
+
+// Enumerations of a record are cast as they are into a request, matching algo indexing its handlers by action
+[[nodiscard]] bool isValidOrderFlowRecord(const OrderFlowRecord &record) {
+  return record.side_ <= static_cast<std::uint8_t>(OrderSide::SELL)
+      && record.order_action_ < static_cast<std::uint8_t>(OrderAction::_ACTION_SIZE_)
+      && record.order_type_ <= static_cast<std::uint8_t>(OrderType::MID_PEG)
+      && record.time_in_force_ <= static_cast<std::uint8_t>(TimeInForce::GTT);
+}
+
+} // end of anonymous local namespace
+
+OrderFlowFileWriter::OrderFlowFileWriter(const std::string &path)
+    : path_(path), file_(path, std::ios::binary | std::ios::trunc) {
+  if (!file_) throw std::runtime_error("failed to create order flow file " + path_);
+  header_.record_size_ = sizeof(OrderFlowRecord);
+  file_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+}
+
+OrderFlowFileWriter::~OrderFlowFileWriter() {
+  try {
+    close();
+  } catch (...) {
+    // nothing sensible to do on destruction
+  }
+}
+
+void OrderFlowFileWriter::append(const OrderFlowRecord &record) {
+  if (header_.record_count_ > 0 && record.timestamp_ < header_.last_timestamp_) {
+    throw std::invalid_argument("order flow must be time ordered, " + path_);
+  }
+  if (header_.record_count_ == 0) header_.first_timestamp_ = record.timestamp_;
+  header_.last_timestamp_ = record.timestamp_;
+  header_.record_count_++;
+  file_.write(reinterpret_cast<const char *>(&record), sizeof(record));
+}
+
+void OrderFlowFileWriter::close() {
+  if (!file_.is_open()) return;
+  file_.seekp(0);
+  file_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+  file_.close();
+  if (file_.fail()) throw std::runtime_error("failed to write order flow file " + path_);
+}
+
+OrderFlowFileReader::OrderFlowFileReader(const std::string &path) : file_(path, MappedFile::Mode::READ_ONLY) {
+  if (file_.size() < sizeof(OrderFlowFileHeader)) throw std::runtime_error("truncated order flow file " + path);
+
+  std::memcpy(&header_, file_.data(), sizeof(header_));
+  if (header_.magic_ != ORDER_FLOW_MAGIC || header_.version_ != ORDER_FLOW_VERSION) {
+    throw std::runtime_error("unrecognised order flow file " + path);
+  }
+  if (header_.record_size_ != sizeof(OrderFlowRecord)) {
+    throw std::runtime_error("order flow record size mismatch in " + path);
+  }
+  if (file_.size() < sizeof(OrderFlowFileHeader) + header_.record_count_ * sizeof(OrderFlowRecord)) {
+    throw std::runtime_error("truncated order flow file " + path);
+  }
+
+  file_.adviseSequential();
+
+  // Checked once up front, so that replays take every record as it is
+  for (std::size_t index = 0; index < size(); index++) {
+    if (!isValidOrderFlowRecord(data()[index])) {
+      throw std::runtime_error("invalid order flow record " + std::to_string(index) + " in " + path);
+    }
+  }
+}
+
+std::uint64_t importOrderFlowCsv(const std::string &csv_path, const std::string &order_flow_path) {
+  constexpr std::size_t CSV_COLUMN_SIZE = 9;
+  // Optional trigger price and display size columns
+  constexpr std::size_t CSV_EXTENDED_COLUMN_SIZE = 11;
+
+  std::ifstream csv_file{csv_path};
+  if (!csv_file) throw std::runtime_error("failed to open " + csv_path);
+
+  OrderFlowFileWriter writer{order_flow_path};
+
+  std::string line;
+  std::uint64_t line_number{0};
+  while (std::getline(csv_file, line)) {
+    line_number++;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty()) continue;
+    if (line_number == 1 && (line.front() < '0' || line.front() > '9')) continue;
+
+    std::array<std::string_view, CSV_EXTENDED_COLUMN_SIZE> fields{};
+    std::size_t column_size{0};
+    for (std::string_view remaining{line};;) {
+      const auto separator = remaining.find(',');
+      if (column_size < fields.size()) fields[column_size] = remaining.substr(0, separator);
+      column_size++;
+      if (separator == std::string_view::npos) break;
+      remaining.remove_prefix(separator + 1);
+    }
+    if (column_size != CSV_COLUMN_SIZE && column_size != CSV_EXTENDED_COLUMN_SIZE) {
+      throw std::invalid_argument("expected " + std::to_string(CSV_COLUMN_SIZE) + " or "
+                                      + std::to_string(CSV_EXTENDED_COLUMN_SIZE) + " columns on line "
+                                      + std::to_string(line_number));
+    }
+
+    OrderFlowRecord record;
+    record.timestamp_ = parseCsvNumber<std::uint64_t>(fields[0], line_number);
+    record.instrument_ = parseCsvNumber<InstrumentType>(fields[1], line_number);
+    record.client_ = parseCsvNumber<ClientType>(fields[2], line_number);
+    record.cln_order_id_ = parseCsvNumber<OrderIDType>(fields[3], line_number);
+    record.side_ = parseCsvEnum<OrderSide>(
+        fields[4], {{"BUY", OrderSide::BUY}, {"SELL", OrderSide::SELL}}, line_number);
+    record.order_action_ = parseCsvEnum<OrderAction>(
+        fields[5],
+        {{"NEW", OrderAction::NEW}, {"CANCEL", OrderAction::CANCEL}, {"AMEND", OrderAction::AMEND},
+         {"MASS_CANCEL", OrderAction::MASS_CANCEL}, {"MASS_CANCEL_SIDE", OrderAction::MASS_CANCEL_SIDE}},
+        line_number);
+    record.order_type_ = parseCsvEnum<OrderType>(
+        fields[6],
+        {{"LIMIT", OrderType::LIMIT}, {"MARKET", OrderType::MARKET}, {"STOP", OrderType::STOP},
+         {"STOP_LIMIT", OrderType::STOP_LIMIT}, {"PRIMARY_PEG", OrderType::PRIMARY_PEG},
+         {"MID_PEG", OrderType::MID_PEG}},
+        line_number);
+    record.price_ = parseCsvNumber<PriceType>(fields[7], line_number);
+    record.size_ = parseCsvNumber<SizeType>(fields[8], line_number);
+    if (column_size == CSV_EXTENDED_COLUMN_SIZE) {
+      record.trigger_price_ = parseCsvNumber<PriceType>(fields[9], line_number);
+      record.display_size_ = parseCsvNumber<SizeType>(fields[10], line_number);
+    }
+    writer.append(record);
+  }
+
+  writer.close();
+  return writer.getRecordCount();
+}
+
+} // end of namespace
@@ -0,0 +1,32 @@
+#include "simulation/latency_model.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace codetest::matching_engine_sim {
+
+LatencyDistribution constantLatency(const std::uint64_t &latency) {
+  return [latency](std::mt19937_64 &) { return latency; };
+}
+
+LatencyDistribution uniformLatency(const std::uint64_t &min_latency, const std::uint64_t &max_latency) {
+  if (min_latency > max_latency) {
+    throw std::invalid_argument("minimum latency cannot exceed maximum latency");
+  }
+  return [distribution = std::uniform_int_distribution<std::uint64_t>{min_latency, max_latency}](
+      std::mt19937_64 &random_engine) mutable {
+    return distribution(random_engine);
+  };
+}
+
+LatencyDistribution logNormalLatency(const std::uint64_t &median_latency, const double &sigma) {
+  if (median_latency == 0 || sigma < 0) {
+    throw std::invalid_argument("log-normal latency requires a positive median and non-negative sigma");
+  }
+  return [distribution = std::lognormal_distribution<double>{std::log(static_cast<double>(median_latency)), sigma}](
+      std::mt19937_64 &random_engine) mutable {
+    return static_cast<std::uint64_t>(std::llround(distribution(random_engine)));
+  };
+}
+
+} // end of namespace
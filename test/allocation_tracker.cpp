@@ -0,0 +1,93 @@
+#include "allocation_tracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<bool> allocation_tracking{false};
+std::atomic<std::uint64_t> tracked_allocations{0};
+
+void *allocate(std::size_t size) {
+  if (allocation_tracking.load(std::memory_order_relaxed)) {
+    tracked_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (size == 0) size = 1;
+  return std::malloc(size);
+}
+
+void *allocate(std::size_t size, std::align_val_t alignment) {
+  if (allocation_tracking.load(std::memory_order_relaxed)) {
+    tracked_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  const auto align = std::max(static_cast<std::size_t>(alignment), sizeof(void *));
+  void *ptr = nullptr;
+  return posix_memalign(&ptr, align, size == 0 ? 1 : size) == 0 ? ptr : nullptr;
+}
+
+} // end of anonymous local namespace
+
+namespace codetest::matching_engine_sim_test_helper {
+
+AllocationTracker::AllocationTracker() {
+  tracked_allocations.store(0, std::memory_order_relaxed);
+  allocation_tracking.store(true, std::memory_order_seq_cst);
+}
+
+AllocationTracker::~AllocationTracker() {
+  allocation_tracking.store(false, std::memory_order_seq_cst);
+}
+
+std::uint64_t AllocationTracker::getAllocations() const {
+  return tracked_allocations.load(std::memory_order_seq_cst);
+}
+
+} // end of namespace
+
+// Global replacements of the allocation functions, for the whole test executable
+
+void *operator new(std::size_t size) {
+  if (void *ptr = allocate(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  if (void *ptr = allocate(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  if (void *ptr = allocate(size, alignment)) return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  if (void *ptr = allocate(size, alignment)) return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+  return allocate(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+  return allocate(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { std::free(ptr); }
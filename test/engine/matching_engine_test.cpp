@@ -4,6 +4,7 @@
 #include <vector>
 #include <unordered_map>
 #include <chrono>
+#include <thread>
 
 #include "test_helper.h"
 #include "engine/matching_engine.h"
@@ -411,6 +412,110 @@ BOOST_AUTO_TEST_CASE(MatchingEngineBasicTest) {
   matching_engine.terminate();
 }
 
+BOOST_AUTO_TEST_CASE(MatchingEngineGoodTillTimeExpiry) {
+
+  /**
+   * Test Scenario:
+   * A good till time order expiring shortly is sent to a running matching engine, along with a GTC order.
+   *
+   * Test Objectives:
+   * 1. Processor thread expires the order by the system clock, without any further request
+   * 2. ORDER_EXPIRED response arrives no earlier than the expire time, the GTC order does not expire
+   */
+
+  constexpr auto EXPIRY_DELAY = 50ms;
+  constexpr auto MAXIMUM_WAITING_TIME = 5s;
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  DefaultMatchingEngine<void> matching_engine{1, {DEFAULT_TEST_INSTRUMENT_1_ID}, observer};
+
+  const auto expire_time = std::chrono::system_clock::now() + EXPIRY_DELAY;
+  ClientOrderRequest<> gtt_order_request{OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(),
+                                         DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID,
+                                         DEFAULT_TEST_INSTRUMENT_1_ID};
+  gtt_order_request.time_in_force_ = TimeInForce::GTT;
+  gtt_order_request.expire_time_ = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(expire_time.time_since_epoch()).count());
+  ClientOrderRequest<> gtc_order_request{OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(),
+                                         DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID,
+                                         DEFAULT_TEST_INSTRUMENT_1_ID};
+  matching_engine.doOrderRequest(gtt_order_request);
+  matching_engine.doOrderRequest(gtc_order_request);
+
+  const auto start_time = std::chrono::system_clock::now();
+  bool expired{false};
+  while (!expired) {
+    {
+      std::lock_guard<std::mutex> _(observer->order_responses_mutex_);
+      expired = observer->client_order_responses_.size() == 3;
+    }
+    if (!expired && std::chrono::system_clock::now() - start_time > MAXIMUM_WAITING_TIME) {
+      BOOST_FAIL("Good till time order did not expire within reasonable time");
+    }
+  }
+  BOOST_CHECK(std::chrono::system_clock::now() >= expire_time);
+
+  // Long enough for the GTC order to have expired as well, were it to
+  std::this_thread::sleep_for(EXPIRY_DELAY);
+  matching_engine.terminate();
+
+  const auto &responses = observer->client_order_responses_;
+  BOOST_REQUIRE_EQUAL(responses.size(), 3);
+  BOOST_CHECK(responses[2] == EngineOrderResponseTestRecord(
+      DEFAULT_TEST_CLIENT_1_ID, gtt_order_request.cln_order_id_, DEFAULT_TEST_INSTRUMENT_1_ID,
+      DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE, OrderRequestResult::CANCELLED,
+      ValidationResponse::ORDER_EXPIRED));
+}
+
+BOOST_AUTO_TEST_CASE(MatchingEngineCustomOrderExtWithoutCodec) {
+
+  /**
+   * Test Scenario:
+   * A matching engine is run for a custom order extension without an OrderExtCodec specialisation.
+   *
+   * Test Objectives:
+   * 1. Engine compiles and matches orders carrying the custom fields, journaling and snapshots being off
+   * 2. Engine refuses journaling and snapshots, the custom fields having no codec to persist them
+   */
+
+  struct UncodedExtension {
+    int tag_{};
+  };
+
+  constexpr auto MAXIMUM_WAITING_TIME = 5s;
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  DefaultMatchingEngine<UncodedExtension> matching_engine{1, {DEFAULT_TEST_INSTRUMENT_1_ID}, observer};
+
+  const auto custom_fields = std::make_shared<UncodedExtension>();
+  for (const auto &[side, client] : {std::pair{OrderSide::SELL, DEFAULT_TEST_CLIENT_1_ID},
+                                     std::pair{OrderSide::BUY, DEFAULT_TEST_CLIENT_2_ID}}) {
+    matching_engine.doOrderRequest(ClientOrderRequest<UncodedExtension>{
+        side, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+        client, DEFAULT_TEST_INSTRUMENT_1_ID, custom_fields});
+  }
+
+  const auto start_time = std::chrono::system_clock::now();
+  bool traded{false};
+  while (!traded) {
+    {
+      std::lock_guard<std::mutex> _(observer->trade_event_mutex_);
+      traded = observer->client_trade_events_.size() == 1;
+    }
+    if (!traded && std::chrono::system_clock::now() - start_time > MAXIMUM_WAITING_TIME) {
+      BOOST_FAIL("Orders with custom fields did not trade within reasonable time");
+    }
+  }
+  BOOST_CHECK_THROW(matching_engine.takeSnapshot(TestTemporaryDirectory().path()), std::logic_error);
+  matching_engine.terminate();
+
+  TestTemporaryDirectory journal_directory;
+  MatchingEngineOptions options;
+  options.journal_.directory_ = journal_directory.path();
+  BOOST_CHECK_THROW((DefaultMatchingEngine<UncodedExtension>{1, {DEFAULT_TEST_INSTRUMENT_1_ID}, observer, options}),
+                    std::invalid_argument);
+}
+
 } // end of namespace
 
 BOOST_AUTO_TEST_SUITE_END()
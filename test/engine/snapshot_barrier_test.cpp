@@ -0,0 +1,190 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <tuple>
+
+#include "test_helper.h"
+#include "engine/matching_engine.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(SnapshotBarrierTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+using FlattenedOrder = std::tuple<OrderSide, PriceType, ClientType, OrderIDType, SizeType>;
+
+std::vector<FlattenedOrder> loadFlattenedBook(const std::string &directory, const InstrumentType &instrument) {
+  PassiveOrderBook<> passive_order_book{};
+  loadBookSnapshot((std::filesystem::path(directory) / bookSnapshotFileName(instrument)).string(), passive_order_book);
+
+  std::vector<FlattenedOrder> orders;
+  for (const auto &[price, order_queue] : passive_order_book.getBidOrderQueue()) {
+    for (const auto &order : order_queue) {
+      orders.emplace_back(OrderSide::BUY, price, order->client_, order->cln_order_id_, order->remaining_size_);
+    }
+  }
+  for (const auto &[price, order_queue] : passive_order_book.getAskOrderQueue()) {
+    for (const auto &order : order_queue) {
+      orders.emplace_back(OrderSide::SELL, price, order->client_, order->cln_order_id_, order->remaining_size_);
+    }
+  }
+  return orders;
+}
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(MatchingEngine_SnapshotBarrier_ConsistentPointInTime) {
+
+  /**
+   * Test Scenario:
+   * A snapshot is taken on a running engine between two phases of order flow, without terminating it.
+   *
+   * Test Objectives:
+   * 1. Every book snapshot holds exactly the orders of phase one, none of phase two
+   * 2. Engine keeps processing phase two after the barrier
+   * 3. Snapshot plus journal tail rebuilds the same books as the engine ends up with
+   */
+
+  using OrderExt = void;
+  constexpr std::uint8_t NUMBER_OF_THREADS = 3;
+  constexpr InstrumentType NUMBER_OF_INSTRUMENTS = 12;
+  constexpr OrderIDType ORDERS_PER_PHASE = 20;
+  constexpr unsigned MAXIMUM_WAITING_TIME_MILLISECOND = 2000;
+
+  TestTemporaryDirectory journal_directory;
+  TestTemporaryDirectory barrier_snapshot_directory;
+  TestTemporaryDirectory final_snapshot_directory;
+  TestTemporaryDirectory rebuilt_snapshot_directory;
+
+  std::set<InstrumentType> instruments;
+  for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+    instruments.insert(inst);
+  }
+
+  MatchingEngineOptions options;
+  options.journal_.directory_ = journal_directory.path();
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  DefaultMatchingEngine<OrderExt> matching_engine{NUMBER_OF_THREADS, instruments, observer, options};
+
+  // Phase one rests sell orders, phase two rests buy orders below them and cancels half of phase one
+  OrderIDType order_id{0};
+  for (OrderIDType cnt = 0; cnt < ORDERS_PER_PHASE; cnt++) {
+    for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+      matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, order_id++,
+                                      DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE + cnt % 3,
+                                      DEFAULT_TEST_CLIENT_1_ID, inst});
+    }
+  }
+
+  const auto barrier = matching_engine.takeSnapshot(barrier_snapshot_directory.path());
+
+  for (OrderIDType cnt = 0; cnt < ORDERS_PER_PHASE; cnt++) {
+    for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+      matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, order_id++,
+                                      DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE - 1 - cnt % 3,
+                                      DEFAULT_TEST_CLIENT_2_ID, inst});
+      if (cnt & 1) {
+        matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::CANCEL, OrderType::LIMIT,
+                                        cnt * NUMBER_OF_INSTRUMENTS + inst, DEFAULT_TEST_ORDER_SIZE,
+                                        DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, inst});
+      }
+    }
+  }
+
+  // Clients cannot inject control requests
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::SNAPSHOT_BARRIER, OrderType::LIMIT, order_id++,
+                                  DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID, 0});
+
+  barrier->wait();
+  BOOST_CHECK(barrier->isComplete());
+
+  const std::size_t expected_responses = NUMBER_OF_INSTRUMENTS * ORDERS_PER_PHASE * 5 / 2;
+  const auto start_time = std::chrono::steady_clock::now();
+  while (true) {
+    {
+      std::lock_guard<std::mutex> _{observer->order_responses_mutex_};
+      if (observer->client_order_responses_.size() == expected_responses) break;
+    }
+    if (std::chrono::steady_clock::now() - start_time > std::chrono::milliseconds(MAXIMUM_WAITING_TIME_MILLISECOND)) {
+      BOOST_FAIL("Not able to receive all expected client order responses within reasonable time");
+    }
+  }
+
+  matching_engine.terminate();
+  matching_engine.saveSnapshot(final_snapshot_directory.path());
+
+  for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+    const auto barrier_book = loadFlattenedBook(barrier_snapshot_directory.path(), inst);
+    BOOST_CHECK_EQUAL(barrier_book.size(), ORDERS_PER_PHASE);
+    for (const auto &order : barrier_book) {
+      BOOST_CHECK(std::get<OrderSide>(order) == OrderSide::SELL);
+    }
+  }
+
+  // Rebuild from the barrier snapshot plus journal tail, expect identical books to the ones engine ended up with
+  options.snapshot_directory_ = barrier_snapshot_directory.path();
+  options.journal_.replay_on_start_ = true;
+  DefaultMatchingEngine<OrderExt> rebuilt_engine{NUMBER_OF_THREADS, instruments, observer, options};
+  rebuilt_engine.terminate();
+  rebuilt_engine.saveSnapshot(rebuilt_snapshot_directory.path());
+
+  for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+    const auto final_book = loadFlattenedBook(final_snapshot_directory.path(), inst);
+    const auto rebuilt_book = loadFlattenedBook(rebuilt_snapshot_directory.path(), inst);
+    BOOST_CHECK_EQUAL(final_book.size(), ORDERS_PER_PHASE * 3 / 2);
+    BOOST_CHECK(final_book == rebuilt_book);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MatchingEngine_SnapshotBarrier_Terminated) {
+
+  /**
+   * Test Scenario:
+   * A snapshot is taken on a busy engine which is terminated right away, then another once it is terminated.
+   *
+   * Test Objectives:
+   * 1. Barrier is done by the time terminate returns, written in full or failed, never left waiting
+   * 2. Snapshot barrier cannot be taken on a terminated engine
+   */
+
+  constexpr std::uint8_t NUMBER_OF_THREADS = 2;
+  constexpr InstrumentType NUMBER_OF_INSTRUMENTS = 4;
+  constexpr OrderIDType NUMBER_OF_ORDERS = 10000;
+
+  TestTemporaryDirectory snapshot_directory;
+  std::set<InstrumentType> instruments;
+  for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+    instruments.insert(inst);
+  }
+
+  auto observer = std::make_shared<NullEngineEventObserver>();
+  DefaultMatchingEngine<> matching_engine{NUMBER_OF_THREADS, instruments, observer};
+  for (OrderIDType order_id = 0; order_id < NUMBER_OF_ORDERS; order_id++) {
+    matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, order_id,
+                                    DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID,
+                                    order_id % NUMBER_OF_INSTRUMENTS});
+  }
+
+  const auto barrier = matching_engine.takeSnapshot(snapshot_directory.path());
+  matching_engine.terminate();
+
+  BOOST_CHECK(barrier->isComplete());
+  try {
+    barrier->wait();
+  } catch (const std::runtime_error &) {
+    // Terminated before every processor reached the barrier
+  }
+
+  BOOST_CHECK_THROW(matching_engine.takeSnapshot(snapshot_directory.path()), std::logic_error);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,208 @@
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+
+#include "test_helper.h"
+#include "engine/synchronous_matching_engine.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(SynchronousMatchingEngineTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(SynchronousMatchingEngine_ProcessesInline) {
+
+  /**
+   * Test Scenario:
+   * Orders are sent to a synchronous engine one at a time, observing the events after every call.
+   *
+   * Test Objectives:
+   * 1. Responses and trades are delivered before doOrderRequest returns, without waiting
+   * 2. Default validators apply, e.g. no self match
+   * 3. Requests of unknown instrument, control requests and requests after terminate are dropped
+   */
+
+  using OrderExt = void;
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  SynchronousMatchingEngine<OrderExt> matching_engine{{DEFAULT_TEST_INSTRUMENT_1_ID}, observer};
+
+  const auto sell_order_id = GenTestOrderID();
+  matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, sell_order_id,
+                                  DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+  BOOST_CHECK_EQUAL(observer->client_order_responses_.size(), 1);
+  BOOST_CHECK_EQUAL(observer->client_trade_events_.size(), 0);
+
+  const auto *passive_order_book = matching_engine.getPassiveOrderBook(DEFAULT_TEST_INSTRUMENT_1_ID);
+  BOOST_REQUIRE(passive_order_book != nullptr);
+  BOOST_CHECK_EQUAL(passive_order_book->getAskOrderQueue().size(), 1);
+  BOOST_CHECK(matching_engine.getPassiveOrderBook(DEFAULT_TEST_INSTRUMENT_1_ID + 1) == nullptr);
+
+  // Self match acknowledged then rejected on matching
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(),
+                                  DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+  BOOST_REQUIRE_EQUAL(observer->client_order_responses_.size(), 3);
+  BOOST_CHECK(observer->client_order_responses_.back().request_result_ == OrderRequestResult::NACK);
+  BOOST_CHECK(observer->client_order_responses_.back().validation_response_ == ValidationResponse::SELF_MATCH);
+  BOOST_CHECK_EQUAL(observer->client_trade_events_.size(), 0);
+
+  const auto buy_order_id = GenTestOrderID();
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::MARKET, buy_order_id,
+                                  DEFAULT_TEST_ORDER_SIZE / 2, 0,
+                                  DEFAULT_TEST_CLIENT_2_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+  BOOST_REQUIRE_EQUAL(observer->client_trade_events_.size(), 1);
+  BOOST_CHECK_EQUAL(observer->client_trade_events_.front().client1_order_id_, buy_order_id);
+  BOOST_CHECK_EQUAL(observer->client_trade_events_.front().client2_order_id_, sell_order_id);
+  BOOST_CHECK_EQUAL(observer->client_trade_events_.front().trade_price_, DEFAULT_TEST_ORDER_PRICE);
+  BOOST_CHECK_EQUAL(passive_order_book->getAskOrderQueue().begin()->second.front()->remaining_size_,
+                    DEFAULT_TEST_ORDER_SIZE / 2);
+
+  const auto responses_so_far = observer->client_order_responses_.size();
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(),
+                                  DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_2_ID, DEFAULT_TEST_INSTRUMENT_1_ID + 1});
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::SNAPSHOT_BARRIER, OrderType::LIMIT, GenTestOrderID(),
+                                  DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_2_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+  BOOST_CHECK_EQUAL(observer->client_order_responses_.size(), responses_so_far);
+
+  matching_engine.terminate();
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(),
+                                  DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_2_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+  BOOST_CHECK_EQUAL(observer->client_order_responses_.size(), responses_so_far);
+  BOOST_CHECK_EQUAL(observer->client_trade_events_.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SynchronousMatchingEngine_Snapshot) {
+  TestTemporaryDirectory snapshot_directory;
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  SynchronousMatchingEngine<> matching_engine{{DEFAULT_TEST_INSTRUMENT_1_ID}, observer};
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(),
+                                  DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+  matching_engine.saveSnapshot(snapshot_directory.path());
+
+  PassiveOrderBook<> restored_order_book{};
+  const auto header = loadBookSnapshot(
+      (std::filesystem::path(snapshot_directory.path()) / bookSnapshotFileName(DEFAULT_TEST_INSTRUMENT_1_ID)).string(),
+      restored_order_book);
+  BOOST_CHECK_EQUAL(header.order_count_, 1);
+  BOOST_CHECK_EQUAL(restored_order_book.getBidOrderQueue().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SynchronousMatchingEngine_CallAuction) {
+
+  /**
+   * Test Scenario:
+   * A sell rests in continuous trading, then the instrument is put into an auction where a crossing buy and a market
+   * order are entered, then the auction is uncrossed and a crossing buy is entered in continuous trading again.
+   *
+   * Test Objectives:
+   * 1. Orders entered in the auction rest without matching, alongside orders already in the book
+   * 2. Orders the auction does not accept are NACKed
+   * 3. Uncross trades at the equilibrium price and resumes continuous trading
+   * 4. Uncross of an instrument not in an auction does nothing
+   */
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  SynchronousMatchingEngine<> matching_engine{{DEFAULT_TEST_INSTRUMENT_1_ID}, observer};
+
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 200,
+                                                      DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID));
+  matching_engine.startAuction(DEFAULT_TEST_INSTRUMENT_1_ID);
+  matching_engine.startAuction(DEFAULT_TEST_INSTRUMENT_1_ID + 1);
+  BOOST_CHECK(matching_engine.isInAuction(DEFAULT_TEST_INSTRUMENT_1_ID));
+  BOOST_CHECK(!matching_engine.isInAuction(DEFAULT_TEST_INSTRUMENT_1_ID + 1));
+
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100,
+                                                      DEFAULT_TEST_ORDER_PRICE + 1, DEFAULT_TEST_CLIENT_2_ID));
+  BOOST_CHECK(observer->client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_CHECK(observer->client_trade_events_.empty());
+
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100, 0,
+                                                      DEFAULT_TEST_CLIENT_2_ID,
+                                                      TestOrderRequestFields().orderType(OrderType::MARKET)));
+  BOOST_CHECK(observer->client_order_responses_.back().request_result_ == OrderRequestResult::NACK);
+  BOOST_CHECK(observer->client_order_responses_.back().validation_response_
+                  == ValidationResponse::INVALID_ORDER_REQUEST);
+
+  const auto equilibrium = matching_engine.uncross(DEFAULT_TEST_INSTRUMENT_1_ID);
+  BOOST_REQUIRE(equilibrium);
+  BOOST_CHECK_EQUAL(equilibrium->volume_, 100);
+  BOOST_REQUIRE_EQUAL(observer->client_trade_events_.size(), 1);
+  checkTradeEvent(observer->client_trade_events_[0], DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  equilibrium->price_, 100);
+  BOOST_CHECK(!matching_engine.isInAuction(DEFAULT_TEST_INSTRUMENT_1_ID));
+  BOOST_CHECK(!matching_engine.uncross(DEFAULT_TEST_INSTRUMENT_1_ID));
+
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100,
+                                                      DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_3_ID));
+  BOOST_REQUIRE_EQUAL(observer->client_trade_events_.size(), 2);
+  checkTradeEvent(observer->client_trade_events_[1], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 100);
+  BOOST_CHECK(matching_engine.getPassiveOrderBook(DEFAULT_TEST_INSTRUMENT_1_ID)->getAskOrderQueue().empty());
+}
+
+BOOST_AUTO_TEST_CASE(SynchronousMatchingEngine_CallAuction_PegsSitOut) {
+
+  /**
+   * Test Scenario:
+   * A primary peg buy rests pegged to the best bid in continuous trading, then the instrument is put into an auction
+   * where a buy above the peg's reference price and a peg are entered, then the auction is uncrossed.
+   *
+   * Test Objectives:
+   * 1. Pegged order entered in the auction is NACKed
+   * 2. Pegged order resting before the auction takes no part in the equilibrium or the uncross
+   * 3. Pegged order is left in its peg queue as it was, trading again once continuous trading resumes
+   */
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  SynchronousMatchingEngine<> matching_engine{{DEFAULT_TEST_INSTRUMENT_1_ID}, observer};
+
+  const auto test_order_id_peg = GenTestOrderID();
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 200,
+                                                      DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID));
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100,
+                                                      DEFAULT_TEST_ORDER_PRICE - 1, DEFAULT_TEST_CLIENT_3_ID));
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::BUY, test_order_id_peg, 50, 0,
+                                                      DEFAULT_TEST_CLIENT_4_ID,
+                                                      TestOrderRequestFields().orderType(OrderType::PRIMARY_PEG)));
+  BOOST_REQUIRE(observer->client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  matching_engine.startAuction(DEFAULT_TEST_INSTRUMENT_1_ID);
+
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 50, 0,
+                                                      DEFAULT_TEST_CLIENT_4_ID,
+                                                      TestOrderRequestFields().orderType(OrderType::MID_PEG)));
+  BOOST_CHECK(observer->client_order_responses_.back().request_result_ == OrderRequestResult::NACK);
+  BOOST_CHECK(observer->client_order_responses_.back().validation_response_
+                  == ValidationResponse::INVALID_ORDER_REQUEST);
+
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100,
+                                                      DEFAULT_TEST_ORDER_PRICE + 1, DEFAULT_TEST_CLIENT_2_ID));
+  const auto equilibrium = matching_engine.uncross(DEFAULT_TEST_INSTRUMENT_1_ID);
+  BOOST_REQUIRE(equilibrium);
+  BOOST_CHECK_EQUAL(equilibrium->volume_, 100);
+  BOOST_REQUIRE_EQUAL(observer->client_trade_events_.size(), 1);
+  checkTradeEvent(observer->client_trade_events_[0], DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  equilibrium->price_, 100);
+
+  const auto *passive_order_book = matching_engine.getPassiveOrderBook(DEFAULT_TEST_INSTRUMENT_1_ID);
+  BOOST_REQUIRE(passive_order_book);
+  BOOST_CHECK_EQUAL(passive_order_book->getPegQueue(OrderSide::BUY, OrderType::PRIMARY_PEG).total_size_, 50);
+  BOOST_CHECK(passive_order_book->isOrderExist(DEFAULT_TEST_CLIENT_4_ID, test_order_id_peg));
+
+  // Continuous trading again, a sell through the best bid takes the peg along with the limit order there
+  matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 250,
+                                                      DEFAULT_TEST_ORDER_PRICE - 1, DEFAULT_TEST_CLIENT_5_ID));
+  BOOST_CHECK_EQUAL(passive_order_book->getPegQueue(OrderSide::BUY, OrderType::PRIMARY_PEG).total_size_, 0);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
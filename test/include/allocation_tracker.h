@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace codetest::matching_engine_sim_test_helper {
+
+/*
+ * Counts heap allocations made by any thread while in scope. The test executable interposes the global operator new,
+ * which only pays for a relaxed atomic load while no tracker is active. Trackers are not meant to be nested.
+ */
+class AllocationTracker final {
+ public:
+  AllocationTracker();
+  AllocationTracker(const AllocationTracker &) = delete;
+  AllocationTracker &operator=(const AllocationTracker &) = delete;
+  ~AllocationTracker();
+
+  // Allocations since construction
+  [[nodiscard]] std::uint64_t getAllocations() const;
+};
+
+} // end of namespace
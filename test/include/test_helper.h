@@ -2,9 +2,11 @@
 
 #include <mutex>
 #include <vector>
+#include <string>
 
 #include "types.h"
 #include "events/client_events.h"
+#include "events/client_order_request.h"
 #include "interface/i_engine_event_observer.h"
 #include "external/i_client.h"
 
@@ -137,6 +139,57 @@ struct EngineEventTestObserver : IEngineEventObserver {
 
 OrderIDType GenTestOrderID();
 
+// Fields of a test order request beyond side, order id, size, price and client, set in a chain as in
+// TestOrderRequestFields().orderType(OrderType::STOP).triggerPrice(price). Defaults to a new GTC limit order
+struct TestOrderRequestFields {
+  TestOrderRequestFields &action(const OrderAction &action) { action_ = action; return *this; }
+  TestOrderRequestFields &orderType(const OrderType &order_type) { order_type_ = order_type; return *this; }
+  TestOrderRequestFields &timeInForce(const TimeInForce &tif) { time_in_force_ = tif; return *this; }
+  // Good till time until expire time
+  TestOrderRequestFields &expireTime(const std::uint64_t &expire_time) {
+    time_in_force_ = TimeInForce::GTT;
+    expire_time_ = expire_time;
+    return *this;
+  }
+  TestOrderRequestFields &triggerPrice(const PriceType &price) { trigger_price_ = price; return *this; }
+  TestOrderRequestFields &displaySize(const SizeType &size) { display_size_ = size; return *this; }
+
+  OrderAction action_{OrderAction::NEW};
+  OrderType order_type_{OrderType::LIMIT};
+  TimeInForce time_in_force_{TimeInForce::GTC};
+  std::uint64_t expire_time_{};
+  PriceType trigger_price_{};
+  SizeType display_size_{};
+};
+
+// Order request of client for the default test instrument
+ClientOrderRequest<> makeTestOrderRequest(const OrderSide &side,
+                                          const OrderIDType &order_id,
+                                          const SizeType &size,
+                                          const PriceType &price,
+                                          const ClientType &client,
+                                          const TestOrderRequestFields &fields = {});
+
+// Checks a trade between the order of client1, aggressive, and the passive order of client2
+void checkTradeEvent(const EngineTradeEventTestRecord &trade_event,
+                     const ClientType &client1,
+                     const ClientType &client2,
+                     const PriceType &trade_price,
+                     const SizeType &size);
+
+// Unique scratch directory removed together with its content on destruction
+struct TestTemporaryDirectory {
+  TestTemporaryDirectory();
+  TestTemporaryDirectory(const TestTemporaryDirectory &) = delete;
+  TestTemporaryDirectory &operator=(const TestTemporaryDirectory &) = delete;
+  ~TestTemporaryDirectory();
+
+  [[nodiscard]] const std::string &path() const { return path_; }
+
+ private:
+  std::string path_{};
+};
+
 // Deliberately using different ranges of ID to help ensure no test coding errors in verifying values between
 // ClientID, OrderID, InstrumentID etc
 // (if they have same/similar range may unexpectedly match when we do comparison check)
@@ -0,0 +1,160 @@
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "test_helper.h"
+#include "engine/matching_engine.h"
+#include "loadgen/load_generator.h"
+#include "loadgen/order_flow_generator.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(LoadGeneratorTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+// Variance over mean of arrivals per window, about 1 for Poisson arrivals and well above for bursty ones
+double indexOfDispersion(const OrderFlowGeneratorConfig &config, const std::size_t &arrivals,
+                         const std::uint64_t &window) {
+  OrderFlowGenerator generator{config};
+  std::vector<double> window_counts;
+  for (std::size_t cnt = 0; cnt < arrivals; cnt++) {
+    const auto index = generator.next().timestamp_ / window;
+    if (index >= window_counts.size()) window_counts.resize(index + 1);
+    window_counts[index]++;
+  }
+  window_counts.pop_back();
+
+  double mean{0};
+  for (const auto &count : window_counts) mean += count;
+  mean /= static_cast<double>(window_counts.size());
+  double variance{0};
+  for (const auto &count : window_counts) variance += (count - mean) * (count - mean);
+  variance /= static_cast<double>(window_counts.size());
+  return variance / mean;
+}
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(OrderFlowGenerator_ShapedAndReproducible) {
+
+  /**
+   * Test Scenario:
+   * Flows generated over Zipf popular instruments, with Poisson and with Hawkes arrivals.
+   *
+   * Test Objectives:
+   * 1. Same config gives the same flow, arrivals in time order at the configured mean rate
+   * 2. Instrument popularity follows rank, cancels only target orders generated earlier by the same client
+   * 3. Hawkes arrivals are far burstier than Poisson arrivals at the same mean rate
+   */
+
+  constexpr std::size_t NUMBER_OF_REQUESTS = 200000;
+
+  OrderFlowGeneratorConfig config;
+  config.rate_ = 100000;
+  config.instruments_ = 10;
+  config.zipf_exponent_ = 1.0;
+  config.cancel_ratio_ = 0.3;
+
+  OrderFlowGenerator generator{config};
+  OrderFlowGenerator repeated_generator{config};
+
+  std::vector<std::size_t> instrument_counts(config.instruments_);
+  std::unordered_map<OrderIDType, ClientType> new_orders;
+  std::size_t cancels{0};
+  std::uint64_t last_timestamp{0};
+
+  for (std::size_t cnt = 0; cnt < NUMBER_OF_REQUESTS; cnt++) {
+    const auto generated = generator.next();
+    const auto repeated = repeated_generator.next();
+    const auto &order_request = generated.order_request_;
+
+    BOOST_REQUIRE_EQUAL(generated.timestamp_, repeated.timestamp_);
+    BOOST_REQUIRE_EQUAL(order_request.cln_order_id_, repeated.order_request_.cln_order_id_);
+    BOOST_REQUIRE(generated.timestamp_ >= last_timestamp);
+    last_timestamp = generated.timestamp_;
+
+    BOOST_REQUIRE(order_request.instrument_ < config.instruments_);
+    instrument_counts[order_request.instrument_]++;
+
+    if (order_request.order_action_ == OrderAction::CANCEL) {
+      cancels++;
+      const auto itr = new_orders.find(order_request.cln_order_id_);
+      BOOST_REQUIRE(itr != new_orders.end());
+      BOOST_REQUIRE_EQUAL(itr->second, order_request.client_);
+    } else {
+      BOOST_REQUIRE(new_orders.emplace(order_request.cln_order_id_, order_request.client_).second);
+      BOOST_REQUIRE(order_request.order_type_ == OrderType::MARKET || order_request.price_ > 0);
+    }
+  }
+
+  // 2 seconds of flow at 100k per second
+  BOOST_CHECK_CLOSE(static_cast<double>(last_timestamp), 2e9, 2);
+  BOOST_CHECK_CLOSE(static_cast<double>(cancels) / NUMBER_OF_REQUESTS, 0.3, 5);
+  // Harmonic number of 10 is about 2.929
+  BOOST_CHECK_CLOSE(static_cast<double>(instrument_counts[0]) / NUMBER_OF_REQUESTS, 1 / 2.929, 3);
+  BOOST_CHECK(instrument_counts[0] > instrument_counts[1] && instrument_counts[1] > instrument_counts[9]);
+
+  config.instruments_ = 1;
+  const auto poisson_dispersion = indexOfDispersion(config, NUMBER_OF_REQUESTS, 10000000);
+  config.arrival_process_ = ArrivalProcess::HAWKES;
+  config.hawkes_alpha_ = 800;
+  config.hawkes_beta_ = 1000;
+  const auto hawkes_dispersion = indexOfDispersion(config, NUMBER_OF_REQUESTS, 10000000);
+  BOOST_CHECK(poisson_dispersion < 1.5);
+  BOOST_CHECK(hawkes_dispersion > 3 * poisson_dispersion);
+
+  config.hawkes_alpha_ = config.hawkes_beta_;
+  BOOST_CHECK_THROW(OrderFlowGenerator{config}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(LoadGenerator_DrivesMatchingEngine) {
+
+  /**
+   * Test Scenario:
+   * Two unpaced producers drive a two thread engine over a few instruments.
+   *
+   * Test Objectives:
+   * 1. Every request is sent and every new order responded to, order ids never collide across producers
+   * 2. Throughput and latency percentiles are reported
+   */
+
+  OrderFlowGeneratorConfig flow_config;
+  flow_config.instruments_ = 4;
+  flow_config.zipf_exponent_ = 0.8;
+
+  LoadRunOptions run_options;
+  run_options.producers_ = 2;
+  run_options.target_rate_ = 0;
+  run_options.requests_per_producer_ = 5000;
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  LoadGenerator load_generator{flow_config, run_options, observer};
+  DefaultMatchingEngine<> matching_engine{2, {0, 1, 2, 3}, load_generator.getObserver()};
+
+  const auto report = load_generator.run(matching_engine);
+  matching_engine.terminate();
+
+  BOOST_CHECK_EQUAL(report.requests_, 10000);
+  BOOST_CHECK(report.new_orders_ > 0);
+  BOOST_CHECK_EQUAL(report.responded_new_orders_, report.new_orders_);
+  BOOST_CHECK(report.throughput() > 0);
+  BOOST_CHECK(report.latency_p50_ <= report.latency_p99_);
+  BOOST_CHECK(report.latency_p99_ <= report.latency_max_);
+
+  for (const auto &response : observer->client_order_responses_) {
+    BOOST_REQUIRE(response.validation_response_ != ValidationResponse::ORDER_ID_PREEXIST);
+  }
+
+  BOOST_CHECK_THROW(load_generator.run(matching_engine), std::runtime_error);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
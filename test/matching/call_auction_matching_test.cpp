@@ -0,0 +1,146 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "matching/call_auction_matching.hpp"
+#include "events/client_order_request.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(CallAuctionMatching_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(CallAuction_EquilibriumAndUncross)
+{
+  /**
+   * Test Scenario:
+   * Bids at 105, 103 and 101 and asks at 100, 102 and 104 accumulate in the auction, then the book is uncrossed.
+   *
+   * Test Objectives:
+   * 1. Crossing orders are ACKed and rest without trading
+   * 2. Equilibrium maximises volume then minimises imbalance, the lower price winning a tie without a last trade
+   * 3. Last trade price breaks the tie instead when there is one
+   * 4. Uncross trades every crossing order at the equilibrium price in priority order, leaving the book uncrossed
+   */
+
+  CallAuctionMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  auto bid_105 = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100, 105, DEFAULT_TEST_CLIENT_1_ID);
+  auto bid_103 = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100, 103, DEFAULT_TEST_CLIENT_2_ID);
+  auto bid_101 = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100, 101, DEFAULT_TEST_CLIENT_3_ID);
+  auto ask_100 = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 100, 100, DEFAULT_TEST_CLIENT_4_ID);
+  auto ask_102 = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 150, 102, DEFAULT_TEST_CLIENT_5_ID);
+  auto ask_104 = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 100, 104, DEFAULT_TEST_CLIENT_6_ID);
+  for (auto *order_request : {&bid_105, &bid_103, &bid_101, &ask_100, &ask_102, &ask_104}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 6);
+  for (const auto &order_response : test_observer.client_order_responses_) {
+    BOOST_CHECK(order_response.request_result_ == OrderRequestResult::ACK);
+  }
+  BOOST_CHECK(test_observer.client_trade_events_.empty());
+
+  // Volume of 200 at both 102 and 103, with an imbalance of 50 at either
+  auto equilibrium = matching_algo.findEquilibrium(test_passive_order_book);
+  BOOST_REQUIRE(equilibrium);
+  BOOST_CHECK_EQUAL(equilibrium->price_, 102);
+  BOOST_CHECK_EQUAL(equilibrium->volume_, 200);
+  BOOST_CHECK_EQUAL(equilibrium->imbalance_, 50);
+
+  PassiveOrderBook<> referenced_order_book{test_passive_order_book};
+  referenced_order_book.recordTrade(104);
+  equilibrium = matching_algo.findEquilibrium(referenced_order_book);
+  BOOST_REQUIRE(equilibrium);
+  BOOST_CHECK_EQUAL(equilibrium->price_, 103);
+
+  equilibrium = matching_algo.uncross(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, test_observer);
+  BOOST_REQUIRE(equilibrium);
+  BOOST_CHECK_EQUAL(equilibrium->price_, 102);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 2);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_1_ID, 102, 100);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_2_ID, 102, 100);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getLastTradePrice(), 102);
+
+  BOOST_CHECK_EQUAL(test_passive_order_book.getBestPrice(OrderSide::BUY).value_or(0), 101);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getBestPrice(OrderSide::SELL).value_or(0), 102);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_, 50);
+  BOOST_CHECK(test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_5_ID, ask_102.cln_order_id_));
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_4_ID, ask_100.cln_order_id_));
+
+  BOOST_CHECK(!matching_algo.findEquilibrium(test_passive_order_book));
+  BOOST_CHECK(!matching_algo.uncross(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, test_observer));
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(CallAuction_OrderTypesAndIcebergUncross)
+{
+  /**
+   * Test Scenario:
+   * Market and immediate or cancel orders are entered into the auction, then an iceberg sell uncrosses against a
+   * buy larger than its display size.
+   *
+   * Test Objectives:
+   * 1. Only limit orders resting in the book are accepted
+   * 2. Equilibrium volume counts the reserve of icebergs
+   * 3. Iceberg trades slice after slice at the equilibrium price, keeping what is left of it
+   */
+
+  CallAuctionMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  auto market = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                     DEFAULT_TEST_CLIENT_1_ID);
+  market.order_type_ = OrderType::MARKET;
+  auto ioc = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID);
+  ioc.time_in_force_ = TimeInForce::IOC;
+  for (auto *order_request : {&market, &ioc}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+    BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::NACK);
+    BOOST_CHECK(test_observer.client_order_responses_.back().validation_response_
+                    == ValidationResponse::INVALID_ORDER_REQUEST);
+  }
+
+  const auto test_order_id_iceberg = GenTestOrderID();
+  auto iceberg = makeTestOrderRequest(OrderSide::SELL, test_order_id_iceberg, 300, DEFAULT_TEST_ORDER_PRICE,
+                                      DEFAULT_TEST_CLIENT_1_ID,
+                                      TestOrderRequestFields().displaySize(DEFAULT_TEST_ORDER_SIZE));
+  auto buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 250, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_2_ID);
+  matching_algo.doProcessOrderRequest(iceberg, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(buy, test_passive_order_book, test_observer);
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().begin()->second.size() == 1);
+
+  const auto equilibrium = matching_algo.uncross(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID,
+                                                 test_observer);
+  BOOST_REQUIRE(equilibrium);
+  BOOST_CHECK_EQUAL(equilibrium->price_, DEFAULT_TEST_ORDER_PRICE);
+  BOOST_CHECK_EQUAL(equilibrium->volume_, 250);
+  BOOST_CHECK_EQUAL(equilibrium->imbalance_, 50);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 3);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+  checkTradeEvent(test_observer.client_trade_events_[2], DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+
+  const auto iceberg_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID,
+                                                                             test_order_id_iceberg);
+  BOOST_REQUIRE(iceberg_order);
+  BOOST_CHECK_EQUAL(iceberg_order->getOpenSize(), 50);
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_, 50);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
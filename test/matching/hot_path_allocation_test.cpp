@@ -0,0 +1,215 @@
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "test_helper.h"
+#include "allocation_tracker.h"
+#include "engine/matching_engine.h"
+#include "engine/synchronous_matching_engine.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(HotPathAllocationTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+constexpr PriceType MID_PRICE = 100;
+constexpr PriceType LEVELS_PER_SIDE = 5;
+constexpr std::size_t ORDERS_PER_LEVEL = 8;
+constexpr ClientType AGGRESSOR_CLIENT_ID = DEFAULT_TEST_CLIENT_6_ID;
+
+// Counts events without keeping them, so that observing does not allocate
+struct CountingTestObserver final : public IEngineEventObserver {
+  void doTradeEvent(const ClientType &, const OrderIDType &, const ClientType &, const OrderIDType &,
+                    const InstrumentType &, const PriceType &, const SizeType &) override {
+    trades_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void doOrderRequestResponse(const ClientType &, const OrderIDType &, const InstrumentType &, const PriceType &,
+                              const SizeType &, const OrderRequestResult &, const ValidationResponse &) override {
+    responses_.fetch_add(1, std::memory_order_release);
+  }
+
+  void setClientMap(const std::unordered_map<ClientType, std::shared_ptr<IClient>> &) override {}
+
+  std::atomic<std::uint64_t> trades_{};
+  std::atomic<std::uint64_t> responses_{};
+};
+
+/*
+ * One cycle of steady state flow on instrument: levels of passive orders on both sides from a few clients, a quarter
+ * of them cancelled, a partial fill, then market orders sweeping both sides, leaving the book empty again.
+ * Order ids repeat from cycle to cycle, each cycle takes the book through the same shape.
+ */
+std::vector<ClientOrderRequest<>> steadyStateCycle(const InstrumentType &instrument) {
+  const ClientType clients[] = {DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_CLIENT_2_ID, DEFAULT_TEST_CLIENT_3_ID};
+  std::vector<ClientOrderRequest<>> requests;
+  OrderIDType order_id{1};
+
+  for (PriceType level = 1; level <= LEVELS_PER_SIDE; level++) {
+    for (std::size_t cnt = 0; cnt < ORDERS_PER_LEVEL; cnt++) {
+      const auto client = clients[order_id % 3];
+      requests.emplace_back(OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, order_id++, DEFAULT_TEST_ORDER_SIZE,
+                            MID_PRICE - level, client, instrument, nullptr);
+      requests.emplace_back(OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, order_id++, DEFAULT_TEST_ORDER_SIZE,
+                            MID_PRICE + level, client, instrument, nullptr);
+    }
+  }
+
+  const auto new_orders = requests.size();
+  for (std::size_t index = 0; index < new_orders; index += 4) {
+    auto cancel_request = requests[index];
+    cancel_request.order_action_ = OrderAction::CANCEL;
+    requests.push_back(cancel_request);
+  }
+
+  requests.emplace_back(OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, order_id++, DEFAULT_TEST_ORDER_SIZE / 2,
+                        MID_PRICE + 1, AGGRESSOR_CLIENT_ID, instrument, nullptr);
+  requests.emplace_back(OrderSide::BUY, OrderAction::NEW, OrderType::MARKET, order_id++,
+                        DEFAULT_TEST_ORDER_SIZE * new_orders, 0, AGGRESSOR_CLIENT_ID, instrument, nullptr);
+  requests.emplace_back(OrderSide::SELL, OrderAction::NEW, OrderType::MARKET, order_id++,
+                        DEFAULT_TEST_ORDER_SIZE * new_orders, 0, AGGRESSOR_CLIENT_ID, instrument, nullptr);
+  return requests;
+}
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(SteadyStateMatching_NoAllocation) {
+
+  /**
+   * Test Scenario:
+   * Same cycle of placing, cancelling and sweeping orders processed over and over, first inline, then through the
+   * queues of a running multi-threaded engine.
+   *
+   * Test Objectives:
+   * 1. Once warmed up, processing requests does not allocate on the heap, either inline or in the engine
+   * 2. Matching still works, every cycle trades and leaves the book empty
+   */
+
+  constexpr std::size_t WARM_UP_CYCLES = 3;
+  constexpr std::size_t MEASURED_CYCLES = 200;
+
+  const auto cycle = steadyStateCycle(DEFAULT_TEST_INSTRUMENT_1_ID);
+
+  {
+    auto observer = std::make_shared<CountingTestObserver>();
+    SynchronousMatchingEngine<> matching_engine{{DEFAULT_TEST_INSTRUMENT_1_ID}, observer};
+
+    for (std::size_t cnt = 0; cnt < WARM_UP_CYCLES; cnt++) {
+      for (const auto &order_request : cycle) matching_engine.doOrderRequest(order_request);
+    }
+    const auto warm_up_trades = observer->trades_.load();
+
+    std::uint64_t allocations{0};
+    {
+      AllocationTracker allocation_tracker;
+      for (std::size_t cnt = 0; cnt < MEASURED_CYCLES; cnt++) {
+        for (const auto &order_request : cycle) matching_engine.doOrderRequest(order_request);
+      }
+      allocations = allocation_tracker.getAllocations();
+    }
+
+    BOOST_TEST_MESSAGE("inline allocations per request "
+                           << static_cast<double>(allocations) / static_cast<double>(MEASURED_CYCLES * cycle.size()));
+    BOOST_CHECK_EQUAL(allocations, 0);
+    BOOST_CHECK(warm_up_trades > 0);
+    BOOST_CHECK_EQUAL(observer->trades_.load(), warm_up_trades / WARM_UP_CYCLES * (WARM_UP_CYCLES + MEASURED_CYCLES));
+
+    const auto *passive_order_book = matching_engine.getPassiveOrderBook(DEFAULT_TEST_INSTRUMENT_1_ID);
+    BOOST_CHECK(passive_order_book->getBidOrderQueue().empty());
+    BOOST_CHECK(passive_order_book->getAskOrderQueue().empty());
+  }
+
+  {
+    constexpr InstrumentType INSTRUMENT_2_ID = DEFAULT_TEST_INSTRUMENT_1_ID + 1;
+    const auto cycle_2 = steadyStateCycle(INSTRUMENT_2_ID);
+
+    auto observer = std::make_shared<CountingTestObserver>();
+    DefaultMatchingEngine<> matching_engine{2, {DEFAULT_TEST_INSTRUMENT_1_ID, INSTRUMENT_2_ID}, observer};
+
+    // Every request of the cycle gets a single response, cycles are drained one at a time
+    std::uint64_t expected_responses{0};
+    bool drained{true};
+    const auto run_cycle = [&] {
+      for (std::size_t index = 0; index < cycle.size(); index++) {
+        matching_engine.doOrderRequest(cycle[index]);
+        matching_engine.doOrderRequest(cycle_2[index]);
+      }
+      expected_responses += cycle.size() + cycle_2.size();
+      const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (observer->responses_.load(std::memory_order_acquire) < expected_responses) {
+        if (std::chrono::steady_clock::now() > timeout) {
+          drained = false;
+          break;
+        }
+        std::this_thread::yield();
+      }
+    };
+
+    for (std::size_t cnt = 0; cnt < WARM_UP_CYCLES; cnt++) run_cycle();
+
+    std::uint64_t allocations{0};
+    {
+      AllocationTracker allocation_tracker;
+      for (std::size_t cnt = 0; cnt < MEASURED_CYCLES && drained; cnt++) run_cycle();
+      allocations = allocation_tracker.getAllocations();
+    }
+    matching_engine.terminate();
+
+    BOOST_TEST_MESSAGE("engine allocations per request "
+                           << static_cast<double>(allocations) / static_cast<double>(expected_responses));
+    BOOST_REQUIRE(drained);
+    BOOST_CHECK_EQUAL(observer->responses_.load(), expected_responses);
+    BOOST_CHECK_EQUAL(allocations, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PooledPassiveOrders_OutliveBook) {
+
+  /**
+   * Test Scenario:
+   * Passive orders drawn from the pool of a book are held on to past a copy of the book and past the book itself.
+   *
+   * Test Objectives:
+   * 1. A copy of the book shares the orders and keeps working once the original is gone
+   * 2. An order held outside any book stays valid after every book is gone
+   */
+
+  PassiveOrderBook<>::PassiveOrderPtr held_order{};
+  {
+    std::optional<PassiveOrderBook<>> passive_order_book{std::in_place};
+    for (OrderIDType order_id = 1; order_id <= 1000; order_id++) {
+      passive_order_book->placePassiveOrder(DEFAULT_TEST_CLIENT_1_ID, order_id, OrderType::LIMIT, OrderSide::BUY,
+                                            DEFAULT_TEST_ORDER_PRICE - order_id % 10, DEFAULT_TEST_ORDER_SIZE,
+                                            nullptr);
+    }
+    held_order = passive_order_book->getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID, 500);
+
+    PassiveOrderBook<> passive_order_book_copy{*passive_order_book};
+    passive_order_book.reset();
+
+    for (OrderIDType order_id = 1; order_id <= 1000; order_id++) {
+      passive_order_book_copy.cancelClientOrder(DEFAULT_TEST_CLIENT_1_ID, order_id);
+      passive_order_book_copy.placePassiveOrder(DEFAULT_TEST_CLIENT_2_ID, order_id, OrderType::LIMIT, OrderSide::SELL,
+                                                DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE, nullptr);
+    }
+    BOOST_CHECK(passive_order_book_copy.isOrderExist(DEFAULT_TEST_CLIENT_2_ID, 1000));
+    BOOST_CHECK(!passive_order_book_copy.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, 1));
+    BOOST_CHECK_EQUAL(passive_order_book_copy.getAskOrderQueue().begin()->second.size(), 1000);
+  }
+
+  BOOST_CHECK_EQUAL(held_order->cln_order_id_, 500);
+  BOOST_CHECK_EQUAL(held_order->remaining_size_, 0);
+  BOOST_CHECK_EQUAL(held_order->price_, DEFAULT_TEST_ORDER_PRICE);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,257 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "matching/matching_algo.hpp"
+#include "events/client_order_request.h"
+#include "matching/validators/amend_request_validators.hpp"
+#include "matching/validators/new_order_request_validators.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(PriceTimePriorityMatching_Amend_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(AmendDown_InPlaceKeepingPriority)
+{
+  /**
+   * Test Scenario:
+   * Two buy orders rest at the same price, the first is amended down, then a sell takes more than its new size.
+   *
+   * Test Objectives:
+   * 1. Amendment is acknowledged with the new size
+   * 2. The amended order keeps its place ahead in the queue, no tombstone is left in the level
+   * 3. Only the amended size of the order is filled, the rest of the sell fills the second order
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id_buy1 = GenTestOrderID();
+  const auto test_order_id_buy2 = GenTestOrderID();
+  const auto test_order_id_sell = GenTestOrderID();
+
+  auto buy1 = makeTestOrderRequest(OrderSide::BUY, test_order_id_buy1, DEFAULT_TEST_ORDER_SIZE,
+                                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID);
+  auto buy2 = makeTestOrderRequest(OrderSide::BUY, test_order_id_buy2, DEFAULT_TEST_ORDER_SIZE,
+                                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID);
+  auto amend = makeTestOrderRequest(OrderSide::BUY, test_order_id_buy1, 40, DEFAULT_TEST_ORDER_PRICE,
+                                    DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().action(OrderAction::AMEND));
+  auto sell = makeTestOrderRequest(OrderSide::SELL, test_order_id_sell, 60, DEFAULT_TEST_ORDER_PRICE,
+                                   DEFAULT_TEST_CLIENT_3_ID);
+
+  matching_algo.doProcessOrderRequest(buy1, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(buy2, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(amend, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 3);
+  BOOST_CHECK(test_observer.client_order_responses_[2] == EngineOrderResponseTestRecord(
+      DEFAULT_TEST_CLIENT_1_ID, test_order_id_buy1, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_ORDER_PRICE, 40,
+      OrderRequestResult::ACK, ValidationResponse::NO_ERROR));
+
+  const auto &bid_level = test_passive_order_book.getBidOrderQueue().begin()->second;
+  BOOST_REQUIRE_EQUAL(bid_level.size(), 2);
+  BOOST_CHECK_EQUAL(bid_level.front()->cln_order_id_, test_order_id_buy1);
+  BOOST_CHECK_EQUAL(bid_level.front()->remaining_size_, 40);
+
+  matching_algo.doProcessOrderRequest(sell, test_passive_order_book, test_observer);
+
+  const auto &trades = test_observer.client_trade_events_;
+  BOOST_REQUIRE_EQUAL(trades.size(), 2);
+  BOOST_CHECK_EQUAL(trades[0].client2_order_id_, test_order_id_buy1);
+  BOOST_CHECK_EQUAL(trades[0].size_, 40);
+  BOOST_CHECK_EQUAL(trades[1].client2_order_id_, test_order_id_buy2);
+  BOOST_CHECK_EQUAL(trades[1].size_, 20);
+
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id_buy1));
+  BOOST_CHECK_EQUAL(test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_2_ID,
+                                                                    test_order_id_buy2)->remaining_size_, 80);
+}
+
+BOOST_AUTO_TEST_CASE(AmendUpOrReprice_Requeued)
+{
+  /**
+   * Test Scenario:
+   * Two buy orders rest at the same price. The first is amended up, the second repriced through a resting sell.
+   *
+   * Test Objectives:
+   * 1. Amending up sends the order to the back of its level
+   * 2. Repricing across the spread matches at the resting price, the rest of the order rests at its new price
+   * 3. Orders keep their custom fields and client order ids across requeueing
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id_buy1 = GenTestOrderID();
+  const auto test_order_id_buy2 = GenTestOrderID();
+  const auto test_order_id_sell = GenTestOrderID();
+  const auto sell_price = DEFAULT_TEST_ORDER_PRICE + 2;
+
+  auto buy1 = makeTestOrderRequest(OrderSide::BUY, test_order_id_buy1, DEFAULT_TEST_ORDER_SIZE,
+                                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID);
+  auto buy2 = makeTestOrderRequest(OrderSide::BUY, test_order_id_buy2, DEFAULT_TEST_ORDER_SIZE,
+                                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID);
+  auto sell = makeTestOrderRequest(OrderSide::SELL, test_order_id_sell, 30, sell_price, DEFAULT_TEST_CLIENT_3_ID);
+  auto amend_up = makeTestOrderRequest(OrderSide::BUY, test_order_id_buy1, 150, DEFAULT_TEST_ORDER_PRICE,
+                                       DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().action(OrderAction::AMEND));
+  auto amend_reprice = makeTestOrderRequest(OrderSide::BUY, test_order_id_buy2, DEFAULT_TEST_ORDER_SIZE, sell_price + 1,
+                                            DEFAULT_TEST_CLIENT_2_ID,
+                                            TestOrderRequestFields().action(OrderAction::AMEND));
+
+  matching_algo.doProcessOrderRequest(buy1, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(buy2, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(sell, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(amend_up, test_passive_order_book, test_observer);
+
+  const auto amended_up_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID,
+                                                                                test_order_id_buy1);
+  const auto buy2_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_2_ID,
+                                                                          test_order_id_buy2);
+  BOOST_REQUIRE(amended_up_order && buy2_order);
+  BOOST_CHECK_EQUAL(amended_up_order->remaining_size_, 150);
+  BOOST_CHECK(amended_up_order->sequence_ > buy2_order->sequence_);
+
+  matching_algo.doProcessOrderRequest(amend_reprice, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 1);
+  const auto &trade = test_observer.client_trade_events_.front();
+  BOOST_CHECK_EQUAL(trade.client1_order_id_, test_order_id_buy2);
+  BOOST_CHECK_EQUAL(trade.client2_order_id_, test_order_id_sell);
+  BOOST_CHECK_EQUAL(trade.trade_price_, sell_price);
+  BOOST_CHECK_EQUAL(trade.size_, 30);
+
+  BOOST_CHECK(test_passive_order_book.getAskOrderQueue().empty());
+  const auto repriced_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_2_ID,
+                                                                              test_order_id_buy2);
+  BOOST_REQUIRE(repriced_order);
+  BOOST_CHECK_EQUAL(repriced_order->price_, sell_price + 1);
+  BOOST_CHECK_EQUAL(repriced_order->remaining_size_, 70);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getBidOrderQueue().begin()->first, sell_price + 1);
+}
+
+BOOST_AUTO_TEST_CASE(AmendRejections)
+{
+  /**
+   * Test Scenario:
+   * Amendments of an unknown order, to zero size, to the other side, and, with in place amendment only, of size up.
+   *
+   * Test Objectives:
+   * 1. Unknown order NACKs with NO_SUCH_ORDER, malformed amendments with INVALID_ORDER_REQUEST
+   * 2. Amend validators veto amendments, the order being left as it was
+   * 3. Amending down still works with in place amendment only
+   */
+
+  using InPlaceOnlyMatching = PriceTimePriorityMatching<void, NoValidator, NoValidator, NoValidator,
+                                                        Validators<void, InPlaceAmendOnlyValidator<void>>>;
+  InPlaceOnlyMatching matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id = GenTestOrderID();
+
+  auto buy = makeTestOrderRequest(OrderSide::BUY, test_order_id, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID);
+  auto amend_unknown = makeTestOrderRequest(OrderSide::BUY, test_order_id + 1, 50, DEFAULT_TEST_ORDER_PRICE,
+                                            DEFAULT_TEST_CLIENT_1_ID,
+                                            TestOrderRequestFields().action(OrderAction::AMEND));
+  auto amend_zero = makeTestOrderRequest(OrderSide::BUY, test_order_id, 0, DEFAULT_TEST_ORDER_PRICE,
+                                         DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().action(OrderAction::AMEND));
+  auto amend_side = makeTestOrderRequest(OrderSide::SELL, test_order_id, 50, DEFAULT_TEST_ORDER_PRICE,
+                                         DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().action(OrderAction::AMEND));
+  auto amend_up = makeTestOrderRequest(OrderSide::BUY, test_order_id, 150, DEFAULT_TEST_ORDER_PRICE,
+                                       DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().action(OrderAction::AMEND));
+  auto amend_reprice = makeTestOrderRequest(OrderSide::BUY, test_order_id, 50, DEFAULT_TEST_ORDER_PRICE + 1,
+                                            DEFAULT_TEST_CLIENT_1_ID,
+                                            TestOrderRequestFields().action(OrderAction::AMEND));
+  auto amend_down = makeTestOrderRequest(OrderSide::BUY, test_order_id, 50, DEFAULT_TEST_ORDER_PRICE,
+                                         DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().action(OrderAction::AMEND));
+
+  for (auto *order_request : {&buy, &amend_unknown, &amend_zero, &amend_side, &amend_up, &amend_reprice}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+
+  const auto &responses = test_observer.client_order_responses_;
+  BOOST_REQUIRE_EQUAL(responses.size(), 6);
+  BOOST_CHECK(responses[1].validation_response_ == ValidationResponse::NO_SUCH_ORDER);
+  for (std::size_t index = 1; index < responses.size(); index++) {
+    BOOST_CHECK(responses[index].request_result_ == OrderRequestResult::NACK);
+    if (index > 1) BOOST_CHECK(responses[index].validation_response_ == ValidationResponse::INVALID_ORDER_REQUEST);
+  }
+
+  const auto passive_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID,
+                                                                             test_order_id);
+  BOOST_REQUIRE(passive_order);
+  BOOST_CHECK_EQUAL(passive_order->remaining_size_, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK_EQUAL(passive_order->price_, DEFAULT_TEST_ORDER_PRICE);
+
+  matching_algo.doProcessOrderRequest(amend_down, test_passive_order_book, test_observer);
+  BOOST_CHECK(responses.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_CHECK_EQUAL(passive_order->remaining_size_, 50);
+}
+
+BOOST_AUTO_TEST_CASE(AmendReplacement_NewOrderValidation)
+{
+  /**
+   * Test Scenario:
+   * Under a maximum order size, a resting buy is amended up beyond it, repriced beyond it, then amended up within it.
+   *
+   * Test Objectives:
+   * 1. Amendment losing priority is NACKed by new order validators, the resting order being left as it was
+   * 2. Order being replaced does not count as a preexisting order id
+   * 3. Amendment within the new order validators is requeued as usual
+   */
+
+  constexpr SizeType MAX_ORDER_SIZE = 150;
+  using SizeLimitedMatching = PriceTimePriorityMatching<
+      void, NoValidator,
+      Validators<void, NoSuchOrderInsertValidator<void>, NewOrderRequestSizeValidator<MAX_ORDER_SIZE, void>>>;
+  SizeLimitedMatching matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id = GenTestOrderID();
+  auto buy = makeTestOrderRequest(OrderSide::BUY, test_order_id, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID);
+  auto amend_up_over = makeTestOrderRequest(OrderSide::BUY, test_order_id, MAX_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                            DEFAULT_TEST_CLIENT_1_ID,
+                                            TestOrderRequestFields().action(OrderAction::AMEND));
+  auto amend_reprice_over = makeTestOrderRequest(OrderSide::BUY, test_order_id, MAX_ORDER_SIZE,
+                                                 DEFAULT_TEST_ORDER_PRICE + 1, DEFAULT_TEST_CLIENT_1_ID,
+                                                 TestOrderRequestFields().action(OrderAction::AMEND));
+  auto amend_up = makeTestOrderRequest(OrderSide::BUY, test_order_id, MAX_ORDER_SIZE - 1, DEFAULT_TEST_ORDER_PRICE,
+                                       DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().action(OrderAction::AMEND));
+
+  for (auto *order_request : {&buy, &amend_up_over, &amend_reprice_over}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+
+  const auto &responses = test_observer.client_order_responses_;
+  BOOST_REQUIRE_EQUAL(responses.size(), 3);
+  for (std::size_t index = 1; index < responses.size(); index++) {
+    BOOST_CHECK(responses[index].request_result_ == OrderRequestResult::NACK);
+    BOOST_CHECK(responses[index].validation_response_ == ValidationResponse::ORDER_SIZE_EXCEED_LIMIT);
+  }
+
+  const auto passive_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID,
+                                                                             test_order_id);
+  BOOST_REQUIRE(passive_order);
+  BOOST_CHECK_EQUAL(passive_order->remaining_size_, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK_EQUAL(passive_order->price_, DEFAULT_TEST_ORDER_PRICE);
+
+  matching_algo.doProcessOrderRequest(amend_up, test_passive_order_book, test_observer);
+  BOOST_CHECK(responses.back().request_result_ == OrderRequestResult::ACK);
+  const auto amended_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID,
+                                                                             test_order_id);
+  BOOST_REQUIRE(amended_order);
+  BOOST_CHECK_EQUAL(amended_order->remaining_size_, MAX_ORDER_SIZE - 1);
+  BOOST_CHECK(amended_order->sequence_ > passive_order->sequence_);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,221 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+
+#include "matching/matching_algo.hpp"
+#include "events/client_order_request.h"
+#include "persistence/book_snapshot.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(PriceTimePriorityMatching_Expiry_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+void checkExpiredResponse(const EngineOrderResponseTestRecord &response,
+                          const ClientType &client,
+                          const OrderIDType &order_id,
+                          const SizeType &size) {
+  BOOST_CHECK(response == EngineOrderResponseTestRecord(
+      client, order_id, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_ORDER_PRICE, size,
+      OrderRequestResult::CANCELLED, ValidationResponse::ORDER_EXPIRED));
+}
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(GoodTillTime_ExpiresInTimeOrder)
+{
+  /**
+   * Test Scenario:
+   * GTT buys expiring at different times rest alongside a GTC buy, one GTT is cancelled and one partially filled,
+   * then expiry is advanced in steps.
+   *
+   * Test Objectives:
+   * 1. GTT orders rest, and are taken out of the book once expiry reaches their expire time, not earlier
+   * 2. Each expired order gets one ORDER_EXPIRED response with its remaining size
+   * 3. Orders cancelled before their expiry and GTC orders never expire
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id_gtt1 = GenTestOrderID();
+  const auto test_order_id_gtt2 = GenTestOrderID();
+  const auto test_order_id_gtt3 = GenTestOrderID();
+  const auto test_order_id_gtc = GenTestOrderID();
+
+  auto gtt1 = makeTestOrderRequest(OrderSide::BUY, test_order_id_gtt1, DEFAULT_TEST_ORDER_SIZE,
+                                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID,
+                                   TestOrderRequestFields().expireTime(1'000));
+  auto gtt2 = makeTestOrderRequest(OrderSide::BUY, test_order_id_gtt2, DEFAULT_TEST_ORDER_SIZE,
+                                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID,
+                                   TestOrderRequestFields().expireTime(2'000));
+  auto gtt3 = makeTestOrderRequest(OrderSide::BUY, test_order_id_gtt3, DEFAULT_TEST_ORDER_SIZE,
+                                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID,
+                                   TestOrderRequestFields().expireTime(1'500));
+  auto gtc = makeTestOrderRequest(OrderSide::BUY, test_order_id_gtc, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_3_ID);
+  auto cancel_gtt3 = makeTestOrderRequest(OrderSide::BUY, test_order_id_gtt3, DEFAULT_TEST_ORDER_SIZE,
+                                          DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID,
+                                          TestOrderRequestFields().action(OrderAction::CANCEL));
+  auto sell = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 40, DEFAULT_TEST_ORDER_PRICE,
+                                   DEFAULT_TEST_CLIENT_4_ID);
+
+  for (auto *order_request : {&gtt1, &gtt2, &gtt3, &gtc, &cancel_gtt3, &sell}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 6);
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 1);
+
+  matching_algo.doExpireOrders(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, 999, test_observer);
+  BOOST_CHECK_EQUAL(test_observer.client_order_responses_.size(), 6);
+
+  matching_algo.doExpireOrders(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, 1'000, test_observer);
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 7);
+  checkExpiredResponse(test_observer.client_order_responses_.back(), DEFAULT_TEST_CLIENT_1_ID, test_order_id_gtt1,
+                       DEFAULT_TEST_ORDER_SIZE - 40);
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id_gtt1));
+  BOOST_CHECK_EQUAL(test_passive_order_book.getBidOrderQueue().begin()->second.total_size_,
+                    DEFAULT_TEST_ORDER_SIZE * 2);
+
+  matching_algo.doExpireOrders(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, 1'000'000, test_observer);
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 8);
+  checkExpiredResponse(test_observer.client_order_responses_.back(), DEFAULT_TEST_CLIENT_1_ID, test_order_id_gtt2,
+                       DEFAULT_TEST_ORDER_SIZE);
+
+  BOOST_CHECK(test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_3_ID, test_order_id_gtc));
+  BOOST_CHECK_EQUAL(test_passive_order_book.getBidOrderQueue().begin()->second.total_size_,
+                    DEFAULT_TEST_ORDER_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(GoodTillTime_KeptAcrossAmendAndSnapshot)
+{
+  /**
+   * Test Scenario:
+   * A GTT order is amended up, losing its priority, and its order id is reused by a GTC order once it expires.
+   * Another GTT order goes through a book snapshot.
+   *
+   * Test Objectives:
+   * 1. Amended order keeps the expire time of the order it replaces, and expires only once
+   * 2. A later order reusing the order id of an expired order does not expire with it
+   * 3. Restored book expires orders as the original book would have
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id = GenTestOrderID();
+  auto gtt = makeTestOrderRequest(OrderSide::BUY, test_order_id, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().expireTime(1'000));
+  auto amend_up = makeTestOrderRequest(OrderSide::BUY, test_order_id, 150, DEFAULT_TEST_ORDER_PRICE,
+                                       DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().action(OrderAction::AMEND));
+  matching_algo.doProcessOrderRequest(gtt, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(amend_up, test_passive_order_book, test_observer);
+
+  const auto amended_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID, test_order_id);
+  BOOST_REQUIRE(amended_order);
+  BOOST_CHECK_EQUAL(amended_order->expire_time_, 1'000);
+
+  matching_algo.doExpireOrders(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, 1'000, test_observer);
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 3);
+  checkExpiredResponse(test_observer.client_order_responses_.back(), DEFAULT_TEST_CLIENT_1_ID, test_order_id, 150);
+
+  auto gtc = makeTestOrderRequest(OrderSide::BUY, test_order_id, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID);
+  const auto test_order_id_snapshot = GenTestOrderID();
+  auto gtt_snapshot = makeTestOrderRequest(OrderSide::BUY, test_order_id_snapshot, DEFAULT_TEST_ORDER_SIZE,
+                                           DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID,
+                                           TestOrderRequestFields().expireTime(5'000));
+  matching_algo.doProcessOrderRequest(gtc, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(gtt_snapshot, test_passive_order_book, test_observer);
+
+  TestTemporaryDirectory snapshot_directory;
+  const auto snapshot_path = (std::filesystem::path(snapshot_directory.path()) / "book.snap").string();
+  saveBookSnapshot(snapshot_path, test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID);
+  PassiveOrderBook<> restored_order_book{};
+  loadBookSnapshot(snapshot_path, restored_order_book);
+
+  matching_algo.doExpireOrders(restored_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, 10'000, test_observer);
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 6);
+  checkExpiredResponse(test_observer.client_order_responses_.back(), DEFAULT_TEST_CLIENT_2_ID,
+                       test_order_id_snapshot, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK(restored_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id));
+}
+
+BOOST_AUTO_TEST_CASE(GoodTillTime_WaitingStopExpires)
+{
+  /**
+   * Test Scenario:
+   * A GTT buy stop limit and a GTC buy stop wait for a trigger above a resting sell. The book goes through a snapshot,
+   * then expiry reaches the expire time of the GTT stop before a trade at the trigger price.
+   *
+   * Test Objectives:
+   * 1. Waiting GTT stop is taken off the trigger book once due, with one ORDER_EXPIRED response of its size
+   * 2. Expired stop is not triggered by a later trade, the GTC stop is
+   * 3. Restored book expires waiting stops as the original book would have
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id_gtt_stop = GenTestOrderID();
+  const auto test_order_id_gtc_stop = GenTestOrderID();
+  auto sell = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID);
+  auto gtt_stop = makeTestOrderRequest(OrderSide::BUY, test_order_id_gtt_stop, 50, DEFAULT_TEST_ORDER_PRICE,
+                                       DEFAULT_TEST_CLIENT_2_ID,
+                                       TestOrderRequestFields().orderType(OrderType::STOP_LIMIT)
+                                           .triggerPrice(DEFAULT_TEST_ORDER_PRICE).expireTime(1'000));
+  auto gtc_stop = makeTestOrderRequest(OrderSide::BUY, test_order_id_gtc_stop, 20, 0, DEFAULT_TEST_CLIENT_4_ID,
+                                       TestOrderRequestFields().orderType(OrderType::STOP)
+                                           .triggerPrice(DEFAULT_TEST_ORDER_PRICE));
+  for (auto *order_request : {&sell, &gtt_stop, &gtc_stop}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 3);
+
+  TestTemporaryDirectory snapshot_directory;
+  const auto snapshot_path = (std::filesystem::path(snapshot_directory.path()) / "book.snap").string();
+  saveBookSnapshot(snapshot_path, test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID);
+  PassiveOrderBook<> restored_order_book{};
+  loadBookSnapshot(snapshot_path, restored_order_book);
+
+  matching_algo.doExpireOrders(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, 999, test_observer);
+  BOOST_CHECK_EQUAL(test_observer.client_order_responses_.size(), 3);
+
+  matching_algo.doExpireOrders(test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, 1'000, test_observer);
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 4);
+  checkExpiredResponse(test_observer.client_order_responses_.back(), DEFAULT_TEST_CLIENT_2_ID,
+                       test_order_id_gtt_stop, 50);
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_2_ID, test_order_id_gtt_stop));
+  BOOST_CHECK(test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_4_ID, test_order_id_gtc_stop));
+
+  auto buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 10, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_3_ID);
+  matching_algo.doProcessOrderRequest(buy, test_passive_order_book, test_observer);
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 2);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 10);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 20);
+  BOOST_CHECK(test_passive_order_book.getTriggerOrderBook().empty());
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+
+  matching_algo.doExpireOrders(restored_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, 1'000, test_observer);
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 6);
+  checkExpiredResponse(test_observer.client_order_responses_.back(), DEFAULT_TEST_CLIENT_2_ID,
+                       test_order_id_gtt_stop, 50);
+  BOOST_CHECK(!restored_order_book.isOrderExist(DEFAULT_TEST_CLIENT_2_ID, test_order_id_gtt_stop));
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,154 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+
+#include "matching/matching_algo.hpp"
+#include "events/client_order_request.h"
+#include "persistence/book_snapshot.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(PriceTimePriorityMatching_Iceberg_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(Iceberg_ReplenishedAtBackOfLevel)
+{
+  /**
+   * Test Scenario:
+   * An iceberg sell rests ahead of a plain sell at the same price, then buys trade through the level.
+   *
+   * Test Objectives:
+   * 1. Iceberg shows only its display size, level size counting its reserve too
+   * 2. Filled slice is replenished from reserve and requeued behind the plain sell, without any request or response
+   * 3. The same buy trades again with the replenished slice once it reaches it
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id_iceberg = GenTestOrderID();
+  auto iceberg = makeTestOrderRequest(OrderSide::SELL, test_order_id_iceberg, 250, DEFAULT_TEST_ORDER_PRICE,
+                                      DEFAULT_TEST_CLIENT_1_ID,
+                                      TestOrderRequestFields().displaySize(DEFAULT_TEST_ORDER_SIZE));
+  auto plain = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                    DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID);
+  matching_algo.doProcessOrderRequest(iceberg, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(plain, test_passive_order_book, test_observer);
+
+  const auto iceberg_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID,
+                                                                             test_order_id_iceberg);
+  BOOST_REQUIRE(iceberg_order);
+  BOOST_CHECK_EQUAL(iceberg_order->remaining_size_, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK_EQUAL(iceberg_order->reserve_size_, 150);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_, 350);
+
+  auto buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 150, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_3_ID);
+  matching_algo.doProcessOrderRequest(buy, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 2);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+  BOOST_CHECK_EQUAL(iceberg_order->remaining_size_, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK_EQUAL(iceberg_order->reserve_size_, 50);
+  BOOST_CHECK(test_passive_order_book.getAskOrderQueue().begin()->second.back() == iceberg_order);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_, 200);
+
+  auto sweep = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 250, DEFAULT_TEST_ORDER_PRICE,
+                                    DEFAULT_TEST_CLIENT_3_ID);
+  matching_algo.doProcessOrderRequest(sweep, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 5);
+  checkTradeEvent(test_observer.client_trade_events_[2], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+  checkTradeEvent(test_observer.client_trade_events_[3], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+  checkTradeEvent(test_observer.client_trade_events_[4], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+
+  BOOST_CHECK_EQUAL(test_observer.client_order_responses_.size(), 4);
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id_iceberg));
+  BOOST_CHECK(test_passive_order_book.getAskOrderQueue().empty());
+  // What is left of the sweep rests
+  BOOST_CHECK_EQUAL(test_passive_order_book.getBidOrderQueue().begin()->second.total_size_, 50);
+}
+
+BOOST_AUTO_TEST_CASE(Iceberg_FillOrKillAmendAndSnapshot)
+{
+  /**
+   * Test Scenario:
+   * A FOK buy needs the reserve of an iceberg to fill. Another iceberg is partly filled, amended down, and goes
+   * through a book snapshot.
+   *
+   * Test Objectives:
+   * 1. FOK counts the reserve of icebergs as liquidity
+   * 2. Amending an iceberg down sizes down its reserve first, keeping its shown slice
+   * 3. Restored iceberg has its partly filled slice, reserve and display size, and is cancelled in full
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  auto iceberg_fok = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 300, DEFAULT_TEST_ORDER_PRICE,
+                                          DEFAULT_TEST_CLIENT_1_ID,
+                                          TestOrderRequestFields().displaySize(DEFAULT_TEST_ORDER_SIZE));
+  auto fok = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 300, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_3_ID);
+  fok.time_in_force_ = TimeInForce::FOK;
+  matching_algo.doProcessOrderRequest(iceberg_fok, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(fok, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.size(), 3);
+  BOOST_CHECK(test_passive_order_book.getAskOrderQueue().empty());
+
+  const auto test_order_id_iceberg = GenTestOrderID();
+  auto iceberg = makeTestOrderRequest(OrderSide::SELL, test_order_id_iceberg, 400, DEFAULT_TEST_ORDER_PRICE,
+                                      DEFAULT_TEST_CLIENT_2_ID,
+                                      TestOrderRequestFields().displaySize(DEFAULT_TEST_ORDER_SIZE));
+  auto buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 30, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_3_ID);
+  auto amend_down = makeTestOrderRequest(OrderSide::SELL, test_order_id_iceberg, 270, DEFAULT_TEST_ORDER_PRICE,
+                                         DEFAULT_TEST_CLIENT_2_ID);
+  amend_down.order_action_ = OrderAction::AMEND;
+  for (auto *order_request : {&iceberg, &buy, &amend_down}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+
+  const auto iceberg_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_2_ID,
+                                                                             test_order_id_iceberg);
+  BOOST_REQUIRE(iceberg_order);
+  BOOST_CHECK_EQUAL(iceberg_order->remaining_size_, 70);
+  BOOST_CHECK_EQUAL(iceberg_order->reserve_size_, 200);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_, 270);
+
+  TestTemporaryDirectory snapshot_directory;
+  const auto snapshot_path = (std::filesystem::path(snapshot_directory.path()) / "book.snap").string();
+  saveBookSnapshot(snapshot_path, test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID);
+  PassiveOrderBook<> restored_order_book{};
+  loadBookSnapshot(snapshot_path, restored_order_book);
+
+  const auto restored_order = restored_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_2_ID,
+                                                                          test_order_id_iceberg);
+  BOOST_REQUIRE(restored_order);
+  BOOST_CHECK_EQUAL(restored_order->remaining_size_, 70);
+  BOOST_CHECK_EQUAL(restored_order->reserve_size_, 200);
+  BOOST_CHECK_EQUAL(restored_order->display_size_, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK_EQUAL(restored_order_book.getAskOrderQueue().begin()->second.total_size_, 270);
+
+  restored_order_book.cancelClientOrder(DEFAULT_TEST_CLIENT_2_ID, test_order_id_iceberg);
+  BOOST_CHECK_EQUAL(restored_order->getOpenSize(), 0);
+  BOOST_CHECK_EQUAL(restored_order_book.getAskOrderQueue().begin()->second.total_size_, 0);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
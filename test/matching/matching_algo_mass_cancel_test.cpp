@@ -0,0 +1,132 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <tuple>
+
+#include "matching/matching_algo.hpp"
+#include "events/client_order_request.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(PriceTimePriorityMatching_MassCancel_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+// Places buys at price and price - 1 and sells at price + 1 for client, plus a buy at price for another client
+void placeTestOrders(PriceTimePriorityMatching<> &matching_algo,
+                     PassiveOrderBook<> &passive_order_book,
+                     EngineEventTestObserver &observer,
+                     const ClientType &client,
+                     const ClientType &other_client) {
+  const auto price = DEFAULT_TEST_ORDER_PRICE;
+  for (auto [side, order_price, order_client] : {std::tuple{OrderSide::BUY, price, client},
+                                                 std::tuple{OrderSide::BUY, price, other_client},
+                                                 std::tuple{OrderSide::BUY, price, client},
+                                                 std::tuple{OrderSide::BUY, price - 1, client},
+                                                 std::tuple{OrderSide::SELL, price + 1, client},
+                                                 std::tuple{OrderSide::SELL, price + 1, client}}) {
+    auto order_request = makeTestOrderRequest(side, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, order_price,
+                                              order_client);
+    matching_algo.doProcessOrderRequest(order_request, passive_order_book, observer);
+  }
+}
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(MassCancel_AllOrdersOfClient)
+{
+  /**
+   * Test Scenario:
+   * A client with buys and sells resting across price levels alongside another client is mass cancelled.
+   *
+   * Test Objectives:
+   * 1. A single ACK response, carrying number of orders cancelled as size
+   * 2. Every order of the client is cancelled, orders of other clients are left untouched
+   * 3. Cancelled orders are never matched, levels left with cancelled orders only are removed when matched through
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  placeTestOrders(matching_algo, test_passive_order_book, test_observer, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_CLIENT_2_ID);
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 6);
+
+  const auto test_mass_cancel_id = GenTestOrderID();
+  auto mass_cancel = makeTestOrderRequest(OrderSide::BUY, test_mass_cancel_id, DEFAULT_TEST_ORDER_SIZE, 0,
+                                          DEFAULT_TEST_CLIENT_1_ID,
+                                          TestOrderRequestFields().action(OrderAction::MASS_CANCEL));
+  matching_algo.doProcessOrderRequest(mass_cancel, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_order_responses_.size(), 7);
+  BOOST_CHECK(test_observer.client_order_responses_.back() == EngineOrderResponseTestRecord(
+      DEFAULT_TEST_CLIENT_1_ID, test_mass_cancel_id, DEFAULT_TEST_INSTRUMENT_1_ID, 0, 5,
+      OrderRequestResult::ACK, ValidationResponse::NO_ERROR));
+
+  std::size_t remaining_orders{0};
+  test_passive_order_book.forEachClientOrder(DEFAULT_TEST_CLIENT_1_ID, [&](const auto &) { remaining_orders++; });
+  BOOST_CHECK_EQUAL(remaining_orders, 0);
+  test_passive_order_book.forEachClientOrder(DEFAULT_TEST_CLIENT_2_ID, [&](const auto &) { remaining_orders++; });
+  BOOST_CHECK_EQUAL(remaining_orders, 1);
+
+  // Sweeping every bid level only trades with the other client
+  auto sell = ClientOrderRequest<>{OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(),
+                                   DEFAULT_TEST_ORDER_SIZE * 5, DEFAULT_TEST_ORDER_PRICE - 1,
+                                   DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_INSTRUMENT_1_ID};
+  matching_algo.doProcessOrderRequest(sell, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 1);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.front().client2_, DEFAULT_TEST_CLIENT_2_ID);
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+}
+
+BOOST_AUTO_TEST_CASE(MassCancel_SideOnlyAndNoOrders)
+{
+  /**
+   * Test Scenario:
+   * A client is mass cancelled on the sell side only, then a client without any order is mass cancelled.
+   *
+   * Test Objectives:
+   * 1. Only orders on the given side are cancelled
+   * 2. Mass cancel of a client without orders is still ACKed, with 0 orders cancelled
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  placeTestOrders(matching_algo, test_passive_order_book, test_observer, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_CLIENT_2_ID);
+
+  auto mass_cancel_sell = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                               DEFAULT_TEST_CLIENT_1_ID,
+                                               TestOrderRequestFields().action(OrderAction::MASS_CANCEL_SIDE));
+  matching_algo.doProcessOrderRequest(mass_cancel_sell, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_CHECK_EQUAL(test_observer.client_order_responses_.back().size_, 2);
+
+  std::size_t remaining_buys{0};
+  test_passive_order_book.forEachClientOrder(DEFAULT_TEST_CLIENT_1_ID, [&](const auto &passive_order) {
+    BOOST_CHECK(passive_order.side_ == OrderSide::BUY);
+    remaining_buys++;
+  });
+  BOOST_CHECK_EQUAL(remaining_buys, 3);
+
+  auto mass_cancel_none = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                               DEFAULT_TEST_CLIENT_4_ID,
+                                               TestOrderRequestFields().action(OrderAction::MASS_CANCEL));
+  matching_algo.doProcessOrderRequest(mass_cancel_none, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_CHECK_EQUAL(test_observer.client_order_responses_.back().size_, 0);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
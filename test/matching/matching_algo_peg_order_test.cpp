@@ -0,0 +1,237 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+
+#include "matching/matching_algo.hpp"
+#include "events/client_order_request.h"
+#include "persistence/book_snapshot.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(PriceTimePriorityMatching_PegOrder_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(PegOrder_FollowsBestPrices)
+{
+  /**
+   * Test Scenario:
+   * A primary pegged and a mid pegged buy rest alongside limit orders, then a better limit bid moves the best bid.
+   * Market sells then sweep the bids.
+   *
+   * Test Objectives:
+   * 1. Pegged orders are priced off the best prices of limit orders, and follow them without any request
+   * 2. Mid peg priced better than the best level trades first, at its mid price
+   * 3. Primary peg trades behind the limit orders of the best level, at its price
+   * 4. Pegged order can be cancelled
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  auto bid = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE - 2, DEFAULT_TEST_CLIENT_1_ID);
+  auto ask = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE + 4, DEFAULT_TEST_CLIENT_1_ID);
+  const auto test_order_id_primary = GenTestOrderID();
+  auto primary_peg = makeTestOrderRequest(OrderSide::BUY, test_order_id_primary, DEFAULT_TEST_ORDER_SIZE, 0,
+                                          DEFAULT_TEST_CLIENT_2_ID,
+                                          TestOrderRequestFields().orderType(OrderType::PRIMARY_PEG));
+  auto mid_peg = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                      DEFAULT_TEST_CLIENT_3_ID, TestOrderRequestFields().orderType(OrderType::MID_PEG));
+  for (auto *order_request : {&bid, &ask, &primary_peg, &mid_peg}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+    BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  }
+
+  BOOST_CHECK(test_observer.client_trade_events_.empty());
+  BOOST_CHECK_EQUAL(*test_passive_order_book.getPegPrice(OrderSide::BUY, OrderType::PRIMARY_PEG),
+                    DEFAULT_TEST_ORDER_PRICE - 2);
+  BOOST_CHECK_EQUAL(*test_passive_order_book.getPegPrice(OrderSide::BUY, OrderType::MID_PEG),
+                    DEFAULT_TEST_ORDER_PRICE + 1);
+  BOOST_CHECK_EQUAL(*test_passive_order_book.getPegPrice(OrderSide::SELL, OrderType::MID_PEG),
+                    DEFAULT_TEST_ORDER_PRICE + 1);
+
+  auto better_bid = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                         DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID);
+  matching_algo.doProcessOrderRequest(better_bid, test_passive_order_book, test_observer);
+
+  BOOST_CHECK_EQUAL(*test_passive_order_book.getPegPrice(OrderSide::BUY, OrderType::PRIMARY_PEG),
+                    DEFAULT_TEST_ORDER_PRICE);
+  BOOST_CHECK_EQUAL(*test_passive_order_book.getPegPrice(OrderSide::BUY, OrderType::MID_PEG),
+                    DEFAULT_TEST_ORDER_PRICE + 2);
+  // Mid between two ticks is rounded down for bids, up for asks
+  BOOST_CHECK_EQUAL(*test_passive_order_book.getPegPrice(OrderSide::SELL, OrderType::MID_PEG),
+                    DEFAULT_TEST_ORDER_PRICE + 2);
+
+  auto sell = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 150, 0, DEFAULT_TEST_CLIENT_4_ID,
+                                   TestOrderRequestFields().orderType(OrderType::MARKET));
+  matching_algo.doProcessOrderRequest(sell, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 2);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_3_ID,
+                  DEFAULT_TEST_ORDER_PRICE + 2, DEFAULT_TEST_ORDER_SIZE);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+
+  auto sell_more = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 80, 0, DEFAULT_TEST_CLIENT_4_ID,
+                                        TestOrderRequestFields().orderType(OrderType::MARKET));
+  matching_algo.doProcessOrderRequest(sell_more, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 4);
+  checkTradeEvent(test_observer.client_trade_events_[2], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+  checkTradeEvent(test_observer.client_trade_events_[3], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 30);
+
+  // Left with the bid two ticks below, which the primary peg follows down
+  BOOST_CHECK_EQUAL(*test_passive_order_book.getPegPrice(OrderSide::BUY, OrderType::PRIMARY_PEG),
+                    DEFAULT_TEST_ORDER_PRICE - 2);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getPegQueue(OrderSide::BUY, OrderType::PRIMARY_PEG).total_size_, 70);
+
+  auto cancel = primary_peg;
+  cancel.order_action_ = OrderAction::CANCEL;
+  matching_algo.doProcessOrderRequest(cancel, test_passive_order_book, test_observer);
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_2_ID, test_order_id_primary));
+  BOOST_CHECK(!test_passive_order_book.hasPegOrders(OrderSide::BUY));
+}
+
+BOOST_AUTO_TEST_CASE(PegOrder_WithoutPriceAndFillOrKill)
+{
+  /**
+   * Test Scenario:
+   * A primary pegged sell rests on an empty book, then a limit sell gives it a price. A FOK buy needs both to fill.
+   * A pegged IOC is sent, and a pegged order is amended down.
+   *
+   * Test Objectives:
+   * 1. Pegged order without a price to peg to rests, but does not trade
+   * 2. FOK counts pegged orders crossing its price as liquidity
+   * 3. Pegged IOC is NACKed with INVALID_ORDER_REQUEST
+   * 4. Pegged order amended down keeps its priority
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  const auto test_order_id_peg = GenTestOrderID();
+  auto primary_peg = makeTestOrderRequest(OrderSide::SELL, test_order_id_peg, DEFAULT_TEST_ORDER_SIZE, 0,
+                                          DEFAULT_TEST_CLIENT_1_ID,
+                                          TestOrderRequestFields().orderType(OrderType::PRIMARY_PEG));
+  auto market_buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                         DEFAULT_TEST_CLIENT_3_ID,
+                                         TestOrderRequestFields().orderType(OrderType::MARKET));
+  matching_algo.doProcessOrderRequest(primary_peg, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(market_buy, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(!test_passive_order_book.getPegPrice(OrderSide::SELL, OrderType::PRIMARY_PEG));
+  BOOST_CHECK(test_observer.client_trade_events_.empty());
+  BOOST_CHECK(test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id_peg));
+
+  auto ask = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_2_ID);
+  auto amend_down = makeTestOrderRequest(OrderSide::SELL, test_order_id_peg, 60, 0, DEFAULT_TEST_CLIENT_1_ID,
+                                         TestOrderRequestFields().orderType(OrderType::PRIMARY_PEG));
+  amend_down.order_action_ = OrderAction::AMEND;
+  auto second_peg = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                         DEFAULT_TEST_CLIENT_4_ID,
+                                         TestOrderRequestFields().orderType(OrderType::PRIMARY_PEG));
+  for (auto *order_request : {&ask, &second_peg, &amend_down}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+    BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  }
+
+  auto ioc_peg = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                      DEFAULT_TEST_CLIENT_3_ID, TestOrderRequestFields().orderType(OrderType::MID_PEG));
+  ioc_peg.time_in_force_ = TimeInForce::IOC;
+  matching_algo.doProcessOrderRequest(ioc_peg, test_passive_order_book, test_observer);
+  BOOST_CHECK(test_observer.client_order_responses_.back().validation_response_
+                  == ValidationResponse::INVALID_ORDER_REQUEST);
+
+  auto fok_too_large = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 261, DEFAULT_TEST_ORDER_PRICE,
+                                            DEFAULT_TEST_CLIENT_3_ID);
+  fok_too_large.time_in_force_ = TimeInForce::FOK;
+  matching_algo.doProcessOrderRequest(fok_too_large, test_passive_order_book, test_observer);
+  BOOST_CHECK(test_observer.client_order_responses_.back().validation_response_ == ValidationResponse::NOT_FILLABLE);
+
+  auto fok = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 260, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_3_ID);
+  fok.time_in_force_ = TimeInForce::FOK;
+  matching_algo.doProcessOrderRequest(fok, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 3);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 60);
+  checkTradeEvent(test_observer.client_trade_events_[2], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_4_ID,
+                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK(!test_passive_order_book.hasPegOrders(OrderSide::SELL));
+}
+
+BOOST_AUTO_TEST_CASE(PegOrder_KeptInSnapshot)
+{
+  /**
+   * Test Scenario:
+   * Pegged orders of both peg types rest on both sides, and the book goes through a snapshot.
+   *
+   * Test Objectives:
+   * 1. Restored book has the pegged orders in their peg queues, in time priority
+   * 2. Restored pegged orders are priced and trade as in the original book
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  auto bid = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE - 2, DEFAULT_TEST_CLIENT_1_ID);
+  auto ask = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE + 2, DEFAULT_TEST_CLIENT_1_ID);
+  const auto test_order_id_mid_1 = GenTestOrderID();
+  const auto test_order_id_mid_2 = GenTestOrderID();
+  auto mid_peg_1 = makeTestOrderRequest(OrderSide::SELL, test_order_id_mid_1, 30, 0, DEFAULT_TEST_CLIENT_2_ID,
+                                        TestOrderRequestFields().orderType(OrderType::MID_PEG));
+  auto mid_peg_2 = makeTestOrderRequest(OrderSide::SELL, test_order_id_mid_2, 40, 0, DEFAULT_TEST_CLIENT_3_ID,
+                                        TestOrderRequestFields().orderType(OrderType::MID_PEG));
+  auto primary_peg = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                          DEFAULT_TEST_CLIENT_2_ID,
+                                          TestOrderRequestFields().orderType(OrderType::PRIMARY_PEG));
+  for (auto *order_request : {&bid, &ask, &mid_peg_1, &mid_peg_2, &primary_peg}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+
+  TestTemporaryDirectory snapshot_directory;
+  const auto snapshot_path = (std::filesystem::path(snapshot_directory.path()) / "book.snap").string();
+  saveBookSnapshot(snapshot_path, test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID);
+  PassiveOrderBook<> restored_order_book{};
+  const auto header = loadBookSnapshot(snapshot_path, restored_order_book);
+
+  BOOST_CHECK_EQUAL(header.order_count_, 5);
+  const auto &mid_peg_queue = restored_order_book.getPegQueue(OrderSide::SELL, OrderType::MID_PEG);
+  BOOST_REQUIRE_EQUAL(mid_peg_queue.size(), 2);
+  BOOST_CHECK_EQUAL(mid_peg_queue.front()->cln_order_id_, test_order_id_mid_1);
+  BOOST_CHECK(mid_peg_queue.front()->order_type_ == OrderType::MID_PEG);
+  BOOST_CHECK_EQUAL(mid_peg_queue.total_size_, 70);
+  BOOST_CHECK_EQUAL(restored_order_book.getPegQueue(OrderSide::BUY, OrderType::PRIMARY_PEG).total_size_,
+                    DEFAULT_TEST_ORDER_SIZE);
+
+  auto buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 50, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_4_ID);
+  matching_algo.doProcessOrderRequest(buy, restored_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 2);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 30);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_3_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 20);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
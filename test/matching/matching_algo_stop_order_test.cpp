@@ -0,0 +1,252 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <utility>
+
+#include "matching/matching_algo.hpp"
+#include "events/client_order_request.h"
+#include "persistence/book_snapshot.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(PriceTimePriorityMatching_StopOrder_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+// Rests sells of default size from client at default price and the two ticks above
+void placeTestAsks(PriceTimePriorityMatching<> &matching_algo,
+                   PassiveOrderBook<> &passive_order_book,
+                   EngineEventTestObserver &observer,
+                   const ClientType &client) {
+  for (const auto &price : {DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_PRICE + 1, DEFAULT_TEST_ORDER_PRICE + 2}) {
+    auto order_request = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, price,
+                                              client);
+    matching_algo.doProcessOrderRequest(order_request, passive_order_book, observer);
+  }
+}
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(StopOrder_TriggeredInCascade)
+{
+  /**
+   * Test Scenario:
+   * A buy stop and a buy stop limit wait with different trigger prices, along with a sell stop, before any trade.
+   * A buy then trades at the lowest trigger price.
+   *
+   * Test Objectives:
+   * 1. Stops are ACKed and wait off the book, nothing triggers before the first trade
+   * 2. Stop limit triggered enters as a limit order at its price, its trade triggering the next stop in turn
+   * 3. Stop triggered enters as a market order, trades under its own order id, no response sent on trigger
+   * 4. Sell stop is left waiting by trades above its trigger price
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  placeTestAsks(matching_algo, test_passive_order_book, test_observer, DEFAULT_TEST_CLIENT_1_ID);
+
+  const auto test_order_id_stop = GenTestOrderID();
+  const auto test_order_id_stop_limit = GenTestOrderID();
+  const auto test_order_id_sell_stop = GenTestOrderID();
+  auto stop = makeTestOrderRequest(OrderSide::BUY, test_order_id_stop, DEFAULT_TEST_ORDER_SIZE, 0,
+                                   DEFAULT_TEST_CLIENT_2_ID,
+                                   TestOrderRequestFields().orderType(OrderType::STOP)
+                                       .triggerPrice(DEFAULT_TEST_ORDER_PRICE + 1));
+  auto stop_limit = makeTestOrderRequest(OrderSide::BUY, test_order_id_stop_limit, 50, DEFAULT_TEST_ORDER_PRICE + 1,
+                                         DEFAULT_TEST_CLIENT_3_ID,
+                                         TestOrderRequestFields().orderType(OrderType::STOP_LIMIT)
+                                             .triggerPrice(DEFAULT_TEST_ORDER_PRICE));
+  auto sell_stop = makeTestOrderRequest(OrderSide::SELL, test_order_id_sell_stop, DEFAULT_TEST_ORDER_SIZE, 0,
+                                        DEFAULT_TEST_CLIENT_3_ID,
+                                        TestOrderRequestFields().orderType(OrderType::STOP)
+                                            .triggerPrice(DEFAULT_TEST_ORDER_PRICE - 10));
+  for (auto *order_request : {&stop, &stop_limit, &sell_stop}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+    BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  }
+
+  BOOST_CHECK(test_observer.client_trade_events_.empty());
+  BOOST_CHECK(test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_2_ID, test_order_id_stop));
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+
+  const auto test_order_id_buy = GenTestOrderID();
+  auto buy = makeTestOrderRequest(OrderSide::BUY, test_order_id_buy, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_4_ID);
+  matching_algo.doProcessOrderRequest(buy, test_passive_order_book, test_observer);
+
+  BOOST_CHECK_EQUAL(test_observer.client_order_responses_.size(), 7);
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 4);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_[0].client1_order_id_, test_order_id_buy);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE + 1, 50);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_[1].client1_order_id_, test_order_id_stop_limit);
+  checkTradeEvent(test_observer.client_trade_events_[2], DEFAULT_TEST_CLIENT_2_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE + 1, 50);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_[2].client1_order_id_, test_order_id_stop);
+  checkTradeEvent(test_observer.client_trade_events_[3], DEFAULT_TEST_CLIENT_2_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE + 2, 50);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_[3].client1_order_id_, test_order_id_stop);
+
+  BOOST_CHECK_EQUAL(test_passive_order_book.getLastTradePrice(), DEFAULT_TEST_ORDER_PRICE + 2);
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_2_ID, test_order_id_stop));
+  BOOST_CHECK(test_passive_order_book.getTriggerOrderBook().getBuyTriggerLevels().empty());
+  BOOST_CHECK(test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_3_ID, test_order_id_sell_stop));
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+}
+
+BOOST_AUTO_TEST_CASE(StopOrder_RejectCancelAndTriggerOnEntry)
+{
+  /**
+   * Test Scenario:
+   * A stop without trigger price is sent. A waiting stop is amended. Stops of a client are cancelled and mass
+   * cancelled.
+   * After a trade, a sell stop limit is sent with a trigger price the trade is already at.
+   *
+   * Test Objectives:
+   * 1. Stop without trigger price is NACKed with INVALID_ORDER_REQUEST
+   * 2. Amending a waiting stop is NACKed with INVALID_ORDER_REQUEST, the stop being left waiting
+   * 3. Cancel takes a waiting stop off the trigger book, mass cancel counts waiting stops among orders cancelled
+   * 4. Stop already reached by the last trade triggers right away
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  auto no_trigger = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                         DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().orderType(OrderType::STOP));
+  matching_algo.doProcessOrderRequest(no_trigger, test_passive_order_book, test_observer);
+  BOOST_CHECK(test_observer.client_order_responses_.back().validation_response_
+                  == ValidationResponse::INVALID_ORDER_REQUEST);
+
+  const auto test_order_id_stop = GenTestOrderID();
+  auto stop = makeTestOrderRequest(OrderSide::BUY, test_order_id_stop, DEFAULT_TEST_ORDER_SIZE, 0,
+                                   DEFAULT_TEST_CLIENT_1_ID,
+                                   TestOrderRequestFields().orderType(OrderType::STOP)
+                                       .triggerPrice(DEFAULT_TEST_ORDER_PRICE + 5));
+  auto amend = stop;
+  amend.order_action_ = OrderAction::AMEND;
+  amend.size_ = DEFAULT_TEST_ORDER_SIZE / 2;
+  auto cancel = stop;
+  cancel.order_action_ = OrderAction::CANCEL;
+  matching_algo.doProcessOrderRequest(stop, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(amend, test_passive_order_book, test_observer);
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::NACK);
+  BOOST_CHECK(test_observer.client_order_responses_.back().validation_response_
+                  == ValidationResponse::INVALID_ORDER_REQUEST);
+  BOOST_CHECK(test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id_stop));
+  matching_algo.doProcessOrderRequest(cancel, test_passive_order_book, test_observer);
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id_stop));
+  BOOST_CHECK(test_passive_order_book.getTriggerOrderBook().empty());
+
+  for (const auto &side : {OrderSide::BUY, OrderSide::SELL}) {
+    auto stop_to_mass_cancel = makeTestOrderRequest(side, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                                    DEFAULT_TEST_CLIENT_1_ID,
+                                                    TestOrderRequestFields().orderType(OrderType::STOP)
+                                                        .triggerPrice(DEFAULT_TEST_ORDER_PRICE));
+    matching_algo.doProcessOrderRequest(stop_to_mass_cancel, test_passive_order_book, test_observer);
+  }
+  auto resting = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                      DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID);
+  matching_algo.doProcessOrderRequest(resting, test_passive_order_book, test_observer);
+  auto mass_cancel = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 0, 0, DEFAULT_TEST_CLIENT_1_ID);
+  mass_cancel.order_action_ = OrderAction::MASS_CANCEL;
+  matching_algo.doProcessOrderRequest(mass_cancel, test_passive_order_book, test_observer);
+  BOOST_CHECK_EQUAL(test_observer.client_order_responses_.back().size_, 3);
+  BOOST_CHECK(test_passive_order_book.getTriggerOrderBook().empty());
+
+  // Trade at default price
+  for (const auto &[side, client] : {std::pair{OrderSide::BUY, DEFAULT_TEST_CLIENT_2_ID},
+                                     std::pair{OrderSide::BUY, DEFAULT_TEST_CLIENT_2_ID},
+                                     std::pair{OrderSide::SELL, DEFAULT_TEST_CLIENT_3_ID}}) {
+    auto order_request = makeTestOrderRequest(side, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                              client);
+    matching_algo.doProcessOrderRequest(order_request, test_passive_order_book, test_observer);
+  }
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 1);
+
+  const auto test_order_id_sell_stop = GenTestOrderID();
+  auto sell_stop_limit = makeTestOrderRequest(OrderSide::SELL, test_order_id_sell_stop, 40, DEFAULT_TEST_ORDER_PRICE,
+                                              DEFAULT_TEST_CLIENT_4_ID,
+                                              TestOrderRequestFields().orderType(OrderType::STOP_LIMIT)
+                                                  .triggerPrice(DEFAULT_TEST_ORDER_PRICE));
+  matching_algo.doProcessOrderRequest(sell_stop_limit, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 2);
+  checkTradeEvent(test_observer.client_trade_events_.back(), DEFAULT_TEST_CLIENT_4_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 40);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.back().client1_order_id_, test_order_id_sell_stop);
+  BOOST_CHECK(test_passive_order_book.getTriggerOrderBook().empty());
+}
+
+BOOST_AUTO_TEST_CASE(StopOrder_KeptInSnapshot)
+{
+  /**
+   * Test Scenario:
+   * Stops wait on both sides after a trade, and the book goes through a snapshot.
+   *
+   * Test Objectives:
+   * 1. Restored book has the waiting stops, with their trigger and limit prices, and the last trade price
+   * 2. Restored book triggers stops as the original book would have
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  placeTestAsks(matching_algo, test_passive_order_book, test_observer, DEFAULT_TEST_CLIENT_1_ID);
+  auto buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 10, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_2_ID);
+  matching_algo.doProcessOrderRequest(buy, test_passive_order_book, test_observer);
+
+  const auto test_order_id_stop_limit = GenTestOrderID();
+  auto stop_limit = makeTestOrderRequest(OrderSide::BUY, test_order_id_stop_limit, 50, DEFAULT_TEST_ORDER_PRICE + 1,
+                                         DEFAULT_TEST_CLIENT_3_ID,
+                                         TestOrderRequestFields().orderType(OrderType::STOP_LIMIT)
+                                             .triggerPrice(DEFAULT_TEST_ORDER_PRICE + 1));
+  auto sell_stop = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, 0,
+                                        DEFAULT_TEST_CLIENT_3_ID,
+                                        TestOrderRequestFields().orderType(OrderType::STOP)
+                                            .triggerPrice(DEFAULT_TEST_ORDER_PRICE - 1));
+  matching_algo.doProcessOrderRequest(stop_limit, test_passive_order_book, test_observer);
+  matching_algo.doProcessOrderRequest(sell_stop, test_passive_order_book, test_observer);
+
+  TestTemporaryDirectory snapshot_directory;
+  const auto snapshot_path = (std::filesystem::path(snapshot_directory.path()) / "book.snap").string();
+  saveBookSnapshot(snapshot_path, test_passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID);
+  PassiveOrderBook<> restored_order_book{};
+  loadBookSnapshot(snapshot_path, restored_order_book);
+
+  BOOST_CHECK_EQUAL(restored_order_book.getLastTradePrice(), DEFAULT_TEST_ORDER_PRICE);
+  const auto &buy_trigger_levels = restored_order_book.getTriggerOrderBook().getBuyTriggerLevels();
+  BOOST_REQUIRE_EQUAL(buy_trigger_levels.size(), 1);
+  BOOST_CHECK_EQUAL(buy_trigger_levels.begin()->first, DEFAULT_TEST_ORDER_PRICE + 1);
+  BOOST_REQUIRE_EQUAL(buy_trigger_levels.begin()->second.size(), 1);
+  BOOST_CHECK(buy_trigger_levels.begin()->second.front().order_type_ == OrderType::STOP_LIMIT);
+  BOOST_CHECK_EQUAL(buy_trigger_levels.begin()->second.front().price_, DEFAULT_TEST_ORDER_PRICE + 1);
+  BOOST_CHECK_EQUAL(restored_order_book.getTriggerOrderBook().getSellTriggerLevels().size(), 1);
+
+  auto sweep = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                    DEFAULT_TEST_ORDER_PRICE + 1, DEFAULT_TEST_CLIENT_4_ID);
+  matching_algo.doProcessOrderRequest(sweep, restored_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 4);
+  checkTradeEvent(test_observer.client_trade_events_.back(), DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE + 1, 50);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.back().client1_order_id_, test_order_id_stop_limit);
+  BOOST_CHECK(restored_order_book.getTriggerOrderBook().getBuyTriggerLevels().empty());
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
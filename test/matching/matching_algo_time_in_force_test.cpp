@@ -0,0 +1,165 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "matching/matching_algo.hpp"
+#include "events/client_order_request.h"
+#include "matching/validators/matching_validators.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(PriceTimePriorityMatching_TimeInForce_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+// Rests sells of default size at default price and one tick above, from client and another client in turn
+template<typename MatchingAlgo>
+void placeTestAsks(MatchingAlgo &matching_algo,
+                   PassiveOrderBook<> &passive_order_book,
+                   EngineEventTestObserver &observer,
+                   const ClientType &client,
+                   const ClientType &other_client) {
+  for (const auto &price : {DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_PRICE + 1}) {
+    for (const auto &order_client : {client, other_client}) {
+      auto order_request = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, price,
+                                                order_client);
+      matching_algo.doProcessOrderRequest(order_request, passive_order_book, observer);
+    }
+  }
+}
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(ImmediateOrCancel_NeverRests)
+{
+  /**
+   * Test Scenario:
+   * IOC buys cross part of the resting sells, or do not cross at all.
+   *
+   * Test Objectives:
+   * 1. IOC is ACKed and trades what it can up to its limit price
+   * 2. What is left unfilled is dropped, nothing rests in the book
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  placeTestAsks(matching_algo, test_passive_order_book, test_observer, DEFAULT_TEST_CLIENT_1_ID,
+                DEFAULT_TEST_CLIENT_2_ID);
+
+  const auto test_order_id = GenTestOrderID();
+  auto ioc = makeTestOrderRequest(OrderSide::BUY, test_order_id, DEFAULT_TEST_ORDER_SIZE * 3, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_3_ID, TestOrderRequestFields().timeInForce(TimeInForce::IOC));
+  matching_algo.doProcessOrderRequest(ioc, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 2);
+  BOOST_CHECK(test_observer.client_trade_events_.back().trade_price_ == DEFAULT_TEST_ORDER_PRICE);
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_3_ID, test_order_id));
+
+  auto ioc_no_cross = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                           DEFAULT_TEST_ORDER_PRICE - 1, DEFAULT_TEST_CLIENT_3_ID,
+                                           TestOrderRequestFields().timeInForce(TimeInForce::IOC));
+  matching_algo.doProcessOrderRequest(ioc_no_cross, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.size(), 2);
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+}
+
+BOOST_AUTO_TEST_CASE(FillOrKill_FillsInFullOrNotAtAll)
+{
+  /**
+   * Test Scenario:
+   * FOK buys for more than the liquidity up to their limit price, then for exactly the liquidity across two levels.
+   *
+   * Test Objectives:
+   * 1. FOK which cannot fill in full is NACKed with NOT_FILLABLE, without any trade or change to the book
+   * 2. FOK which can fill in full is ACKed and trades through as many levels as needed
+   */
+
+  PriceTimePriorityMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  placeTestAsks(matching_algo, test_passive_order_book, test_observer, DEFAULT_TEST_CLIENT_1_ID,
+                DEFAULT_TEST_CLIENT_2_ID);
+
+  auto fok_limited = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE * 2 + 1,
+                                          DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_3_ID,
+                                          TestOrderRequestFields().timeInForce(TimeInForce::FOK));
+  auto fok_too_large = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE * 4 + 1,
+                                            DEFAULT_TEST_ORDER_PRICE + 1, DEFAULT_TEST_CLIENT_3_ID,
+                                            TestOrderRequestFields().timeInForce(TimeInForce::FOK));
+  for (auto *order_request : {&fok_limited, &fok_too_large}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+
+    const auto &response = test_observer.client_order_responses_.back();
+    BOOST_CHECK(response.request_result_ == OrderRequestResult::NACK);
+    BOOST_CHECK(response.validation_response_ == ValidationResponse::NOT_FILLABLE);
+  }
+
+  BOOST_CHECK(test_observer.client_trade_events_.empty());
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_,
+                    DEFAULT_TEST_ORDER_SIZE * 2);
+
+  const auto test_order_id = GenTestOrderID();
+  auto fok = makeTestOrderRequest(OrderSide::BUY, test_order_id, DEFAULT_TEST_ORDER_SIZE * 3,
+                                  DEFAULT_TEST_ORDER_PRICE + 1, DEFAULT_TEST_CLIENT_3_ID,
+                                  TestOrderRequestFields().timeInForce(TimeInForce::FOK));
+  matching_algo.doProcessOrderRequest(fok, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 3);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.back().trade_price_, DEFAULT_TEST_ORDER_PRICE + 1);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().size(), 1);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_,
+                    DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_3_ID, test_order_id));
+}
+
+BOOST_AUTO_TEST_CASE(FillOrKill_WithMatchValidators)
+{
+  /**
+   * Test Scenario:
+   * With self match prevention, a client sends FOK buys against sells of its own resting behind other sells.
+   *
+   * Test Objectives:
+   * 1. Liquidity the FOK cannot match with is not counted, FOK reaching it is NACKed with NOT_FILLABLE and no trade
+   * 2. FOK filling before reaching it is ACKed and fills in full
+   */
+
+  PriceTimePriorityMatching<void, Validators<void, NoSelfMatchValidator<void>>> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  placeTestAsks(matching_algo, test_passive_order_book, test_observer, DEFAULT_TEST_CLIENT_2_ID,
+                DEFAULT_TEST_CLIENT_1_ID);
+
+  auto fok_self_match = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE * 2,
+                                             DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID,
+                                             TestOrderRequestFields().timeInForce(TimeInForce::FOK));
+  matching_algo.doProcessOrderRequest(fok_self_match, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().validation_response_ == ValidationResponse::NOT_FILLABLE);
+  BOOST_CHECK(test_observer.client_trade_events_.empty());
+
+  auto fok = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().timeInForce(TimeInForce::FOK));
+  matching_algo.doProcessOrderRequest(fok, test_passive_order_book, test_observer);
+
+  BOOST_CHECK(test_observer.client_order_responses_.back().request_result_ == OrderRequestResult::ACK);
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 1);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.front().client2_, DEFAULT_TEST_CLIENT_2_ID);
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.front().size_, DEFAULT_TEST_ORDER_SIZE);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
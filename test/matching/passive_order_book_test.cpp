@@ -113,6 +113,42 @@ BOOST_AUTO_TEST_CASE(RemoveClientOrderCache) {
   BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id));
 }
 
+BOOST_AUTO_TEST_CASE(PriceLevelTotalSize) {
+  PassiveOrderBook<> test_passive_order_book{};
+
+  const auto test_order_id_1 = GenTestOrderID();
+  const auto test_order_id_2 = GenTestOrderID();
+
+  for (const auto &test_order_id : {test_order_id_1, test_order_id_2}) {
+    test_passive_order_book.placePassiveOrder(DEFAULT_TEST_CLIENT_1_ID,
+                                              test_order_id,
+                                              OrderType::LIMIT,
+                                              OrderSide::BUY,
+                                              DEFAULT_TEST_ORDER_PRICE,
+                                              DEFAULT_TEST_ORDER_SIZE,
+                                              nullptr);
+  }
+
+  // Expect level total size to follow placing, filling, resizing and cancelling its orders
+  auto &level = test_passive_order_book.getBidOrderQueue().begin()->second;
+  BOOST_CHECK_EQUAL(level.total_size_, DEFAULT_TEST_ORDER_SIZE * 2);
+
+  test_passive_order_book.fillPassiveOrder(level, *level.front(), 30);
+  BOOST_CHECK_EQUAL(level.total_size_, DEFAULT_TEST_ORDER_SIZE * 2 - 30);
+  BOOST_CHECK(test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id_1));
+
+  test_passive_order_book.resizePassiveOrder(*level.back(), 50);
+  BOOST_CHECK_EQUAL(level.total_size_, DEFAULT_TEST_ORDER_SIZE - 30 + 50);
+
+  test_passive_order_book.cancelClientOrder(DEFAULT_TEST_CLIENT_1_ID, test_order_id_2);
+  BOOST_CHECK_EQUAL(level.total_size_, DEFAULT_TEST_ORDER_SIZE - 30);
+
+  // Expect an order filled in full to leave the ClientID-OrderID cache
+  test_passive_order_book.fillPassiveOrder(level, *level.front(), DEFAULT_TEST_ORDER_SIZE - 30);
+  BOOST_CHECK_EQUAL(level.total_size_, 0);
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, test_order_id_1));
+}
+
 } // end of namespace
 
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "test_helper.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "matching/pro_rata_matching.hpp"
+#include "matching/validators/matching_validators.hpp"
+#include "events/client_order_request.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(ProRataMatching_TestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(ProRata_AllocatedByOpenSize)
+{
+  /**
+   * Test Scenario:
+   * Sells of 100, 300 and 200 rest at one price, buys then take part of the level and sweep it along with a level
+   * behind it.
+   *
+   * Test Objectives:
+   * 1. Buy is allocated across the level in proportion to the open size of each sell
+   * 2. Allocations are rounded up on cumulative sizes, odd lots going to the earliest sells, and add up to the
+   *    size of the buy exactly
+   * 3. Sells filled in full leave the level, and a buy larger than the level fills every sell before the next level
+   */
+
+  ProRataMatching<> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  auto sell_1 = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 100, DEFAULT_TEST_ORDER_PRICE,
+                                     DEFAULT_TEST_CLIENT_1_ID);
+  auto sell_2 = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 300, DEFAULT_TEST_ORDER_PRICE,
+                                     DEFAULT_TEST_CLIENT_2_ID);
+  auto sell_3 = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 200, DEFAULT_TEST_ORDER_PRICE,
+                                     DEFAULT_TEST_CLIENT_3_ID);
+  auto sell_4 = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 100, DEFAULT_TEST_ORDER_PRICE + 1,
+                                     DEFAULT_TEST_CLIENT_4_ID);
+  for (auto *order_request : {&sell_1, &sell_2, &sell_3, &sell_4}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+
+  auto buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 300, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_5_ID);
+  matching_algo.doProcessOrderRequest(buy, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 3);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 150);
+  checkTradeEvent(test_observer.client_trade_events_[2], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_3_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 100);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_, 300);
+
+  // 7 of 300 shared by 50, 150 and 100 rounds to 2, 3 and 2
+  auto odd_buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 7, DEFAULT_TEST_ORDER_PRICE,
+                                      DEFAULT_TEST_CLIENT_5_ID);
+  matching_algo.doProcessOrderRequest(odd_buy, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 6);
+  checkTradeEvent(test_observer.client_trade_events_[3], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 2);
+  checkTradeEvent(test_observer.client_trade_events_[4], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 3);
+  checkTradeEvent(test_observer.client_trade_events_[5], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_3_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 2);
+  BOOST_CHECK(test_passive_order_book.getBidOrderQueue().empty());
+
+  auto sweep = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 400, DEFAULT_TEST_ORDER_PRICE + 1,
+                                    DEFAULT_TEST_CLIENT_5_ID);
+  matching_algo.doProcessOrderRequest(sweep, test_passive_order_book, test_observer);
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 10);
+  checkTradeEvent(test_observer.client_trade_events_[6], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 48);
+  checkTradeEvent(test_observer.client_trade_events_[7], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 147);
+  checkTradeEvent(test_observer.client_trade_events_[8], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_3_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 98);
+  checkTradeEvent(test_observer.client_trade_events_[9], DEFAULT_TEST_CLIENT_5_ID, DEFAULT_TEST_CLIENT_4_ID,
+                  DEFAULT_TEST_ORDER_PRICE + 1, 100);
+  BOOST_CHECK(test_passive_order_book.getAskOrderQueue().empty());
+  BOOST_CHECK(!test_passive_order_book.isOrderExist(DEFAULT_TEST_CLIENT_2_ID, sell_2.cln_order_id_));
+  // What is left of the sweep rests
+  BOOST_CHECK_EQUAL(test_passive_order_book.getBidOrderQueue().begin()->second.total_size_, 7);
+}
+
+BOOST_AUTO_TEST_CASE(ProRata_IcebergAndMatchValidators)
+{
+  /**
+   * Test Scenario:
+   * An iceberg sell and a plain sell rest at one price, then a buy trades with them. Under a no self match validator
+   * the iceberg client then buys at the same price.
+   *
+   * Test Objectives:
+   * 1. Iceberg shares by its reserve along with its shown slice, taking more than its shown slice from its reserve
+   * 2. Matching validator stopping at any order of the level stops matching before any allocation
+   */
+
+  ProRataMatching<void, Validators<void, NoSelfMatchValidator<void>>> matching_algo;
+  PassiveOrderBook<> test_passive_order_book{};
+  EngineEventTestObserver test_observer;
+
+  auto iceberg = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 300, DEFAULT_TEST_ORDER_PRICE,
+                                      DEFAULT_TEST_CLIENT_1_ID,
+                                      TestOrderRequestFields().displaySize(DEFAULT_TEST_ORDER_SIZE));
+  auto plain = makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), 100, DEFAULT_TEST_ORDER_PRICE,
+                                    DEFAULT_TEST_CLIENT_2_ID);
+  auto buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 200, DEFAULT_TEST_ORDER_PRICE,
+                                  DEFAULT_TEST_CLIENT_3_ID);
+  for (auto *order_request : {&iceberg, &plain, &buy}) {
+    matching_algo.doProcessOrderRequest(*order_request, test_passive_order_book, test_observer);
+  }
+
+  BOOST_REQUIRE_EQUAL(test_observer.client_trade_events_.size(), 2);
+  checkTradeEvent(test_observer.client_trade_events_[0], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_1_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 150);
+  checkTradeEvent(test_observer.client_trade_events_[1], DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+
+  const auto iceberg_order = test_passive_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID,
+                                                                             iceberg.cln_order_id_);
+  BOOST_REQUIRE(iceberg_order);
+  BOOST_CHECK_EQUAL(iceberg_order->remaining_size_, 50);
+  BOOST_CHECK_EQUAL(iceberg_order->reserve_size_, 100);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_, 200);
+
+  auto self_buy = makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), 100, DEFAULT_TEST_ORDER_PRICE,
+                                       DEFAULT_TEST_CLIENT_1_ID);
+  matching_algo.doProcessOrderRequest(self_buy, test_passive_order_book, test_observer);
+
+  BOOST_CHECK_EQUAL(test_observer.client_trade_events_.size(), 2);
+  BOOST_CHECK(test_observer.client_order_responses_.back().validation_response_ == ValidationResponse::SELF_MATCH);
+  BOOST_CHECK_EQUAL(test_passive_order_book.getAskOrderQueue().begin()->second.total_size_, 200);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,10 @@
 #include <mutex>
+#include <atomic>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
 
 #include "test_helper.h"
 
@@ -79,6 +85,46 @@ OrderIDType GenTestOrderID() {
   return order_id_++;
 }
 
+ClientOrderRequest<> makeTestOrderRequest(const OrderSide &side,
+                                          const OrderIDType &order_id,
+                                          const SizeType &size,
+                                          const PriceType &price,
+                                          const ClientType &client,
+                                          const TestOrderRequestFields &fields) {
+  ClientOrderRequest<> order_request{side, fields.action_, fields.order_type_, order_id, size, price, client,
+                                     DEFAULT_TEST_INSTRUMENT_1_ID};
+  order_request.time_in_force_ = fields.time_in_force_;
+  order_request.expire_time_ = fields.expire_time_;
+  order_request.trigger_price_ = fields.trigger_price_;
+  order_request.display_size_ = fields.display_size_;
+  return order_request;
+}
+
+void checkTradeEvent(const EngineTradeEventTestRecord &trade_event,
+                     const ClientType &client1,
+                     const ClientType &client2,
+                     const PriceType &trade_price,
+                     const SizeType &size) {
+  BOOST_CHECK_EQUAL(trade_event.client1_, client1);
+  BOOST_CHECK_EQUAL(trade_event.client2_, client2);
+  BOOST_CHECK_EQUAL(trade_event.instrument_, DEFAULT_TEST_INSTRUMENT_1_ID);
+  BOOST_CHECK_EQUAL(trade_event.trade_price_, trade_price);
+  BOOST_CHECK_EQUAL(trade_event.size_, size);
+}
+
+TestTemporaryDirectory::TestTemporaryDirectory() {
+  static std::atomic<std::uint64_t> directory_id_{0};
+  const auto path = std::filesystem::temp_directory_path()
+      / ("me_lib_test_" + std::to_string(::getpid()) + "_" + std::to_string(directory_id_++));
+  std::filesystem::create_directories(path);
+  path_ = path.string();
+}
+
+TestTemporaryDirectory::~TestTemporaryDirectory() {
+  std::error_code error_code;
+  std::filesystem::remove_all(path_, error_code);
+}
+
 void TestClient::onTradeEvent(
     const OrderIDType &client_order_id,
     const InstrumentType &instrument,
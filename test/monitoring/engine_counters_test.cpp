@@ -0,0 +1,125 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "test_helper.h"
+#include "engine/matching_engine.h"
+#include "monitoring/engine_counters.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+using namespace std::literals::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(EngineCountersTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(EngineCounters_PerInstrumentAndPerThread) {
+
+  /**
+   * Test Scenario:
+   * Engine with two processor threads takes a trade on one instrument, a self match and a cancel of an unknown order
+   * on another, and a repeated order id and an expiring good till time order on a third.
+   *
+   * Test Objectives:
+   * 1. Instrument counters account for requests, cancels, acks, nacks by validation response, trades and volume
+   * 2. Expiry is counted as an unsolicited cancel, not as a nack
+   * 3. Thread counters sum up to the instrument counters, busy and idle time is accounted
+   */
+
+  constexpr InstrumentType TRADE_INSTRUMENT = 0;
+  constexpr InstrumentType REJECT_INSTRUMENT = 1;
+  constexpr InstrumentType REPEAT_INSTRUMENT = 2;
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  DefaultMatchingEngine<> matching_engine{2, {TRADE_INSTRUMENT, REJECT_INSTRUMENT, REPEAT_INSTRUMENT}, observer};
+
+  matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, 1, DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, TRADE_INSTRUMENT});
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, 2, DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID, TRADE_INSTRUMENT});
+
+  matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, 3, DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, REJECT_INSTRUMENT});
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, 4, DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, REJECT_INSTRUMENT});
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::CANCEL, OrderType::LIMIT, 99, DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, REJECT_INSTRUMENT});
+
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, 5, DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_3_ID, REPEAT_INSTRUMENT});
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, 5, DEFAULT_TEST_ORDER_SIZE,
+                                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_3_ID, REPEAT_INSTRUMENT});
+  // Long expired by the system clock, taken out of the book on the next pass over the instrument
+  ClientOrderRequest<> expiring_order_request{OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, 6,
+                                              DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE + 1,
+                                              DEFAULT_TEST_CLIENT_3_ID, REPEAT_INSTRUMENT};
+  expiring_order_request.time_in_force_ = TimeInForce::GTT;
+  expiring_order_request.expire_time_ = 1;
+  matching_engine.doOrderRequest(expiring_order_request);
+
+  // 2 acks, ack and self match nack plus ack and no such order nack, ack and repeated order id nack, ack and expiry
+  constexpr std::size_t EXPECTED_RESPONSES = 10;
+  const auto start_time = std::chrono::steady_clock::now();
+  while (true) {
+    {
+      std::lock_guard<std::mutex> _{observer->order_responses_mutex_};
+      if (observer->client_order_responses_.size() >= EXPECTED_RESPONSES) break;
+    }
+    BOOST_REQUIRE(std::chrono::steady_clock::now() - start_time < 10s);
+    std::this_thread::sleep_for(1ms);
+  }
+  matching_engine.terminate();
+
+  const auto instrument_counters = matching_engine.collectInstrumentCounters();
+  BOOST_REQUIRE_EQUAL(instrument_counters.size(), 3);
+
+  const auto &trade_counters = instrument_counters.at(TRADE_INSTRUMENT);
+  BOOST_CHECK_EQUAL(trade_counters.requests_, 2);
+  BOOST_CHECK_EQUAL(trade_counters.acks_, 2);
+  BOOST_CHECK_EQUAL(trade_counters.getNacks(), 0);
+  BOOST_CHECK_EQUAL(trade_counters.trades_, 1);
+  BOOST_CHECK_EQUAL(trade_counters.traded_volume_, DEFAULT_TEST_ORDER_SIZE);
+  BOOST_CHECK(trade_counters.queue_depth_high_water_mark_ >= 1);
+
+  const auto &reject_counters = instrument_counters.at(REJECT_INSTRUMENT);
+  BOOST_CHECK_EQUAL(reject_counters.requests_, 3);
+  BOOST_CHECK_EQUAL(reject_counters.cancels_, 1);
+  BOOST_CHECK_EQUAL(reject_counters.acks_, 2);
+  BOOST_CHECK_EQUAL(reject_counters.getNacks(ValidationResponse::SELF_MATCH), 1);
+  BOOST_CHECK_EQUAL(reject_counters.getNacks(ValidationResponse::NO_SUCH_ORDER), 1);
+  BOOST_CHECK_EQUAL(reject_counters.trades_, 0);
+
+  const auto &repeat_counters = instrument_counters.at(REPEAT_INSTRUMENT);
+  BOOST_CHECK_EQUAL(repeat_counters.requests_, 3);
+  BOOST_CHECK_EQUAL(repeat_counters.acks_, 2);
+  BOOST_CHECK_EQUAL(repeat_counters.getNacks(ValidationResponse::ORDER_ID_PREEXIST), 1);
+  BOOST_CHECK_EQUAL(repeat_counters.getNacks(ValidationResponse::ORDER_EXPIRED), 0);
+  BOOST_CHECK_EQUAL(repeat_counters.unsolicited_cancels_, 1);
+
+  EngineCounters instrument_total;
+  for (const auto &[instrument, counters] : instrument_counters) {
+    instrument_total += counters;
+  }
+
+  const auto thread_counters = matching_engine.collectThreadCounters();
+  BOOST_REQUIRE_EQUAL(thread_counters.size(), 2);
+  EngineCounters thread_total;
+  for (const auto &counters : thread_counters) {
+    thread_total += counters;
+    BOOST_CHECK(counters.busy_time_.count() + counters.idle_time_.count() > 0);
+  }
+
+  BOOST_CHECK_EQUAL(thread_total.requests_, instrument_total.requests_);
+  BOOST_CHECK_EQUAL(thread_total.acks_, instrument_total.acks_);
+  BOOST_CHECK_EQUAL(thread_total.getNacks(), instrument_total.getNacks());
+  BOOST_CHECK_EQUAL(thread_total.unsolicited_cancels_, instrument_total.unsolicited_cancels_);
+  BOOST_CHECK_EQUAL(thread_total.traded_volume_, instrument_total.traded_volume_);
+  BOOST_CHECK_EQUAL(thread_total.queue_depth_high_water_mark_, instrument_total.queue_depth_high_water_mark_);
+  BOOST_CHECK(thread_total.busy_time_.count() > 0);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "test_helper.h"
+#include "engine/matching_engine.h"
+#include "monitoring/latency_histogram.h"
+#include "monitoring/latency_tracker.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+using namespace std::literals::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(LatencyTrackerTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(LatencyHistogram_PercentilesWithinPrecision) {
+
+  /**
+   * Test Scenario:
+   * Values 1 to 100000 are recorded once each, into two histograms merged afterwards.
+   *
+   * Test Objectives:
+   * 1. Small values are exact, any reported value is within relative precision above the true one
+   * 2. Merged histogram accounts for every value with count, mean and max exact
+   */
+
+  LatencyHistogram odd_histogram;
+  LatencyHistogram even_histogram;
+  for (std::uint64_t value = 1; value <= 100000; value++) {
+    (value & 1 ? odd_histogram : even_histogram).record(value);
+  }
+
+  LatencyHistogram histogram;
+  histogram.merge(odd_histogram);
+  histogram.merge(even_histogram);
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 100000);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 100000);
+  BOOST_CHECK_CLOSE(histogram.getMean(), 50000.5, 1e-9);
+  BOOST_CHECK_EQUAL(histogram.getValueAtPercentile(0.01), 10);
+  BOOST_CHECK_EQUAL(histogram.getValueAtPercentile(100), 100000);
+
+  for (const double percentile : {50.0, 90.0, 99.0, 99.9}) {
+    const auto exact = static_cast<std::uint64_t>(percentile * 1000);
+    const auto reported = histogram.getValueAtPercentile(percentile);
+    BOOST_CHECK(reported >= exact);
+    BOOST_CHECK(reported <= exact + exact / LatencyHistogram::SUB_BUCKET_COUNT);
+  }
+
+  for (const std::uint64_t value : {std::uint64_t{0}, std::uint64_t{31}, std::uint64_t{32}, std::uint64_t{1} << 40}) {
+    BOOST_CHECK(LatencyHistogram::bucketHighestValue(LatencyHistogram::bucketIndex(value)) >= value);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LatencyTracker_EngineStagesAndReport) {
+
+  /**
+   * Test Scenario:
+   * Engine with latency tracking takes crossing orders over a few instruments and processor threads.
+   *
+   * Test Objectives:
+   * 1. Every request is accounted in every stage, each request dispatches at least an event
+   * 2. Stages are consistent, queueing and processing never exceed end to end
+   * 3. Report is written on terminate
+   */
+
+  constexpr InstrumentType NUMBER_OF_INSTRUMENTS = 4;
+  constexpr OrderIDType ORDERS_PER_INSTRUMENT = 500;
+
+  TestTemporaryDirectory report_directory;
+  const auto report_path = (std::filesystem::path(report_directory.path()) / "latency.txt").string();
+
+  std::set<InstrumentType> instruments;
+  for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+    instruments.insert(inst);
+  }
+
+  MatchingEngineOptions options;
+  options.latency_tracking_.enabled_ = true;
+  options.latency_tracking_.report_path_ = report_path;
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  DefaultMatchingEngine<> matching_engine{2, instruments, observer, options};
+
+  OrderIDType order_id{0};
+  for (OrderIDType cnt = 0; cnt < ORDERS_PER_INSTRUMENT; cnt++) {
+    for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+      matching_engine.doOrderRequest({cnt & 1 ? OrderSide::BUY : OrderSide::SELL, OrderAction::NEW,
+                                      OrderType::LIMIT, order_id++, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                      cnt & 1 ? DEFAULT_TEST_CLIENT_1_ID : DEFAULT_TEST_CLIENT_2_ID, inst});
+    }
+  }
+
+  const std::size_t expected_requests = NUMBER_OF_INSTRUMENTS * ORDERS_PER_INSTRUMENT;
+  const auto start_time = std::chrono::steady_clock::now();
+  while (true) {
+    {
+      std::lock_guard<std::mutex> _{observer->order_responses_mutex_};
+      if (observer->client_order_responses_.size() >= expected_requests) break;
+    }
+    BOOST_REQUIRE(std::chrono::steady_clock::now() - start_time < 10s);
+    std::this_thread::sleep_for(1ms);
+  }
+
+  matching_engine.terminate();
+
+  std::array<std::uint64_t, static_cast<std::size_t>(LatencyStage::_STAGE_SIZE_)> max_ticks{};
+  for (std::size_t stage = 0; stage < max_ticks.size(); stage++) {
+    LatencyHistogram histogram;
+    matching_engine.collectLatencyHistogram(static_cast<LatencyStage>(stage), histogram);
+    BOOST_CHECK_EQUAL(histogram.getCount(), expected_requests);
+    max_ticks[stage] = histogram.getMax();
+  }
+  BOOST_CHECK(max_ticks[static_cast<std::size_t>(LatencyStage::QUEUEING)]
+                  <= max_ticks[static_cast<std::size_t>(LatencyStage::END_TO_END)]);
+  BOOST_CHECK(max_ticks[static_cast<std::size_t>(LatencyStage::PROCESSING)]
+                  <= max_ticks[static_cast<std::size_t>(LatencyStage::END_TO_END)]);
+  BOOST_CHECK(timestampCounterTicksPerNanosecond() > 0);
+
+  std::ifstream report{report_path};
+  BOOST_REQUIRE(report.is_open());
+  std::stringstream report_content;
+  report_content << report.rdbuf();
+  BOOST_CHECK(report_content.str().find("END_TO_END") != std::string::npos);
+  BOOST_CHECK(report_content.str().find("all") != std::string::npos);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
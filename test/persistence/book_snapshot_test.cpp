@@ -0,0 +1,220 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+#include "test_helper.h"
+#include "persistence/book_snapshot.hpp"
+#include "engine/matching_engine.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(BookSnapshotTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(BookSnapshot_RoundTrip) {
+  TestTemporaryDirectory snapshot_directory;
+  const auto snapshot_path = (std::filesystem::path(snapshot_directory.path()) / "book.snap").string();
+
+  const auto order_id_bid1 = GenTestOrderID();
+  const auto order_id_bid2 = GenTestOrderID();
+  const auto order_id_bid3 = GenTestOrderID();
+  const auto order_id_cancelled = GenTestOrderID();
+  const auto order_id_ask1 = GenTestOrderID();
+
+  PassiveOrderBook<> passive_order_book{};
+  passive_order_book.placePassiveOrder(DEFAULT_TEST_CLIENT_1_ID, order_id_bid1, OrderType::LIMIT, OrderSide::BUY,
+                                       DEFAULT_TEST_ORDER_PRICE - 1, DEFAULT_TEST_ORDER_SIZE, nullptr);
+  passive_order_book.placePassiveOrder(DEFAULT_TEST_CLIENT_2_ID, order_id_bid2, OrderType::LIMIT, OrderSide::BUY,
+                                       DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE + 1, nullptr);
+  passive_order_book.placePassiveOrder(DEFAULT_TEST_CLIENT_3_ID, order_id_cancelled, OrderType::LIMIT, OrderSide::BUY,
+                                       DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE, nullptr);
+  passive_order_book.placePassiveOrder(DEFAULT_TEST_CLIENT_3_ID, order_id_bid3, OrderType::LIMIT, OrderSide::BUY,
+                                       DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE + 2, nullptr);
+  passive_order_book.placePassiveOrder(DEFAULT_TEST_CLIENT_4_ID, order_id_ask1, OrderType::LIMIT, OrderSide::SELL,
+                                       DEFAULT_TEST_ORDER_PRICE + 1, DEFAULT_TEST_ORDER_SIZE, nullptr);
+  passive_order_book.cancelClientOrder(DEFAULT_TEST_CLIENT_3_ID, order_id_cancelled);
+
+  const JournalPosition journal_position{3, 42};
+  saveBookSnapshot(snapshot_path, passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID, journal_position);
+
+  PassiveOrderBook<> restored_order_book{};
+  const auto header = loadBookSnapshot(snapshot_path, restored_order_book);
+
+  BOOST_CHECK_EQUAL(header.instrument_, DEFAULT_TEST_INSTRUMENT_1_ID);
+  BOOST_CHECK_EQUAL(header.journal_position_.epoch_, journal_position.epoch_);
+  BOOST_CHECK_EQUAL(header.journal_position_.sequence_, journal_position.sequence_);
+  BOOST_CHECK_EQUAL(header.bid_level_count_, 2);
+  BOOST_CHECK_EQUAL(header.ask_level_count_, 1);
+  BOOST_CHECK_EQUAL(header.order_count_, 4);
+
+  // Expect levels in price order, orders in time priority and cancelled order left out
+  const auto &bid_order_queue = restored_order_book.getBidOrderQueue();
+  BOOST_REQUIRE_EQUAL(bid_order_queue.size(), 2);
+
+  const auto &[best_bid_price, best_bid_order_queue] {*bid_order_queue.begin()};
+  BOOST_CHECK_EQUAL(best_bid_price, DEFAULT_TEST_ORDER_PRICE);
+  BOOST_REQUIRE_EQUAL(best_bid_order_queue.size(), 2);
+  BOOST_CHECK_EQUAL(best_bid_order_queue[0]->cln_order_id_, order_id_bid2);
+  BOOST_CHECK_EQUAL(best_bid_order_queue[0]->client_, DEFAULT_TEST_CLIENT_2_ID);
+  BOOST_CHECK_EQUAL(best_bid_order_queue[0]->remaining_size_, DEFAULT_TEST_ORDER_SIZE + 1);
+  BOOST_CHECK_EQUAL(best_bid_order_queue[1]->cln_order_id_, order_id_bid3);
+  BOOST_CHECK_EQUAL(best_bid_order_queue[1]->remaining_size_, DEFAULT_TEST_ORDER_SIZE + 2);
+
+  const auto &[second_bid_price, second_bid_order_queue] {*std::next(bid_order_queue.begin())};
+  BOOST_CHECK_EQUAL(second_bid_price, DEFAULT_TEST_ORDER_PRICE - 1);
+  BOOST_REQUIRE_EQUAL(second_bid_order_queue.size(), 1);
+  BOOST_CHECK_EQUAL(second_bid_order_queue[0]->cln_order_id_, order_id_bid1);
+
+  const auto &ask_order_queue = restored_order_book.getAskOrderQueue();
+  BOOST_REQUIRE_EQUAL(ask_order_queue.size(), 1);
+  BOOST_CHECK_EQUAL(ask_order_queue.begin()->first, DEFAULT_TEST_ORDER_PRICE + 1);
+  BOOST_CHECK_EQUAL(ask_order_queue.begin()->second.front()->cln_order_id_, order_id_ask1);
+
+  // Expect ClientID-OrderID index rebuilt
+  BOOST_CHECK(restored_order_book.isOrderExist(DEFAULT_TEST_CLIENT_1_ID, order_id_bid1));
+  BOOST_CHECK(restored_order_book.isOrderExist(DEFAULT_TEST_CLIENT_2_ID, order_id_bid2));
+  BOOST_CHECK(restored_order_book.isOrderExist(DEFAULT_TEST_CLIENT_3_ID, order_id_bid3));
+  BOOST_CHECK(restored_order_book.isOrderExist(DEFAULT_TEST_CLIENT_4_ID, order_id_ask1));
+  BOOST_CHECK(!restored_order_book.isOrderExist(DEFAULT_TEST_CLIENT_3_ID, order_id_cancelled));
+}
+
+BOOST_AUTO_TEST_CASE(BookSnapshot_RoundTrip_CustomFields) {
+  constexpr SizeType MIN_EXEC_QTY = 80;
+
+  TestTemporaryDirectory snapshot_directory;
+  const auto snapshot_path = (std::filesystem::path(snapshot_directory.path()) / "book.snap").string();
+
+  const auto order_id = GenTestOrderID();
+
+  PassiveOrderBook<MinExecQtyExtension> passive_order_book{};
+  passive_order_book.placePassiveOrder(DEFAULT_TEST_CLIENT_1_ID, order_id, OrderType::LIMIT, OrderSide::SELL,
+                                       DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE,
+                                       std::make_shared<MinExecQtyExtension>(MIN_EXEC_QTY));
+  saveBookSnapshot(snapshot_path, passive_order_book, DEFAULT_TEST_INSTRUMENT_1_ID);
+
+  PassiveOrderBook<MinExecQtyExtension> restored_order_book{};
+  loadBookSnapshot(snapshot_path, restored_order_book);
+
+  const auto restored_order = restored_order_book.getEngineOrderFromCache(DEFAULT_TEST_CLIENT_1_ID, order_id);
+  BOOST_REQUIRE(restored_order);
+  BOOST_REQUIRE(restored_order->custom_fields_);
+  BOOST_CHECK_EQUAL(restored_order->custom_fields_->min_exec_qty_, MIN_EXEC_QTY);
+
+  // Expect snapshot of another order extension or version rejected
+  PassiveOrderBook<> mismatched_order_book{};
+  BOOST_CHECK_THROW(loadBookSnapshot(snapshot_path, mismatched_order_book), std::runtime_error);
+
+  std::invoke([&] {
+    std::fstream snapshot_file{snapshot_path, std::ios::in | std::ios::out | std::ios::binary};
+    snapshot_file.seekp(static_cast<std::streamoff>(offsetof(BookSnapshotHeader, version_)));
+    const std::uint32_t unknown_version{BOOK_SNAPSHOT_VERSION + 1};
+    snapshot_file.write(reinterpret_cast<const char *>(&unknown_version), sizeof(unknown_version));
+  });
+  PassiveOrderBook<MinExecQtyExtension> outdated_order_book{};
+  BOOST_CHECK_THROW(loadBookSnapshot(snapshot_path, outdated_order_book), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(MatchingEngine_WarmStart_SnapshotAndJournalTail) {
+
+  /**
+   * Run 1 rests a sell order partially filled, is terminated and snapshot.
+   * Run 2 starts from the snapshot and rests another sell order, only journaled.
+   * Run 3 starts from the snapshot plus journal tail, and a buy order sweeps both sell orders.
+   * Journal requests already reflected in the snapshot must not be applied twice (which would fill run 1 sell again).
+   */
+
+  using OrderExt = void;
+  constexpr std::uint8_t NUMBER_OF_THREADS = 2;
+  constexpr InstrumentType NUMBER_OF_INSTRUMENTS = 3;
+  constexpr InstrumentType INSTRUMENT_ID = 1;
+  constexpr unsigned MAXIMUM_WAITING_TIME_MILLISECOND = 1000;
+  constexpr SizeType FIRST_FILL_SIZE = 40;
+  constexpr SizeType SECOND_SELL_SIZE = 50;
+
+  TestTemporaryDirectory journal_directory;
+  TestTemporaryDirectory snapshot_directory;
+
+  std::set<InstrumentType> instruments;
+  for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+    instruments.insert(inst);
+  }
+
+  auto wait_until = [&](const std::function<bool()> &predicate) {
+    const auto start_time = std::chrono::steady_clock::now();
+    while (!predicate()) {
+      if (std::chrono::steady_clock::now() - start_time > std::chrono::milliseconds(MAXIMUM_WAITING_TIME_MILLISECOND)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto order_response_count = [](EngineEventTestObserver &observer) {
+    std::lock_guard<std::mutex> _{observer.order_responses_mutex_};
+    return observer.client_order_responses_.size();
+  };
+
+  MatchingEngineOptions options;
+  options.journal_.directory_ = journal_directory.path();
+  options.journal_.replay_on_start_ = true;
+
+  std::invoke([&] {
+    auto observer = std::make_shared<EngineEventTestObserver>();
+    DefaultMatchingEngine<OrderExt> matching_engine{NUMBER_OF_THREADS, instruments, observer, options};
+
+    matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, 1, DEFAULT_TEST_ORDER_SIZE,
+                                    DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, INSTRUMENT_ID});
+    matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, 2, FIRST_FILL_SIZE,
+                                    DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID, INSTRUMENT_ID});
+    BOOST_CHECK(wait_until([&] { return order_response_count(*observer) == 2; }));
+
+    matching_engine.terminate();
+    matching_engine.saveSnapshot(snapshot_directory.path());
+  });
+
+  // Only instruments with orders get a meaningful snapshot, but every instrument is written
+  BOOST_CHECK(std::filesystem::exists(
+      std::filesystem::path(snapshot_directory.path()) / bookSnapshotFileName(INSTRUMENT_ID)));
+
+  options.snapshot_directory_ = snapshot_directory.path();
+
+  std::invoke([&] {
+    auto observer = std::make_shared<EngineEventTestObserver>();
+    DefaultMatchingEngine<OrderExt> matching_engine{NUMBER_OF_THREADS, instruments, observer, options};
+
+    matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, 3, SECOND_SELL_SIZE,
+                                    DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_3_ID, INSTRUMENT_ID});
+    BOOST_CHECK(wait_until([&] { return order_response_count(*observer) == 1; }));
+
+    matching_engine.terminate();
+  });
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  DefaultMatchingEngine<OrderExt> matching_engine{NUMBER_OF_THREADS, instruments, observer, options};
+
+  matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::MARKET, 4, DEFAULT_TEST_ORDER_SIZE * 2,
+                                  DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_4_ID, INSTRUMENT_ID});
+  BOOST_CHECK(wait_until([&] {
+    std::lock_guard<std::mutex> _{observer->trade_event_mutex_};
+    return observer->client_trade_events_.size() == 2;
+  }));
+
+  matching_engine.terminate();
+
+  BOOST_REQUIRE_EQUAL(observer->client_trade_events_.size(), 2);
+  const auto &first_trade = observer->client_trade_events_[0];
+  BOOST_CHECK_EQUAL(first_trade.client2_, DEFAULT_TEST_CLIENT_1_ID);
+  BOOST_CHECK_EQUAL(first_trade.size_, DEFAULT_TEST_ORDER_SIZE - FIRST_FILL_SIZE);
+  const auto &second_trade = observer->client_trade_events_[1];
+  BOOST_CHECK_EQUAL(second_trade.client2_, DEFAULT_TEST_CLIENT_3_ID);
+  BOOST_CHECK_EQUAL(second_trade.size_, SECOND_SELL_SIZE);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,338 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#include "test_helper.h"
+#include "persistence/request_journal.hpp"
+#include "persistence/book_snapshot.hpp"
+#include "engine/matching_engine.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(RequestJournalTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(Journal_RoundTrip_AcrossSegments) {
+  constexpr std::size_t NUMBER_OF_REQUESTS = 10;
+  constexpr std::size_t RECORDS_PER_SEGMENT = 3;
+  constexpr std::uint64_t REQUEST_TIME = 1000;
+
+  TestTemporaryDirectory journal_directory;
+
+  JournalOptions options;
+  options.directory_ = journal_directory.path();
+  options.flush_policy_ = JournalFlushPolicy::PER_BATCH;
+  options.segment_size_ = sizeof(JournalSegmentHeader) + RECORDS_PER_SEGMENT * JOURNAL_RECORD_SIZE<void>;
+
+  std::vector<ClientOrderRequest<>> order_requests;
+  for (std::size_t cnt = 0; cnt < NUMBER_OF_REQUESTS; cnt++) {
+    order_requests.emplace_back(
+        (cnt & 1) ? OrderSide::SELL : OrderSide::BUY,
+        (cnt % 3 == 2) ? OrderAction::CANCEL : OrderAction::NEW,
+        (cnt % 4 == 3) ? OrderType::MARKET : OrderType::LIMIT,
+        GenTestOrderID(),
+        DEFAULT_TEST_ORDER_SIZE + cnt,
+        DEFAULT_TEST_ORDER_PRICE + cnt,
+        DEFAULT_TEST_CLIENT_1_ID + cnt,
+        DEFAULT_TEST_INSTRUMENT_1_ID);
+  }
+
+  std::invoke([&] {
+    RequestJournalWriter<> writer{options, 1, 0};
+    for (std::size_t cnt = 0; cnt < NUMBER_OF_REQUESTS; cnt++) {
+      writer.append(order_requests[cnt], REQUEST_TIME + cnt);
+      writer.commitBatch();
+    }
+    BOOST_CHECK_EQUAL(writer.getPosition().epoch_, 1);
+    BOOST_CHECK_EQUAL(writer.getPosition().sequence_, NUMBER_OF_REQUESTS);
+  });
+
+  // Expect segments rolled over once full
+  BOOST_CHECK_EQUAL(listJournalSegments(journal_directory.path()).size(), 4);
+  BOOST_CHECK_EQUAL(nextJournalEpoch(journal_directory.path()), 2);
+
+  std::vector<ClientOrderRequest<>> replayed_requests;
+  std::vector<std::uint64_t> replayed_sequences;
+  std::vector<std::uint64_t> replayed_times;
+  const auto count = replayJournal<>(journal_directory.path(),
+                                     [&](const JournalPosition &position,
+                                         ClientOrderRequest<> &order_request,
+                                         const std::uint64_t &request_time) {
+                                       replayed_sequences.push_back(position.sequence_);
+                                       replayed_requests.push_back(order_request);
+                                       replayed_times.push_back(request_time);
+                                     });
+
+  BOOST_CHECK_EQUAL(count, NUMBER_OF_REQUESTS);
+  BOOST_REQUIRE_EQUAL(replayed_requests.size(), NUMBER_OF_REQUESTS);
+
+  for (std::size_t cnt = 0; cnt < NUMBER_OF_REQUESTS; cnt++) {
+    const auto &expected = order_requests[cnt];
+    const auto &replayed = replayed_requests[cnt];
+    BOOST_CHECK_EQUAL(replayed_sequences[cnt], cnt);
+    BOOST_CHECK_EQUAL(replayed_times[cnt], REQUEST_TIME + cnt);
+    BOOST_CHECK(replayed.side_ == expected.side_);
+    BOOST_CHECK(replayed.order_action_ == expected.order_action_);
+    BOOST_CHECK(replayed.order_type_ == expected.order_type_);
+    BOOST_CHECK_EQUAL(replayed.cln_order_id_, expected.cln_order_id_);
+    BOOST_CHECK_EQUAL(replayed.size_, expected.size_);
+    BOOST_CHECK_EQUAL(replayed.price_, expected.price_);
+    BOOST_CHECK_EQUAL(replayed.client_, expected.client_);
+    BOOST_CHECK_EQUAL(replayed.instrument_, expected.instrument_);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Journal_RoundTrip_CustomFields) {
+  constexpr SizeType MIN_EXEC_QTY = 80;
+
+  TestTemporaryDirectory journal_directory;
+
+  JournalOptions options;
+  options.directory_ = journal_directory.path();
+
+  std::invoke([&] {
+    RequestJournalWriter<MinExecQtyExtension> writer{options, 1, 0};
+    writer.append({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID,
+                   std::make_shared<MinExecQtyExtension>(MIN_EXEC_QTY)}, 0);
+    writer.append({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                   DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID}, 0);
+    writer.commitBatch();
+  });
+
+  std::vector<std::shared_ptr<MinExecQtyExtension>> custom_fields;
+  replayJournal<MinExecQtyExtension>(
+      journal_directory.path(),
+      [&](const JournalPosition &, ClientOrderRequest<MinExecQtyExtension> &order_request) {
+        custom_fields.push_back(order_request.custom_fields_);
+      });
+
+  BOOST_REQUIRE_EQUAL(custom_fields.size(), 2);
+  BOOST_REQUIRE(custom_fields[0]);
+  BOOST_CHECK_EQUAL(custom_fields[0]->min_exec_qty_, MIN_EXEC_QTY);
+  BOOST_CHECK(!custom_fields[1]);
+
+  // Journal written for one order extension cannot be read as another
+  BOOST_CHECK_THROW(RequestJournalReader<>(listJournalSegments(journal_directory.path()).front().path_),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(Journal_TornRecord_Ignored) {
+  TestTemporaryDirectory journal_directory;
+
+  JournalOptions options;
+  options.directory_ = journal_directory.path();
+
+  std::invoke([&] {
+    RequestJournalWriter<> writer{options, 1, 0};
+    for (int cnt = 0; cnt < 3; cnt++) {
+      writer.append({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                     DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID}, 0);
+    }
+  });
+
+  // Simulate a crash half way writing the second record by wiping its marker
+  const auto segment_path = listJournalSegments(journal_directory.path()).front().path_;
+  std::invoke([&] {
+    std::fstream segment_file{segment_path, std::ios::in | std::ios::out | std::ios::binary};
+    segment_file.seekp(static_cast<std::streamoff>(sizeof(JournalSegmentHeader) + JOURNAL_RECORD_SIZE<void>));
+    const std::uint32_t torn_marker{0};
+    segment_file.write(reinterpret_cast<const char *>(&torn_marker), sizeof(torn_marker));
+  });
+
+  const auto count = replayJournal<>(journal_directory.path(), [](const JournalPosition &, ClientOrderRequest<> &) {});
+  BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Journal_FsyncInterval_FlushesWhenDue) {
+  // Last batch is flushed by flushIfDue on its own once the interval is due, without another batch committing
+  TestTemporaryDirectory journal_directory;
+
+  JournalOptions options;
+  options.directory_ = journal_directory.path();
+  options.flush_policy_ = JournalFlushPolicy::FSYNC_INTERVAL;
+  options.fsync_interval_ = std::chrono::milliseconds(100);
+
+  RequestJournalWriter<> writer{options, 1, 0};
+  writer.append({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                 DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID}, 0);
+  writer.commitBatch();
+  writer.flushIfDue();
+  BOOST_CHECK(writer.hasUnflushedWrites());
+
+  std::this_thread::sleep_for(options.fsync_interval_ * 2);
+  writer.flushIfDue();
+  BOOST_CHECK(!writer.hasUnflushedWrites());
+
+  // Nothing appended since, nothing to flush
+  std::this_thread::sleep_for(options.fsync_interval_ * 2);
+  writer.flushIfDue();
+  BOOST_CHECK(!writer.hasUnflushedWrites());
+}
+
+BOOST_AUTO_TEST_CASE(MatchingEngine_ReplayJournal_RestoresOrderBooks) {
+  using OrderExt = void;
+  constexpr std::uint8_t NUMBER_OF_THREADS = 2;
+  constexpr InstrumentType NUMBER_OF_INSTRUMENTS = 4;
+  constexpr unsigned MAXIMUM_WAITING_TIME_MILLISECOND = 1000;
+
+  TestTemporaryDirectory journal_directory;
+
+  std::set<InstrumentType> instruments;
+  for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+    instruments.insert(inst);
+  }
+
+  MatchingEngineOptions options;
+  options.journal_.directory_ = journal_directory.path();
+  options.journal_.flush_policy_ = JournalFlushPolicy::PER_BATCH;
+
+  auto wait_until = [&](const std::function<bool()> &predicate) {
+    const auto start_time = std::chrono::steady_clock::now();
+    while (!predicate()) {
+      if (std::chrono::steady_clock::now() - start_time > std::chrono::milliseconds(MAXIMUM_WAITING_TIME_MILLISECOND)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // First run rests one sell order per instrument, and cancels the one on instrument 0
+  std::invoke([&] {
+    auto observer = std::make_shared<EngineEventTestObserver>();
+    DefaultMatchingEngine<OrderExt> matching_engine{NUMBER_OF_THREADS, instruments, observer, options};
+
+    for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+      matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, inst,
+                                      DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID,
+                                      inst});
+    }
+    matching_engine.doOrderRequest({OrderSide::SELL, OrderAction::CANCEL, OrderType::LIMIT, 0,
+                                    DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, 0});
+
+    BOOST_CHECK(wait_until([&] {
+      std::lock_guard<std::mutex> _{observer->order_responses_mutex_};
+      return observer->client_order_responses_.size() == NUMBER_OF_INSTRUMENTS + 1;
+    }));
+
+    matching_engine.terminate();
+  });
+
+  // Second run is rebuilt from journal, buy orders cross with the restored sell orders
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  options.journal_.replay_on_start_ = true;
+  DefaultMatchingEngine<OrderExt> matching_engine{NUMBER_OF_THREADS, instruments, observer, options};
+
+  // Replay is silent towards clients
+  BOOST_CHECK(observer->client_order_responses_.empty());
+
+  for (InstrumentType inst = 0; inst < NUMBER_OF_INSTRUMENTS; inst++) {
+    matching_engine.doOrderRequest({OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, NUMBER_OF_INSTRUMENTS + inst,
+                                    DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID,
+                                    inst});
+  }
+
+  BOOST_CHECK(wait_until([&] {
+    std::lock_guard<std::mutex> _{observer->trade_event_mutex_};
+    return observer->client_trade_events_.size() == NUMBER_OF_INSTRUMENTS - 1;
+  }));
+
+  matching_engine.terminate();
+
+  for (const auto &trade : observer->client_trade_events_) {
+    BOOST_CHECK_NE(trade.instrument_, 0);
+    BOOST_CHECK_EQUAL(trade.client1_, DEFAULT_TEST_CLIENT_2_ID);
+    BOOST_CHECK_EQUAL(trade.client2_, DEFAULT_TEST_CLIENT_1_ID);
+    BOOST_CHECK_EQUAL(trade.client2_order_id_, trade.instrument_);
+    BOOST_CHECK_EQUAL(trade.size_, DEFAULT_TEST_ORDER_SIZE);
+  }
+
+  // Second run journals into its own epoch
+  BOOST_CHECK_EQUAL(nextJournalEpoch(journal_directory.path()), 3);
+}
+
+BOOST_AUTO_TEST_CASE(MatchingEngine_ReplayJournal_ExpiresAsLive) {
+
+  /**
+   * Run 1 rests a good till time sell, waits for it to expire, then rests a buy crossing its price.
+   * Run 2 is rebuilt from the journal alone. The sell must be expired before the buy is replayed, as it was live,
+   * so both runs end with the buy resting and without a trade.
+   */
+
+  using OrderExt = void;
+  constexpr unsigned MAXIMUM_WAITING_TIME_MILLISECOND = 1000;
+  constexpr auto EXPIRY_DELAY = std::chrono::milliseconds(20);
+
+  TestTemporaryDirectory journal_directory;
+  TestTemporaryDirectory live_snapshot_directory;
+  TestTemporaryDirectory replayed_snapshot_directory;
+
+  MatchingEngineOptions options;
+  options.journal_.directory_ = journal_directory.path();
+  options.journal_.flush_policy_ = JournalFlushPolicy::PER_BATCH;
+
+  auto wait_until = [&](const std::function<bool()> &predicate) {
+    const auto start_time = std::chrono::steady_clock::now();
+    while (!predicate()) {
+      if (std::chrono::steady_clock::now() - start_time > std::chrono::milliseconds(MAXIMUM_WAITING_TIME_MILLISECOND)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  std::invoke([&] {
+    auto observer = std::make_shared<EngineEventTestObserver>();
+    DefaultMatchingEngine<OrderExt> matching_engine{1, {DEFAULT_TEST_INSTRUMENT_1_ID}, observer, options};
+    auto order_response_count = [&] {
+      std::lock_guard<std::mutex> _{observer->order_responses_mutex_};
+      return observer->client_order_responses_.size();
+    };
+
+    const auto expire_time = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        (std::chrono::system_clock::now() + EXPIRY_DELAY).time_since_epoch()).count());
+    matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::SELL, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                                        DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID,
+                                                        TestOrderRequestFields().expireTime(expire_time)));
+    BOOST_REQUIRE(wait_until([&] { return order_response_count() == 2; }));
+    BOOST_CHECK(observer->client_order_responses_.back().validation_response_ == ValidationResponse::ORDER_EXPIRED);
+
+    matching_engine.doOrderRequest(makeTestOrderRequest(OrderSide::BUY, GenTestOrderID(), DEFAULT_TEST_ORDER_SIZE,
+                                                        DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID));
+    BOOST_REQUIRE(wait_until([&] { return order_response_count() == 3; }));
+
+    matching_engine.terminate();
+    BOOST_CHECK(observer->client_trade_events_.empty());
+    matching_engine.saveSnapshot(live_snapshot_directory.path());
+  });
+
+  options.journal_.replay_on_start_ = true;
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  DefaultMatchingEngine<OrderExt> matching_engine{1, {DEFAULT_TEST_INSTRUMENT_1_ID}, observer, options};
+  matching_engine.terminate();
+  matching_engine.saveSnapshot(replayed_snapshot_directory.path());
+
+  PassiveOrderBook<> live_order_book{};
+  PassiveOrderBook<> replayed_order_book{};
+  const auto snapshot_file_name = bookSnapshotFileName(DEFAULT_TEST_INSTRUMENT_1_ID);
+  loadBookSnapshot((std::filesystem::path(live_snapshot_directory.path()) / snapshot_file_name).string(),
+                   live_order_book);
+  loadBookSnapshot((std::filesystem::path(replayed_snapshot_directory.path()) / snapshot_file_name).string(),
+                   replayed_order_book);
+
+  for (const auto *passive_order_book : {&live_order_book, &replayed_order_book}) {
+    BOOST_CHECK(passive_order_book->getAskOrderQueue().empty());
+    BOOST_REQUIRE_EQUAL(passive_order_book->getBidOrderQueue().size(), 1);
+    BOOST_CHECK_EQUAL(passive_order_book->getBidOrderQueue().begin()->second.total_size_, DEFAULT_TEST_ORDER_SIZE);
+    BOOST_CHECK_EQUAL(passive_order_book->getLastTradePrice(), 0);
+  }
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
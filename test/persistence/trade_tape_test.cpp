@@ -0,0 +1,200 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+#include "test_helper.h"
+#include "persistence/trade_tape.h"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(TradeTapeTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(TradeTape_RoundTripAcrossShardsAndSegments) {
+
+  /**
+   * Test Scenario:
+   * Trades of several instruments are written onto a tape with small segments over two shards.
+   *
+   * Test Objectives:
+   * 1. Every trade is read back from the columns of its shard in arrival order
+   * 2. Full segments are sealed as they fill up, the rest when tape is closed
+   * 3. Segment min/max index reflects the rows of the segment
+   */
+
+  constexpr std::size_t ROWS_PER_SEGMENT = 4;
+  constexpr std::size_t NUMBER_OF_TRADES = 21;
+
+  TestTemporaryDirectory tape_directory;
+
+  std::uint64_t clock{1000};
+  TradeTapeOptions options;
+  options.directory_ = tape_directory.path();
+  options.rows_per_segment_ = ROWS_PER_SEGMENT;
+  options.number_of_shards_ = 2;
+  options.clock_ = [&clock] { return clock++; };
+
+  {
+    TradeTapeWriter trade_tape_writer{options};
+    for (std::size_t cnt = 0; cnt < NUMBER_OF_TRADES; cnt++) {
+      trade_tape_writer.doTradeEvent(DEFAULT_TEST_CLIENT_1_ID, cnt, DEFAULT_TEST_CLIENT_2_ID, cnt + 100,
+                                     cnt % 3, DEFAULT_TEST_ORDER_PRICE + cnt, DEFAULT_TEST_ORDER_SIZE);
+    }
+    trade_tape_writer.close();
+  }
+
+  // Instruments 0 and 2 on shard 0 (14 trades), instrument 1 on shard 1 (7 trades)
+  TradeTapeReader trade_tape_reader{tape_directory.path()};
+  const auto &segments = trade_tape_reader.getSegments();
+  BOOST_REQUIRE_EQUAL(segments.size(), 4 + 2);
+
+  std::vector<std::uint64_t> shard0_rows;
+  std::vector<std::uint64_t> shard1_rows;
+  for (const auto &segment : segments) {
+    BOOST_CHECK(segment.row_count_ > 0 && segment.row_count_ <= ROWS_PER_SEGMENT);
+
+    const auto order_ids = trade_tape_reader.mapColumn(segment, TradeTapeColumn::AGGRESSOR_ORDER_ID);
+    const auto passive_order_ids = trade_tape_reader.mapColumn(segment, TradeTapeColumn::PASSIVE_ORDER_ID);
+    const auto prices = trade_tape_reader.mapColumn(segment, TradeTapeColumn::PRICE);
+    const auto instruments = trade_tape_reader.mapColumn(segment, TradeTapeColumn::INSTRUMENT);
+    BOOST_REQUIRE_EQUAL(order_ids.size(), segment.row_count_);
+
+    for (std::size_t row = 0; row < order_ids.size(); row++) {
+      BOOST_CHECK_EQUAL(passive_order_ids[row], order_ids[row] + 100);
+      BOOST_CHECK_EQUAL(prices[row], DEFAULT_TEST_ORDER_PRICE + order_ids[row]);
+      BOOST_CHECK_EQUAL(instruments[row] % 2, segment.shard_);
+    }
+    auto &shard_rows = segment.shard_ == 0 ? shard0_rows : shard1_rows;
+    shard_rows.insert(shard_rows.end(), order_ids.begin(), order_ids.end());
+
+    const auto minmax_price = std::minmax_element(prices.begin(), prices.end());
+    BOOST_CHECK_EQUAL(segment.min_[static_cast<std::size_t>(TradeTapeColumn::PRICE)], *minmax_price.first);
+    BOOST_CHECK_EQUAL(segment.max_[static_cast<std::size_t>(TradeTapeColumn::PRICE)], *minmax_price.second);
+  }
+
+  std::vector<std::uint64_t> expected_shard0_rows;
+  std::vector<std::uint64_t> expected_shard1_rows;
+  for (std::size_t cnt = 0; cnt < NUMBER_OF_TRADES; cnt++) {
+    (cnt % 3 == 1 ? expected_shard1_rows : expected_shard0_rows).push_back(cnt);
+  }
+  BOOST_CHECK(shard0_rows == expected_shard0_rows);
+  BOOST_CHECK(shard1_rows == expected_shard1_rows);
+}
+
+BOOST_AUTO_TEST_CASE(TradeTape_SegmentPruning) {
+  TestTemporaryDirectory tape_directory;
+
+  std::uint64_t clock{0};
+  TradeTapeOptions options;
+  options.directory_ = tape_directory.path();
+  options.rows_per_segment_ = 10;
+  options.number_of_shards_ = 1;
+  options.clock_ = [&clock] { return clock += 10; };
+
+  {
+    TradeTapeWriter trade_tape_writer{options};
+    for (std::size_t cnt = 0; cnt < 50; cnt++) {
+      trade_tape_writer.doTradeEvent(DEFAULT_TEST_CLIENT_1_ID, cnt, DEFAULT_TEST_CLIENT_2_ID, cnt,
+                                     DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_ORDER_PRICE, cnt + 1);
+    }
+    // Segments are sealed on destruction
+  }
+
+  TradeTapeReader trade_tape_reader{tape_directory.path()};
+  BOOST_REQUIRE_EQUAL(trade_tape_reader.getSegments().size(), 5);
+
+  // Timestamps 10..500, a window of [195, 305] touches only the 2nd and 3rd segments
+  std::vector<std::uint64_t> selected_segments;
+  SizeType traded_size{0};
+  for (const auto &segment : trade_tape_reader.getSegments()) {
+    if (!segment.mayContain(TradeTapeColumn::TIMESTAMP, 195, 305)) continue;
+    selected_segments.push_back(segment.segment_);
+
+    const auto timestamps = trade_tape_reader.mapColumn(segment, TradeTapeColumn::TIMESTAMP);
+    const auto sizes = trade_tape_reader.mapColumn(segment, TradeTapeColumn::SIZE);
+    for (std::size_t row = 0; row < timestamps.size(); row++) {
+      if (timestamps[row] >= 195 && timestamps[row] <= 305) traded_size += sizes[row];
+    }
+  }
+
+  BOOST_CHECK(selected_segments == std::vector<std::uint64_t>({1, 2}));
+  // Rows 19..29 carry sizes 20..30
+  BOOST_CHECK_EQUAL(traded_size, (20 + 30) * 11 / 2);
+  BOOST_CHECK(!trade_tape_reader.getSegments().front().mayContain(TradeTapeColumn::PRICE,
+                                                                  DEFAULT_TEST_ORDER_PRICE + 1,
+                                                                  DEFAULT_TEST_ORDER_PRICE + 10));
+}
+
+BOOST_AUTO_TEST_CASE(TradeTape_RestartAppends) {
+
+  /**
+   * Test Scenario:
+   * A tape is written and closed, then a second writer is started on the same directory and writes more trades.
+   *
+   * Test Objectives:
+   * 1. Segments of the first writer are kept as they were, none is truncated or written over
+   * 2. Second writer carries on after the last sealed segment of each shard
+   */
+
+  constexpr std::size_t ROWS_PER_SEGMENT = 4;
+
+  TestTemporaryDirectory tape_directory;
+
+  TradeTapeOptions options;
+  options.directory_ = tape_directory.path();
+  options.rows_per_segment_ = ROWS_PER_SEGMENT;
+  options.number_of_shards_ = 2;
+
+  const auto write_trades = [&](const std::size_t &first_order_id, const std::size_t &number_of_trades) {
+    TradeTapeWriter trade_tape_writer{options};
+    for (std::size_t order_id = first_order_id; order_id < first_order_id + number_of_trades; order_id++) {
+      trade_tape_writer.doTradeEvent(DEFAULT_TEST_CLIENT_1_ID, order_id, DEFAULT_TEST_CLIENT_2_ID, order_id,
+                                     DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+    }
+  };
+
+  // 6 trades seal a full segment and a partial one, the next run adds 4 more
+  write_trades(0, 6);
+  write_trades(6, 4);
+
+  TradeTapeReader trade_tape_reader{tape_directory.path()};
+  const auto &segments = trade_tape_reader.getSegments();
+  BOOST_REQUIRE_EQUAL(segments.size(), 3);
+
+  std::vector<std::uint64_t> segment_numbers;
+  std::vector<std::uint64_t> order_ids;
+  for (const auto &segment : segments) {
+    BOOST_CHECK_EQUAL(segment.shard_, DEFAULT_TEST_INSTRUMENT_1_ID % 2);
+    segment_numbers.push_back(segment.segment_);
+    const auto column = trade_tape_reader.mapColumn(segment, TradeTapeColumn::AGGRESSOR_ORDER_ID);
+    order_ids.insert(order_ids.end(), column.begin(), column.end());
+  }
+
+  BOOST_CHECK(segment_numbers == std::vector<std::uint64_t>({0, 1, 2}));
+  BOOST_CHECK(order_ids == std::vector<std::uint64_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+BOOST_AUTO_TEST_CASE(TradeTape_ForwardsToDownstreamObserver) {
+  TestTemporaryDirectory tape_directory;
+
+  TradeTapeOptions options;
+  options.directory_ = tape_directory.path();
+
+  auto downstream_observer = std::make_shared<EngineEventTestObserver>();
+  TradeTapeWriter trade_tape_writer{options, downstream_observer};
+
+  trade_tape_writer.doTradeEvent(DEFAULT_TEST_CLIENT_1_ID, 1, DEFAULT_TEST_CLIENT_2_ID, 2,
+                                 DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE);
+  trade_tape_writer.doOrderRequestResponse(DEFAULT_TEST_CLIENT_1_ID, 1, DEFAULT_TEST_INSTRUMENT_1_ID,
+                                           DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_ORDER_SIZE,
+                                           OrderRequestResult::ACK, ValidationResponse::NO_ERROR);
+
+  BOOST_CHECK_EQUAL(downstream_observer->client_trade_events_.size(), 1);
+  BOOST_CHECK_EQUAL(downstream_observer->client_order_responses_.size(), 1);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
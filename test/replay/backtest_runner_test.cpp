@@ -0,0 +1,212 @@
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+#include "test_helper.h"
+#include "matching/validators/matching_validators.hpp"
+#include "replay/backtest_runner.h"
+#include "replay/order_flow_replay.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(BacktestRunnerTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+constexpr InstrumentType NUMBER_OF_INSTRUMENTS = 7;
+constexpr ClientType NUMBER_OF_CLIENTS = 3;
+
+// Crossing flow over a few clients so self match prevention makes a difference
+void writeTestOrderFlow(const std::string &path, const std::size_t &number_of_records) {
+  OrderFlowFileWriter writer{path};
+  for (std::size_t cnt = 0; cnt < number_of_records; cnt++) {
+    OrderFlowRecord record;
+    record.timestamp_ = cnt;
+    // Skewed towards low instruments
+    record.instrument_ = (cnt * cnt) % NUMBER_OF_INSTRUMENTS;
+    record.client_ = cnt % NUMBER_OF_CLIENTS;
+    record.cln_order_id_ = cnt;
+    record.side_ = static_cast<std::uint8_t>((cnt / 3) % 2 == 0 ? OrderSide::BUY : OrderSide::SELL);
+    record.order_action_ = static_cast<std::uint8_t>(OrderAction::NEW);
+    record.order_type_ = static_cast<std::uint8_t>(OrderType::LIMIT);
+    record.price_ = DEFAULT_TEST_ORDER_PRICE + cnt % 5;
+    record.size_ = 1 + cnt % 7;
+    writer.append(record);
+  }
+}
+
+struct TradeCountingObserver : EngineEventTestObserver {
+  void doTradeEvent(const ClientType &, const OrderIDType &, const ClientType &, const OrderIDType &,
+                    const InstrumentType &instrument, const PriceType &, const SizeType &) override {
+    std::lock_guard<std::mutex> _{trade_event_mutex_};
+    instruments_.insert(instrument);
+    trades_++;
+  }
+
+  std::set<InstrumentType> instruments_{};
+  std::uint64_t trades_{};
+};
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(BacktestRunner_ScenariosInParallel) {
+
+  /**
+   * Test Scenario:
+   * Two scenarios, with and without self match prevention, run over the same order flow.
+   *
+   * Test Objectives:
+   * 1. Scenario without validators trades exactly as a plain replay of the flow
+   * 2. Self match prevention changes the outcome of its scenario only
+   * 3. Results do not depend on the number of worker threads
+   * 4. Per instrument results add up to the scenario total
+   */
+
+  constexpr std::size_t NUMBER_OF_RECORDS = 5000;
+
+  TestTemporaryDirectory backtest_directory;
+  const auto order_flow_path = (std::filesystem::path(backtest_directory.path()) / "flow.bin").string();
+  writeTestOrderFlow(order_flow_path, NUMBER_OF_RECORDS);
+  OrderFlowFileReader reader{order_flow_path};
+
+  using SelfMatchPreventionMatching = PriceTimePriorityMatching<void, Validators<void, NoSelfMatchValidator<void>>>;
+
+  auto trade_counting_observer = std::make_shared<TradeCountingObserver>();
+  const std::vector<BacktestScenario> scenarios{
+      {"plain",
+       [] { return std::make_unique<PriceTimePriorityMatching<>>(); },
+       [&](const InstrumentType &) { return trade_counting_observer; }},
+      {"no self match",
+       [] { return std::make_unique<SelfMatchPreventionMatching>(); },
+       nullptr}
+  };
+
+  const auto results = BacktestRunner{reader, 3}.run(scenarios);
+  BOOST_REQUIRE_EQUAL(results.size(), 2);
+  BOOST_CHECK_EQUAL(results[0].name_, "plain");
+  BOOST_CHECK_EQUAL(results[1].name_, "no self match");
+
+  TradeCountingObserver replay_observer;
+  OrderFlowReplayDriver<> replay_driver{replay_observer};
+  replay_driver.replay(reader);
+
+  const auto &plain = results[0].total_;
+  BOOST_CHECK_EQUAL(plain.messages_, NUMBER_OF_RECORDS);
+  BOOST_CHECK(plain.trades_ > 0);
+  BOOST_CHECK_EQUAL(plain.trades_, replay_observer.trades_);
+  BOOST_CHECK_EQUAL(plain.nacks_, 0);
+  BOOST_CHECK_EQUAL(plain.acks_, NUMBER_OF_RECORDS);
+  BOOST_CHECK_EQUAL(trade_counting_observer->trades_, plain.trades_);
+  BOOST_CHECK(trade_counting_observer->instruments_ == replay_observer.instruments_);
+
+  const auto &no_self_match = results[1].total_;
+  BOOST_CHECK_EQUAL(no_self_match.messages_, NUMBER_OF_RECORDS);
+  BOOST_CHECK(no_self_match.nacks_ > 0);
+  BOOST_CHECK(no_self_match.trades_ != plain.trades_);
+
+  for (const auto &scenario_result : results) {
+    BacktestResult instrument_total;
+    for (const auto &[instrument, instrument_result] : scenario_result.instruments_) {
+      instrument_total += instrument_result;
+    }
+    BOOST_CHECK_EQUAL(scenario_result.instruments_.size(), replay_driver.getPassiveOrderBooks().size());
+    BOOST_CHECK_EQUAL(instrument_total.messages_, scenario_result.total_.messages_);
+    BOOST_CHECK_EQUAL(instrument_total.traded_notional_, scenario_result.total_.traded_notional_);
+  }
+
+  const auto single_thread_results = BacktestRunner{reader, 1}.run({scenarios[1]});
+  BOOST_REQUIRE_EQUAL(single_thread_results.size(), 1);
+  BOOST_CHECK_EQUAL(single_thread_results[0].total_.trades_, no_self_match.trades_);
+  BOOST_CHECK_EQUAL(single_thread_results[0].total_.traded_size_, no_self_match.traded_size_);
+  BOOST_CHECK_EQUAL(single_thread_results[0].total_.nacks_, no_self_match.nacks_);
+}
+
+BOOST_AUTO_TEST_CASE(BacktestRunner_GoodTillTimeExpiry) {
+
+  /**
+   * Test Scenario:
+   * Good till time buy is partly filled, then a crossing sell comes in the flow after the buy expired.
+   *
+   * Test Objectives:
+   * 1. Flow time stamps expire the buy before the later sell, which rests rather than trades
+   * 2. Expiry is reported to the scenario observer, as in a plain replay of the flow
+   */
+
+  TestTemporaryDirectory backtest_directory;
+  const auto order_flow_path = (std::filesystem::path(backtest_directory.path()) / "flow.bin").string();
+  {
+    OrderFlowFileWriter writer{order_flow_path};
+    const std::tuple<std::uint64_t, OrderSide, SizeType, ClientType> flow[]{
+        {0, OrderSide::BUY, 100, DEFAULT_TEST_CLIENT_1_ID},
+        {50, OrderSide::SELL, 40, DEFAULT_TEST_CLIENT_2_ID},
+        {200, OrderSide::SELL, 100, DEFAULT_TEST_CLIENT_2_ID}};
+    for (const auto &[timestamp, side, size, client] : flow) {
+      OrderFlowRecord record;
+      record.timestamp_ = timestamp;
+      record.instrument_ = DEFAULT_TEST_INSTRUMENT_1_ID;
+      record.client_ = client;
+      record.cln_order_id_ = GenTestOrderID();
+      record.side_ = static_cast<std::uint8_t>(side);
+      record.order_action_ = static_cast<std::uint8_t>(OrderAction::NEW);
+      record.order_type_ = static_cast<std::uint8_t>(OrderType::LIMIT);
+      record.price_ = DEFAULT_TEST_ORDER_PRICE;
+      record.size_ = size;
+      if (side == OrderSide::BUY) {
+        record.time_in_force_ = static_cast<std::uint8_t>(TimeInForce::GTT);
+        record.expire_time_ = 100;
+      }
+      writer.append(record);
+    }
+  }
+  OrderFlowFileReader reader{order_flow_path};
+
+  auto test_observer = std::make_shared<EngineEventTestObserver>();
+  const auto results = BacktestRunner{reader, 1}.run(
+      {{"expiry",
+        [] { return std::make_unique<PriceTimePriorityMatching<>>(); },
+        [&](const InstrumentType &) { return test_observer; }}});
+  BOOST_REQUIRE_EQUAL(results.size(), 1);
+  BOOST_CHECK_EQUAL(results[0].total_.trades_, 1);
+  BOOST_CHECK_EQUAL(results[0].total_.traded_size_, 40);
+  BOOST_CHECK_EQUAL(results[0].total_.acks_, 3);
+  BOOST_CHECK_EQUAL(results[0].total_.nacks_, 0);
+  BOOST_CHECK_EQUAL(results[0].total_.unsolicited_cancels_, 1);
+
+  BOOST_REQUIRE_EQUAL(test_observer->client_order_responses_.size(), 4);
+  const auto &expiry_response = test_observer->client_order_responses_[2];
+  BOOST_CHECK_EQUAL(expiry_response.client_, DEFAULT_TEST_CLIENT_1_ID);
+  BOOST_CHECK_EQUAL(expiry_response.size_, 60);
+  BOOST_CHECK(expiry_response.request_result_ == OrderRequestResult::CANCELLED);
+  BOOST_CHECK(expiry_response.validation_response_ == ValidationResponse::ORDER_EXPIRED);
+
+  EngineEventTestObserver replay_observer;
+  OrderFlowReplayDriver<> replay_driver{replay_observer};
+  replay_driver.replay(reader);
+  BOOST_CHECK(replay_observer.client_order_responses_ == test_observer->client_order_responses_);
+}
+
+BOOST_AUTO_TEST_CASE(BacktestRunner_Failures) {
+  TestTemporaryDirectory backtest_directory;
+  const auto order_flow_path = (std::filesystem::path(backtest_directory.path()) / "flow.bin").string();
+  writeTestOrderFlow(order_flow_path, 100);
+  OrderFlowFileReader reader{order_flow_path};
+
+  BacktestRunner backtest_runner{reader, 2};
+  BOOST_CHECK_THROW(backtest_runner.run({{"no algo", nullptr, nullptr}}), std::invalid_argument);
+  BOOST_CHECK_THROW(backtest_runner.run({{"failing",
+                                          []() -> std::unique_ptr<IMatchingAlgo<>> {
+                                            throw std::runtime_error("scenario setup failure");
+                                          },
+                                          nullptr}}),
+                    std::runtime_error);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
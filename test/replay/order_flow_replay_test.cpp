@@ -0,0 +1,198 @@
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include "test_helper.h"
+#include "replay/order_flow_file.h"
+#include "replay/order_flow_replay.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(OrderFlowReplayTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(OrderFlow_CsvImportAndReplay) {
+
+  /**
+   * Test Scenario:
+   * A small order flow over two instruments is imported from CSV and replayed.
+   *
+   * Test Objectives:
+   * 1. Every CSV line becomes a record in the order flow file, header line skipped
+   * 2. Replay produces the same trades as feeding the matching algo directly
+   * 3. Statistics account for every message and instrument
+   */
+
+  TestTemporaryDirectory replay_directory;
+  const auto csv_path = (std::filesystem::path(replay_directory.path()) / "flow.csv").string();
+  const auto order_flow_path = (std::filesystem::path(replay_directory.path()) / "flow.bin").string();
+
+  {
+    std::ofstream csv_file{csv_path};
+    csv_file << "timestamp,instrument,client,order_id,side,action,type,price,size\n"
+             << "1000,1,11,1,SELL,NEW,LIMIT,101,100\n"
+             << "1001,1,11,2,SELL,NEW,LIMIT,102,100\n"
+             << "1002,2,12,3,BUY,NEW,LIMIT,50,30\r\n"
+             << "1003,1,13,4,BUY,NEW,LIMIT,102,150\n"
+             << "\n"
+             << "1004,2,14,5,SELL,NEW,MARKET,0,10\n"
+             << "1005,1,11,2,SELL,CANCEL,LIMIT,102,100\n";
+  }
+
+  BOOST_CHECK_EQUAL(importOrderFlowCsv(csv_path, order_flow_path), 6);
+
+  OrderFlowFileReader reader{order_flow_path};
+  BOOST_REQUIRE_EQUAL(reader.size(), 6);
+  BOOST_CHECK_EQUAL(reader.getHeader().first_timestamp_, 1000);
+  BOOST_CHECK_EQUAL(reader.getHeader().last_timestamp_, 1005);
+  BOOST_CHECK_EQUAL(reader.data()[2].price_, 50);
+  BOOST_CHECK_EQUAL(reader.data()[2].size_, 30);
+  BOOST_CHECK(static_cast<OrderType>(reader.data()[4].order_type_) == OrderType::MARKET);
+  BOOST_CHECK(static_cast<OrderAction>(reader.data()[5].order_action_) == OrderAction::CANCEL);
+
+  EngineEventTestObserver replay_observer;
+  OrderFlowReplayDriver<> replay_driver{replay_observer};
+  const auto statistics = replay_driver.replay(reader);
+
+  BOOST_CHECK_EQUAL(statistics.messages_, 6);
+  BOOST_CHECK_EQUAL(statistics.instruments_, 2);
+
+  EngineEventTestObserver direct_observer;
+  PriceTimePriorityMatching<> matching_algo;
+  std::unordered_map<InstrumentType, PassiveOrderBook<>> passive_order_books;
+  for (const auto &record : reader) {
+    auto order_request = toClientOrderRequest(record);
+    matching_algo.doProcessOrderRequest(order_request, passive_order_books[record.instrument_], direct_observer);
+  }
+
+  BOOST_REQUIRE_EQUAL(replay_observer.client_trade_events_.size(), 3);
+  BOOST_REQUIRE_EQUAL(replay_observer.client_trade_events_.size(), direct_observer.client_trade_events_.size());
+  for (std::size_t index = 0; index < replay_observer.client_trade_events_.size(); index++) {
+    const auto &replayed = replay_observer.client_trade_events_[index];
+    const auto &direct = direct_observer.client_trade_events_[index];
+    BOOST_CHECK_EQUAL(replayed.client1_order_id_, direct.client1_order_id_);
+    BOOST_CHECK_EQUAL(replayed.client2_order_id_, direct.client2_order_id_);
+    BOOST_CHECK_EQUAL(replayed.trade_price_, direct.trade_price_);
+    BOOST_CHECK_EQUAL(replayed.size_, direct.size_);
+  }
+  BOOST_CHECK_EQUAL(replay_observer.client_order_responses_.size(), direct_observer.client_order_responses_.size());
+
+  // Cancelled remainder leaves instrument 1 with nothing resting, instrument 2 keeps what is left of the bid
+  const auto &passive_order_books_replayed = replay_driver.getPassiveOrderBooks();
+  BOOST_CHECK_EQUAL(passive_order_books_replayed.at(1).getAskOrderQueue().begin()->second.front()->remaining_size_, 0);
+  BOOST_CHECK_EQUAL(passive_order_books_replayed.at(2).getBidOrderQueue().begin()->second.front()->remaining_size_, 20);
+}
+
+BOOST_AUTO_TEST_CASE(OrderFlow_StopAndIcebergFields) {
+
+  /**
+   * Test Scenario:
+   * An iceberg sell and a waiting stop limit buy are imported from CSV with trigger price and display size columns,
+   * next to a plain line without them, then replayed.
+   *
+   * Test Objectives:
+   * 1. Trigger price and display size are carried from CSV through the order flow file into requests
+   * 2. Replay triggers the stop limit and trades the iceberg slice after slice
+   */
+
+  TestTemporaryDirectory replay_directory;
+  const auto csv_path = (std::filesystem::path(replay_directory.path()) / "flow.csv").string();
+  const auto order_flow_path = (std::filesystem::path(replay_directory.path()) / "flow.bin").string();
+
+  {
+    std::ofstream csv_file{csv_path};
+    csv_file << "timestamp,instrument,client,order_id,side,action,type,price,size,trigger_price,display_size\n"
+             << "1000,1,11,1,SELL,NEW,LIMIT,100,300,0,100\n"
+             << "1001,1,12,2,BUY,NEW,STOP_LIMIT,101,50,100,0\n"
+             << "1002,1,13,3,BUY,NEW,LIMIT,100,80\n";
+  }
+
+  BOOST_CHECK_EQUAL(importOrderFlowCsv(csv_path, order_flow_path), 3);
+
+  OrderFlowFileReader reader{order_flow_path};
+  BOOST_REQUIRE_EQUAL(reader.size(), 3);
+  BOOST_CHECK_EQUAL(reader.data()[0].display_size_, 100);
+  BOOST_CHECK(static_cast<OrderType>(reader.data()[1].order_type_) == OrderType::STOP_LIMIT);
+  BOOST_CHECK_EQUAL(reader.data()[1].trigger_price_, 100);
+  BOOST_CHECK_EQUAL(reader.data()[2].trigger_price_, 0);
+
+  const auto stop_limit = toClientOrderRequest(reader.data()[1]);
+  BOOST_CHECK_EQUAL(stop_limit.trigger_price_, 100);
+  BOOST_CHECK_EQUAL(toClientOrderRequest(reader.data()[0]).display_size_, 100);
+
+  EngineEventTestObserver replay_observer;
+  OrderFlowReplayDriver<> replay_driver{replay_observer};
+  replay_driver.replay(reader);
+
+  // Buy takes 80 of the shown 100 and triggers the stop limit, which takes the other 20 then 30 of the next slice
+  BOOST_REQUIRE_EQUAL(replay_observer.client_trade_events_.size(), 3);
+  BOOST_CHECK_EQUAL(replay_observer.client_trade_events_[0].size_, 80);
+  BOOST_CHECK_EQUAL(replay_observer.client_trade_events_[1].client1_order_id_, 2);
+  BOOST_CHECK_EQUAL(replay_observer.client_trade_events_[1].size_, 20);
+  BOOST_CHECK_EQUAL(replay_observer.client_trade_events_[2].size_, 30);
+
+  const auto &iceberg_order = replay_driver.getPassiveOrderBooks().at(1).getAskOrderQueue().begin()->second.front();
+  BOOST_CHECK_EQUAL(iceberg_order->cln_order_id_, 1);
+  BOOST_CHECK_EQUAL(iceberg_order->remaining_size_, 70);
+  BOOST_CHECK_EQUAL(iceberg_order->reserve_size_, 100);
+}
+
+BOOST_AUTO_TEST_CASE(OrderFlow_InvalidInput) {
+  TestTemporaryDirectory replay_directory;
+  const auto csv_path = (std::filesystem::path(replay_directory.path()) / "flow.csv").string();
+  const auto order_flow_path = (std::filesystem::path(replay_directory.path()) / "flow.bin").string();
+
+  {
+    std::ofstream csv_file{csv_path};
+    csv_file << "1000,1,11,1,SELL,NEW,LIMIT,101,100\n"
+             << "1001,1,11,2,SIDEWAYS,NEW,LIMIT,102,100\n";
+  }
+  BOOST_CHECK_THROW(importOrderFlowCsv(csv_path, order_flow_path), std::invalid_argument);
+
+  {
+    std::ofstream csv_file{csv_path};
+    csv_file << "1000,1,11,1,SELL,NEW,LIMIT,101\n";
+  }
+  BOOST_CHECK_THROW(importOrderFlowCsv(csv_path, order_flow_path), std::invalid_argument);
+
+  // Trigger price without display size
+  {
+    std::ofstream csv_file{csv_path};
+    csv_file << "1000,1,11,1,BUY,NEW,STOP,0,100,101\n";
+  }
+  BOOST_CHECK_THROW(importOrderFlowCsv(csv_path, order_flow_path), std::invalid_argument);
+
+  // Back in time
+  {
+    std::ofstream csv_file{csv_path};
+    csv_file << "1000,1,11,1,SELL,NEW,LIMIT,101,100\n"
+             << "999,1,11,2,SELL,NEW,LIMIT,101,100\n";
+  }
+  BOOST_CHECK_THROW(importOrderFlowCsv(csv_path, order_flow_path), std::invalid_argument);
+
+  {
+    std::ofstream not_order_flow_file{order_flow_path, std::ios::trunc};
+    not_order_flow_file << std::string(128, 'x');
+  }
+  BOOST_CHECK_THROW(OrderFlowFileReader{order_flow_path}, std::runtime_error);
+
+  // Corrupt or foreign record, an action no matching algo handles
+  {
+    OrderFlowFileWriter writer{order_flow_path};
+    OrderFlowRecord record;
+    record.timestamp_ = 1000;
+    writer.append(record);
+    record.order_action_ = static_cast<std::uint8_t>(OrderAction::SNAPSHOT_BARRIER);
+    writer.append(record);
+  }
+  BOOST_CHECK_EXCEPTION(OrderFlowFileReader{order_flow_path}, std::runtime_error, [](const std::runtime_error &e) {
+    return std::string(e.what()).find("record 1") != std::string::npos;
+  });
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
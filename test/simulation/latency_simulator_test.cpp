@@ -0,0 +1,176 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "test_helper.h"
+#include "simulation/latency_simulator.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(LatencySimulatorTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+using Simulator = LatencySimulator<>;
+
+// Records what reached the client and at which simulation time
+struct TimedTestClient : IClient {
+  TimedTestClient(const ClientType &client_id, const Simulator &simulator)
+      : IClient(client_id), simulator_(simulator) {}
+
+  void onTradeEvent(const OrderIDType &client_order_id, const InstrumentType &, const PriceType &,
+                    const SizeType &size) override {
+    trades_.push_back({simulator_.getCurrentTime(), client_order_id, size});
+  }
+
+  void onOrderRequestResponse(const OrderIDType &client_order_id, const InstrumentType &, const PriceType &,
+                              const SizeType &size, const OrderRequestResult &,
+                              const ValidationResponse &) override {
+    responses_.push_back({simulator_.getCurrentTime(), client_order_id, size});
+  }
+
+  struct Notification {
+    std::uint64_t time_{};
+    OrderIDType cln_order_id_{};
+    SizeType size_{};
+  };
+
+  const Simulator &simulator_;
+  std::vector<Notification> trades_{};
+  std::vector<Notification> responses_{};
+};
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(LatencySimulator_SlowClientLosesTheRace) {
+
+  /**
+   * Test Scenario:
+   * Slow client sends a sell before a fast client sends a crossing buy.
+   *
+   * Test Objectives:
+   * 1. Requests reach the book in arrival rather than send order, fast buy rests first and slow sell takes it
+   * 2. Each client is notified after its own response latency
+   */
+
+  LatencyModel latency_model;
+  latency_model.client_profiles_[DEFAULT_TEST_CLIENT_1_ID] = {constantLatency(100), constantLatency(100)};
+  latency_model.client_profiles_[DEFAULT_TEST_CLIENT_2_ID] = {constantLatency(1000), constantLatency(1000)};
+
+  Simulator simulator{{DEFAULT_TEST_INSTRUMENT_1_ID}, latency_model};
+  auto fast_client = std::make_shared<TimedTestClient>(DEFAULT_TEST_CLIENT_1_ID, simulator);
+  auto slow_client = std::make_shared<TimedTestClient>(DEFAULT_TEST_CLIENT_2_ID, simulator);
+  simulator.setClientMap({{DEFAULT_TEST_CLIENT_1_ID, fast_client}, {DEFAULT_TEST_CLIENT_2_ID, slow_client}});
+
+  simulator.submit(0, {OrderSide::SELL, OrderAction::NEW, OrderType::LIMIT, 1, DEFAULT_TEST_ORDER_SIZE,
+                       DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+  simulator.submit(500, {OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, 2, DEFAULT_TEST_ORDER_SIZE,
+                         DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+  BOOST_CHECK_EQUAL(simulator.getPendingEvents(), 2);
+
+  // Buy arrives at 600 and rests, nothing reached any client yet
+  simulator.advanceTo(699);
+  BOOST_CHECK_EQUAL(simulator.getPassiveOrderBook(DEFAULT_TEST_INSTRUMENT_1_ID)->getBidOrderQueue().size(), 1);
+  BOOST_CHECK(fast_client->responses_.empty());
+
+  simulator.drain();
+  BOOST_CHECK_EQUAL(simulator.getPendingEvents(), 0);
+
+  BOOST_REQUIRE_EQUAL(fast_client->responses_.size(), 1);
+  BOOST_CHECK_EQUAL(fast_client->responses_.front().time_, 700);
+  BOOST_REQUIRE_EQUAL(slow_client->responses_.size(), 1);
+  BOOST_CHECK_EQUAL(slow_client->responses_.front().time_, 2000);
+
+  // Sell arrives at 1000, fast client learns of the fill at 1100 while slow client does at 2000
+  BOOST_REQUIRE_EQUAL(fast_client->trades_.size(), 1);
+  BOOST_CHECK_EQUAL(fast_client->trades_.front().time_, 1100);
+  BOOST_CHECK_EQUAL(fast_client->trades_.front().cln_order_id_, 2);
+  BOOST_REQUIRE_EQUAL(slow_client->trades_.size(), 1);
+  BOOST_CHECK_EQUAL(slow_client->trades_.front().time_, 2000);
+  BOOST_CHECK_EQUAL(slow_client->trades_.front().cln_order_id_, 1);
+
+  BOOST_CHECK_THROW(simulator.submit(0, {}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(LatencySimulator_GoodTillTimeExpiresOnSimulationTime) {
+
+  /**
+   * Test Scenario:
+   * Good till time buy rests, then a crossing sell arrives after the buy expired.
+   *
+   * Test Objectives:
+   * 1. Buy is taken out of the book once simulation time passes its expire time, before the sell is processed
+   * 2. Client is notified of the expiry after its response latency
+   */
+
+  LatencyModel latency_model;
+  latency_model.default_profile_ = {constantLatency(100), constantLatency(100)};
+
+  Simulator simulator{{DEFAULT_TEST_INSTRUMENT_1_ID}, latency_model};
+  auto buy_client = std::make_shared<TimedTestClient>(DEFAULT_TEST_CLIENT_1_ID, simulator);
+  auto sell_client = std::make_shared<TimedTestClient>(DEFAULT_TEST_CLIENT_2_ID, simulator);
+  simulator.setClientMap({{DEFAULT_TEST_CLIENT_1_ID, buy_client}, {DEFAULT_TEST_CLIENT_2_ID, sell_client}});
+
+  simulator.submit(0, makeTestOrderRequest(OrderSide::BUY, 1, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                           DEFAULT_TEST_CLIENT_1_ID, TestOrderRequestFields().expireTime(1000)));
+  simulator.submit(1500, makeTestOrderRequest(OrderSide::SELL, 2, DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE,
+                                              DEFAULT_TEST_CLIENT_2_ID));
+  simulator.drain();
+
+  BOOST_CHECK(buy_client->trades_.empty());
+  BOOST_CHECK(sell_client->trades_.empty());
+  BOOST_CHECK(simulator.getPassiveOrderBook(DEFAULT_TEST_INSTRUMENT_1_ID)->getBidOrderQueue().empty());
+  BOOST_CHECK_EQUAL(simulator.getPassiveOrderBook(DEFAULT_TEST_INSTRUMENT_1_ID)->getAskOrderQueue().size(), 1);
+
+  // Buy arrives at 100 and expires as the sell arrives at 1600
+  BOOST_REQUIRE_EQUAL(buy_client->responses_.size(), 2);
+  BOOST_CHECK_EQUAL(buy_client->responses_[0].time_, 200);
+  BOOST_CHECK_EQUAL(buy_client->responses_[1].time_, 1700);
+  BOOST_CHECK_EQUAL(buy_client->responses_[1].cln_order_id_, 1);
+  BOOST_CHECK_EQUAL(buy_client->responses_[1].size_, DEFAULT_TEST_ORDER_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(LatencySimulator_RandomLatencyKeepsClientOrderAndIsReproducible) {
+  constexpr OrderIDType NUMBER_OF_ORDERS = 2000;
+
+  LatencyModel latency_model;
+  latency_model.default_profile_ = {uniformLatency(10, 5000), logNormalLatency(200, 1.0)};
+  latency_model.seed_ = 7;
+
+  auto run = [&] {
+    Simulator simulator{{DEFAULT_TEST_INSTRUMENT_1_ID}, latency_model};
+    auto client = std::make_shared<TimedTestClient>(DEFAULT_TEST_CLIENT_1_ID, simulator);
+    simulator.setClientMap({{DEFAULT_TEST_CLIENT_1_ID, client}});
+
+    for (OrderIDType order_id = 0; order_id < NUMBER_OF_ORDERS; order_id++) {
+      simulator.submit(order_id * 10, {OrderSide::BUY, OrderAction::NEW, OrderType::LIMIT, order_id,
+                                       DEFAULT_TEST_ORDER_SIZE, DEFAULT_TEST_ORDER_PRICE - order_id % 10,
+                                       DEFAULT_TEST_CLIENT_1_ID, DEFAULT_TEST_INSTRUMENT_1_ID});
+      // Interleave time advancing with submitting
+      if (order_id % 100 == 99) simulator.advanceTo(order_id * 10);
+    }
+    simulator.drain();
+    return client->responses_;
+  };
+
+  const auto responses = run();
+  BOOST_REQUIRE_EQUAL(responses.size(), NUMBER_OF_ORDERS);
+  for (OrderIDType order_id = 0; order_id < NUMBER_OF_ORDERS; order_id++) {
+    BOOST_CHECK_EQUAL(responses[order_id].cln_order_id_, order_id);
+    if (order_id > 0) BOOST_CHECK(responses[order_id].time_ >= responses[order_id - 1].time_);
+    BOOST_CHECK(responses[order_id].time_ >= order_id * 10 + 10);
+  }
+
+  const auto repeated_responses = run();
+  BOOST_REQUIRE_EQUAL(repeated_responses.size(), responses.size());
+  for (std::size_t index = 0; index < responses.size(); index++) {
+    BOOST_CHECK_EQUAL(repeated_responses[index].time_, responses[index].time_);
+  }
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
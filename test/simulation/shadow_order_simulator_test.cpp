@@ -0,0 +1,241 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <tuple>
+#include <vector>
+
+#include "test_helper.h"
+#include "replay/order_flow_file.h"
+#include "simulation/shadow_order_simulator.hpp"
+
+using namespace codetest::matching_engine_sim;
+using namespace codetest::matching_engine_sim_test_helper;
+
+BOOST_AUTO_TEST_SUITE(ShadowOrderSimulatorTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+namespace {
+
+using ShadowFill = std::tuple<OrderIDType, PriceType, SizeType>;
+
+ClientOrderRequest<> historicalRequest(const OrderSide &side, const OrderAction &order_action,
+                                       const OrderIDType &order_id, const SizeType &size, const PriceType &price,
+                                       const ClientType &client) {
+  return {side, order_action, OrderType::LIMIT, order_id, size, price, client, DEFAULT_TEST_INSTRUMENT_1_ID};
+}
+
+OrderFlowRecord historicalRecord(const std::uint64_t &timestamp, const InstrumentType &instrument,
+                                 const ClientType &client, const OrderIDType &order_id, const OrderSide &side,
+                                 const PriceType &price, const SizeType &size) {
+  OrderFlowRecord record;
+  record.timestamp_ = timestamp;
+  record.instrument_ = instrument;
+  record.client_ = client;
+  record.cln_order_id_ = order_id;
+  record.side_ = static_cast<std::uint8_t>(side);
+  record.order_action_ = static_cast<std::uint8_t>(OrderAction::NEW);
+  record.order_type_ = static_cast<std::uint8_t>(OrderType::LIMIT);
+  record.price_ = price;
+  record.size_ = size;
+  return record;
+}
+
+} // end of anonymous local namespace
+
+BOOST_AUTO_TEST_CASE(ShadowOrder_QueuePositionAndFills) {
+
+  /**
+   * Test Scenario:
+   * Shadow sells rest among historical sells, historical buys then trade through the level.
+   *
+   * Test Objectives:
+   * 1. Shadow order joins the back of its level, cancels ahead of it move it up, orders arriving later do not
+   * 2. Only volume trading beyond what is ahead fills it, a better priced shadow order fills on any trade
+   * 3. Historical book is never affected, a crossing shadow order fills against it without taking liquidity
+   */
+
+  std::vector<ShadowFill> fills;
+  ShadowOrderSimulator<> simulator{[&](const ShadowOrder &order, const PriceType &price, const SizeType &size) {
+    fills.emplace_back(order.order_id_, price, size);
+  }};
+
+  simulator.processHistoricalOrderRequest(
+      historicalRequest(OrderSide::SELL, OrderAction::NEW, 1, 100, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_1_ID));
+  simulator.processHistoricalOrderRequest(
+      historicalRequest(OrderSide::SELL, OrderAction::NEW, 2, 50, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_2_ID));
+
+  simulator.placeShadowOrder(1001, OrderSide::SELL, DEFAULT_TEST_ORDER_PRICE, 30);
+  simulator.placeShadowOrder(1002, OrderSide::SELL, DEFAULT_TEST_ORDER_PRICE - 1, 5);
+  simulator.placeShadowOrder(1003, OrderSide::SELL, DEFAULT_TEST_ORDER_PRICE + 2, 10);
+  BOOST_REQUIRE(simulator.getShadowOrder(1001) != nullptr);
+  BOOST_CHECK_EQUAL(simulator.getShadowOrder(1001)->volume_ahead_, 150);
+  BOOST_CHECK_EQUAL(simulator.getShadowOrder(1002)->volume_ahead_, 0);
+  BOOST_CHECK_THROW(simulator.placeShadowOrder(1001, OrderSide::BUY, DEFAULT_TEST_ORDER_PRICE, 1),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(simulator.placeShadowOrder(1004, OrderSide::BUY, DEFAULT_TEST_ORDER_PRICE, 0),
+                    std::invalid_argument);
+
+  // Arriving behind the shadow order, cancel ahead of it
+  simulator.processHistoricalOrderRequest(
+      historicalRequest(OrderSide::SELL, OrderAction::NEW, 3, 40, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_3_ID));
+  simulator.processHistoricalOrderRequest(
+      historicalRequest(OrderSide::SELL, OrderAction::CANCEL, 2, 50, DEFAULT_TEST_ORDER_PRICE,
+                        DEFAULT_TEST_CLIENT_2_ID));
+  BOOST_CHECK_EQUAL(simulator.getShadowOrder(1001)->volume_ahead_, 100);
+
+  // Trades 100 then 10, only the 10 beyond the volume ahead fills the shadow order at the level
+  simulator.processHistoricalOrderRequest(
+      historicalRequest(OrderSide::BUY, OrderAction::NEW, 4, 110, DEFAULT_TEST_ORDER_PRICE, DEFAULT_TEST_CLIENT_4_ID));
+  BOOST_CHECK_EQUAL(simulator.getShadowOrder(1001)->volume_ahead_, 0);
+  BOOST_CHECK_EQUAL(simulator.getShadowOrder(1001)->remaining_size_, 20);
+  BOOST_CHECK(simulator.getShadowOrder(1002) == nullptr);
+
+  // Takes the rest of historical order 3 and rests 20 at 101
+  simulator.processHistoricalOrderRequest(
+      historicalRequest(OrderSide::BUY, OrderAction::NEW, 5, 50, DEFAULT_TEST_ORDER_PRICE + 1,
+                        DEFAULT_TEST_CLIENT_4_ID));
+  BOOST_CHECK(simulator.getShadowOrder(1001) == nullptr);
+  BOOST_CHECK(simulator.getShadowOrder(1003) != nullptr);
+
+  // Crossing shadow sell fills against the historical bid, which stays in the book, and rests the remainder
+  simulator.placeShadowOrder(1005, OrderSide::SELL, DEFAULT_TEST_ORDER_PRICE, 30);
+  BOOST_REQUIRE(simulator.getShadowOrder(1005) != nullptr);
+  BOOST_CHECK_EQUAL(simulator.getShadowOrder(1005)->remaining_size_, 10);
+  const auto &bid_queue = simulator.getPassiveOrderBook().getBidOrderQueue();
+  BOOST_REQUIRE_EQUAL(bid_queue.size(), 1);
+  BOOST_CHECK_EQUAL(bid_queue.begin()->second.front()->remaining_size_, 20);
+
+  const std::vector<ShadowFill> expected{
+      {1002, DEFAULT_TEST_ORDER_PRICE - 1, 5},
+      {1001, DEFAULT_TEST_ORDER_PRICE, 10},
+      {1001, DEFAULT_TEST_ORDER_PRICE, 20},
+      {1005, DEFAULT_TEST_ORDER_PRICE + 1, 20}};
+  BOOST_CHECK(fills == expected);
+
+  BOOST_CHECK(simulator.cancelShadowOrder(1003));
+  BOOST_CHECK(!simulator.cancelShadowOrder(1003));
+  BOOST_CHECK(simulator.getShadowOrder(1003) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ShadowOrder_ReplayHistoricalFlow) {
+
+  /**
+   * Test Scenario:
+   * Shadow buy is placed while replaying the flow of one instrument out of an order flow file of two.
+   *
+   * Test Objectives:
+   * 1. Only records of the instrument are processed, historical trades are forwarded downstream
+   * 2. Shadow order placed from the record callback is filled once historical volume trades beyond it
+   */
+
+  TestTemporaryDirectory replay_directory;
+  const auto order_flow_path = (std::filesystem::path(replay_directory.path()) / "flow.bin").string();
+
+  constexpr InstrumentType OTHER_INSTRUMENT_ID = DEFAULT_TEST_INSTRUMENT_1_ID + 1;
+  {
+    OrderFlowFileWriter writer{order_flow_path};
+    writer.append(historicalRecord(1, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_CLIENT_1_ID, 1, OrderSide::BUY,
+                                   DEFAULT_TEST_ORDER_PRICE, 100));
+    writer.append(historicalRecord(2, OTHER_INSTRUMENT_ID, DEFAULT_TEST_CLIENT_1_ID, 2, OrderSide::BUY,
+                                   DEFAULT_TEST_ORDER_PRICE, 100));
+    writer.append(historicalRecord(3, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_CLIENT_2_ID, 3, OrderSide::BUY,
+                                   DEFAULT_TEST_ORDER_PRICE, 100));
+    writer.append(historicalRecord(4, OTHER_INSTRUMENT_ID, DEFAULT_TEST_CLIENT_3_ID, 4, OrderSide::SELL,
+                                   DEFAULT_TEST_ORDER_PRICE, 100));
+    writer.append(historicalRecord(5, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_CLIENT_3_ID, 5, OrderSide::SELL,
+                                   DEFAULT_TEST_ORDER_PRICE, 180));
+    writer.close();
+  }
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  std::vector<ShadowFill> fills;
+  ShadowOrderSimulator<> simulator{[&](const ShadowOrder &order, const PriceType &price, const SizeType &size) {
+    fills.emplace_back(order.order_id_, price, size);
+  }, observer};
+
+  OrderFlowFileReader reader{order_flow_path};
+  const auto processed = simulator.replay(reader, DEFAULT_TEST_INSTRUMENT_1_ID, [&](const OrderFlowRecord &record) {
+    BOOST_CHECK_EQUAL(record.instrument_, DEFAULT_TEST_INSTRUMENT_1_ID);
+    // Behind order 1, ahead of order 3
+    if (record.cln_order_id_ == 1) simulator.placeShadowOrder(1001, OrderSide::BUY, DEFAULT_TEST_ORDER_PRICE, 50);
+  });
+
+  BOOST_CHECK_EQUAL(processed, 3);
+  BOOST_CHECK_EQUAL(observer->client_trade_events_.size(), 2);
+
+  const std::vector<ShadowFill> expected{{1001, DEFAULT_TEST_ORDER_PRICE, 50}};
+  BOOST_CHECK(fills == expected);
+  BOOST_CHECK(simulator.getShadowOrder(1001) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ShadowOrder_ReplayExpiresHistoricalOrders) {
+
+  /**
+   * Test Scenario:
+   * Shadow sell rests behind a historical GTT sell, which expires by record time stamps before a buy trades the level.
+   *
+   * Test Objectives:
+   * 1. Historical order expires before the first record at or after its expire time, with an ORDER_EXPIRED response
+   * 2. Expiry of the order ahead reduces volume ahead of the shadow order as a cancel does
+   * 3. Buy does not trade with the expired order, shadow order fills on volume trading beyond it
+   */
+
+  TestTemporaryDirectory replay_directory;
+  const auto order_flow_path = (std::filesystem::path(replay_directory.path()) / "flow.bin").string();
+
+  {
+    OrderFlowFileWriter writer{order_flow_path};
+    auto gtt_record = historicalRecord(1, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_CLIENT_1_ID, 1, OrderSide::SELL,
+                                       DEFAULT_TEST_ORDER_PRICE, 100);
+    gtt_record.time_in_force_ = static_cast<std::uint8_t>(TimeInForce::GTT);
+    gtt_record.expire_time_ = 3;
+    writer.append(gtt_record);
+    writer.append(historicalRecord(2, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_CLIENT_2_ID, 2, OrderSide::SELL,
+                                   DEFAULT_TEST_ORDER_PRICE, 50));
+    writer.append(historicalRecord(4, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_CLIENT_3_ID, 3, OrderSide::BUY,
+                                   DEFAULT_TEST_ORDER_PRICE, 60));
+    writer.close();
+  }
+
+  auto observer = std::make_shared<EngineEventTestObserver>();
+  std::vector<ShadowFill> fills;
+  ShadowOrderSimulator<> simulator{[&](const ShadowOrder &order, const PriceType &price, const SizeType &size) {
+    fills.emplace_back(order.order_id_, price, size);
+  }, observer};
+
+  OrderFlowFileReader reader{order_flow_path};
+  std::vector<SizeType> volume_ahead;
+  simulator.replay(reader, DEFAULT_TEST_INSTRUMENT_1_ID, [&](const OrderFlowRecord &record) {
+    if (record.cln_order_id_ == 1) {
+      simulator.placeShadowOrder(1001, OrderSide::SELL, DEFAULT_TEST_ORDER_PRICE, 50);
+    } else if (record.cln_order_id_ == 2) {
+      volume_ahead.emplace_back(simulator.getShadowOrder(1001)->volume_ahead_);
+    }
+  });
+
+  const std::vector<SizeType> expected_volume_ahead{100};
+  BOOST_CHECK(volume_ahead == expected_volume_ahead);
+
+  const auto expired = std::find_if(observer->client_order_responses_.begin(),
+                                    observer->client_order_responses_.end(), [](const auto &response) {
+    return response.validation_response_ == ValidationResponse::ORDER_EXPIRED;
+  });
+  BOOST_REQUIRE(expired != observer->client_order_responses_.end());
+  BOOST_CHECK(*expired == EngineOrderResponseTestRecord(
+      DEFAULT_TEST_CLIENT_1_ID, 1, DEFAULT_TEST_INSTRUMENT_1_ID, DEFAULT_TEST_ORDER_PRICE, 100,
+      OrderRequestResult::CANCELLED, ValidationResponse::ORDER_EXPIRED));
+
+  BOOST_REQUIRE_EQUAL(observer->client_trade_events_.size(), 1);
+  checkTradeEvent(observer->client_trade_events_.front(), DEFAULT_TEST_CLIENT_3_ID, DEFAULT_TEST_CLIENT_2_ID,
+                  DEFAULT_TEST_ORDER_PRICE, 50);
+
+  const std::vector<ShadowFill> expected{{1001, DEFAULT_TEST_ORDER_PRICE, 50}};
+  BOOST_CHECK(fills == expected);
+  BOOST_CHECK(simulator.getShadowOrder(1001) == nullptr);
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "simulation/timing_wheel.hpp"
+
+using namespace codetest::matching_engine_sim;
+
+BOOST_AUTO_TEST_SUITE(TimingWheelTestSuite)
+
+namespace codetest::matching_engine_sim_test {
+
+BOOST_AUTO_TEST_CASE(TimingWheel_FiresInTimeThenScheduleOrder) {
+
+  /**
+   * Test Scenario:
+   * Random entries over a wide range of times, many sharing a time, are fired by advancing in random steps.
+   *
+   * Test Objectives:
+   * 1. Every entry fires exactly once, never before its time and never after the time advanced to
+   * 2. Entries fire in time order, ties in the order they were scheduled, across cascades of every level
+   */
+
+  constexpr std::size_t NUMBER_OF_ENTRIES = 20000;
+
+  std::mt19937_64 random_engine{42};
+  TimingWheel<std::size_t> timing_wheel{1000};
+
+  std::vector<std::pair<std::uint64_t, std::size_t>> expected;
+  for (std::size_t index = 0; index < NUMBER_OF_ENTRIES; index++) {
+    // Mix of near, far and very far times, coarse so that ties are common
+    const auto magnitude = std::uniform_int_distribution<unsigned>{0, 40}(random_engine);
+    const auto time = 1000 + ((random_engine() >> (63 - magnitude)) & ~std::uint64_t{3});
+    timing_wheel.schedule(time, index);
+    expected.emplace_back(time, index);
+  }
+  std::stable_sort(expected.begin(), expected.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.first < rhs.first;
+  });
+  BOOST_CHECK_EQUAL(timing_wheel.size(), NUMBER_OF_ENTRIES);
+
+  std::vector<std::pair<std::uint64_t, std::size_t>> fired;
+  std::uint64_t now{1000};
+  while (!timing_wheel.empty()) {
+    now += std::uniform_int_distribution<std::uint64_t>{0, std::uint64_t{1} << 36}(random_engine);
+    timing_wheel.advance(now, [&](const std::uint64_t &time, const std::size_t &index) {
+      BOOST_REQUIRE(time <= now);
+      fired.emplace_back(time, index);
+    });
+  }
+
+  BOOST_CHECK(fired == expected);
+}
+
+BOOST_AUTO_TEST_CASE(TimingWheel_ScheduleWhileFiring) {
+  TimingWheel<int> timing_wheel{};
+
+  timing_wheel.schedule(10, 1);
+  timing_wheel.schedule(300, 4);
+
+  std::vector<std::pair<std::uint64_t, int>> fired;
+  timing_wheel.advance(1000, [&](const std::uint64_t &time, const int &value) {
+    fired.emplace_back(time, value);
+    if (value == 1) {
+      // Same time fires within this very advance, after what is already due at that time
+      timing_wheel.schedule(time, 2);
+      timing_wheel.schedule(time + 100, 3);
+    }
+    if (value == 4) {
+      // Past is due right away
+      timing_wheel.schedule(0, 5);
+      timing_wheel.schedule(5000, 6);
+    }
+  });
+
+  const std::vector<std::pair<std::uint64_t, int>> expected{{10, 1}, {10, 2}, {110, 3}, {300, 4}, {300, 5}};
+  BOOST_CHECK(fired == expected);
+  BOOST_CHECK_EQUAL(timing_wheel.size(), 1);
+
+  // Nothing due yet, wheel time does not move past the remaining entry
+  timing_wheel.advance(4999, [&](const std::uint64_t &, const int &) { BOOST_FAIL("Nothing due"); });
+  BOOST_CHECK(timing_wheel.getCurrentTime() <= 5000);
+
+  timing_wheel.advance(5000, [&](const std::uint64_t &time, const int &value) { fired.emplace_back(time, value); });
+  BOOST_CHECK(timing_wheel.empty());
+  BOOST_CHECK(fired.back() == std::make_pair(std::uint64_t{5000}, 6));
+}
+
+} // end of namespace
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <set>
+#include <string>
+
+#include "engine/matching_engine.h"
+#include "engine/null_engine_event_observer.h"
+#include "loadgen/load_generator.h"
+#include "loadgen/order_flow_generator.h"
+
+using namespace codetest::matching_engine_sim;
+
+namespace {
+
+int printUsage(const char *program) {
+  std::fprintf(stderr,
+               "usage: %s [options]\n"
+               "  --threads <n>             engine processor threads (default 1)\n"
+               "  --producers <n>           producer threads (default 1)\n"
+               "  --rate <requests/s>       target rate over all producers, 0 unpaced (default 100000)\n"
+               "  --requests <n>            requests per producer (default 100000)\n"
+               "  --instruments <n>         (default 1)\n"
+               "  --zipf <exponent>         instrument popularity skew, 0 uniform (default 0)\n"
+               "  --arrival poisson|hawkes  (default poisson)\n"
+               "  --hawkes-alpha <a>        intensity jump per arrival (default 0)\n"
+               "  --hawkes-beta <b>         intensity decay per second (default 1)\n"
+               "  --cancel-ratio <r>        (default 0.3)\n"
+               "  --market-ratio <r>        (default 0.02)\n"
+               "  --aggressive-ratio <r>    (default 0.1)\n"
+               "  --seed <n>                (default 42)\n"
+               "  --output <file>           write the flow of a single producer to an order flow file instead\n",
+               program);
+  return 1;
+}
+
+} // end of anonymous local namespace
+
+int main(int argc, char *argv[]) {
+  OrderFlowGeneratorConfig flow_config;
+  LoadRunOptions run_options;
+  unsigned long threads = 1;
+  std::string output_path;
+
+  for (int index = 1; index < argc; index++) {
+    if (index + 1 >= argc) return printUsage(argv[0]);
+    const char *option = argv[index];
+    const char *value = argv[++index];
+
+    if (std::strcmp(option, "--threads") == 0) {
+      threads = std::strtoul(value, nullptr, 10);
+    } else if (std::strcmp(option, "--producers") == 0) {
+      run_options.producers_ = std::strtoul(value, nullptr, 10);
+    } else if (std::strcmp(option, "--rate") == 0) {
+      run_options.target_rate_ = std::strtod(value, nullptr);
+    } else if (std::strcmp(option, "--requests") == 0) {
+      run_options.requests_per_producer_ = std::strtoull(value, nullptr, 10);
+    } else if (std::strcmp(option, "--instruments") == 0) {
+      flow_config.instruments_ = std::strtoull(value, nullptr, 10);
+    } else if (std::strcmp(option, "--zipf") == 0) {
+      flow_config.zipf_exponent_ = std::strtod(value, nullptr);
+    } else if (std::strcmp(option, "--arrival") == 0) {
+      if (std::strcmp(value, "poisson") == 0) {
+        flow_config.arrival_process_ = ArrivalProcess::POISSON;
+      } else if (std::strcmp(value, "hawkes") == 0) {
+        flow_config.arrival_process_ = ArrivalProcess::HAWKES;
+      } else {
+        return printUsage(argv[0]);
+      }
+    } else if (std::strcmp(option, "--hawkes-alpha") == 0) {
+      flow_config.hawkes_alpha_ = std::strtod(value, nullptr);
+    } else if (std::strcmp(option, "--hawkes-beta") == 0) {
+      flow_config.hawkes_beta_ = std::strtod(value, nullptr);
+    } else if (std::strcmp(option, "--cancel-ratio") == 0) {
+      flow_config.cancel_ratio_ = std::strtod(value, nullptr);
+    } else if (std::strcmp(option, "--market-ratio") == 0) {
+      flow_config.market_order_ratio_ = std::strtod(value, nullptr);
+    } else if (std::strcmp(option, "--aggressive-ratio") == 0) {
+      flow_config.aggressive_ratio_ = std::strtod(value, nullptr);
+    } else if (std::strcmp(option, "--seed") == 0) {
+      flow_config.seed_ = std::strtoull(value, nullptr, 10);
+    } else if (std::strcmp(option, "--output") == 0) {
+      output_path = value;
+    } else {
+      return printUsage(argv[0]);
+    }
+  }
+
+  try {
+    if (!output_path.empty()) {
+      if (run_options.target_rate_ > 0) flow_config.rate_ = run_options.target_rate_;
+      writeGeneratedOrderFlow(flow_config, run_options.requests_per_producer_, output_path);
+      std::printf("generated %llu order events into %s\n",
+                  static_cast<unsigned long long>(run_options.requests_per_producer_), output_path.c_str());
+      return 0;
+    }
+
+    if (threads == 0 || threads > 255) return printUsage(argv[0]);
+
+    std::set<InstrumentType> instruments;
+    for (InstrumentType inst = 0; inst < flow_config.instruments_; inst++) {
+      instruments.insert(flow_config.first_instrument_ + inst);
+    }
+
+    LoadGenerator load_generator{flow_config, run_options, std::make_shared<NullEngineEventObserver>()};
+    DefaultMatchingEngine<> matching_engine{static_cast<std::uint8_t>(threads), instruments,
+                                            load_generator.getObserver()};
+    const auto report = load_generator.run(matching_engine);
+    matching_engine.terminate();
+
+    std::printf("requests            %llu\n"
+                "new orders          %llu\n"
+                "responded           %llu\n"
+                "send rate (req/s)   %.0f\n"
+                "throughput (req/s)  %.0f\n"
+                "latency mean (ns)   %.0f\n"
+                "latency p50 (ns)    %.0f\n"
+                "latency p90 (ns)    %.0f\n"
+                "latency p99 (ns)    %.0f\n"
+                "latency p99.9 (ns)  %.0f\n"
+                "latency max (ns)    %.0f\n",
+                static_cast<unsigned long long>(report.requests_),
+                static_cast<unsigned long long>(report.new_orders_),
+                static_cast<unsigned long long>(report.responded_new_orders_),
+                report.sendRate(),
+                report.throughput(),
+                report.latency_mean_,
+                report.latency_p50_,
+                report.latency_p90_,
+                report.latency_p99_,
+                report.latency_p999_,
+                report.latency_max_);
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
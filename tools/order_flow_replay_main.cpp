@@ -0,0 +1,51 @@
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+#include "engine/null_engine_event_observer.h"
+#include "replay/order_flow_file.h"
+#include "replay/order_flow_replay.hpp"
+
+using namespace codetest::matching_engine_sim;
+
+namespace {
+
+int printUsage(const char *program) {
+  std::fprintf(stderr,
+               "usage: %s <order flow file>\n"
+               "       %s --import <csv file> <order flow file>\n",
+               program,
+               program);
+  return 1;
+}
+
+} // end of anonymous local namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    if (argc == 4 && std::strcmp(argv[1], "--import") == 0) {
+      const auto record_count = importOrderFlowCsv(argv[2], argv[3]);
+      std::printf("imported %llu order events into %s\n", static_cast<unsigned long long>(record_count), argv[3]);
+      return 0;
+    }
+    if (argc != 2) return printUsage(argv[0]);
+
+    OrderFlowFileReader reader{argv[1]};
+    NullEngineEventObserver observer;
+    OrderFlowReplayDriver<> replay_driver{observer};
+    const auto statistics = replay_driver.replay(reader);
+
+    std::printf("messages        %llu\n"
+                "instruments     %zu\n"
+                "elapsed (ms)    %.3f\n"
+                "messages/second %.0f\n",
+                static_cast<unsigned long long>(statistics.messages_),
+                statistics.instruments_,
+                static_cast<double>(statistics.elapsed_.count()) / 1e6,
+                statistics.messagesPerSecond());
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}